@@ -0,0 +1,54 @@
+#ifndef NAV_BENCHMARK_HPP
+#define NAV_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+
+// Small helpers shared by the nav microbenchmarks.
+namespace Benchmark
+{
+    // Keeps the compiler from optimizing away the computation of value.
+    template <typename T>
+    inline void doNotOptimize( T const& value )
+    {
+        asm volatile( "" : : "r,m"( value ) : "memory" );
+    } // doNotOptimize()
+
+    // Calls func repeatedly for at least minSeconds and returns the
+    // average time per call in nanoseconds.
+    template <typename Function>
+    double nsPerOp( Function func, double minSeconds = 0.25 )
+    {
+        using Clock = std::chrono::steady_clock;
+        long iterations = 1;
+        while( true )
+        {
+            Clock::time_point start = Clock::now();
+            for( long i = 0; i < iterations; ++i )
+            {
+                func();
+            }
+            double elapsed = std::chrono::duration<double>( Clock::now() - start ).count();
+            if( elapsed >= minSeconds )
+            {
+                return elapsed * 1e9 / iterations;
+            }
+            iterations *= 2;
+        }
+    } // nsPerOp()
+
+    // Prints the result of a single benchmark.
+    inline void report( const char* name, double nsPerOp )
+    {
+        printf( "%-48s %12.1f ns/op\n", name, nsPerOp );
+    } // report()
+
+    // Prints the result of a single benchmark that also counted heap
+    // allocations.
+    inline void report( const char* name, double nsPerOp, double allocationsPerOp )
+    {
+        printf( "%-48s %12.1f ns/op %10.2f allocs/op\n", name, nsPerOp, allocationsPerOp );
+    } // report()
+} // namespace Benchmark
+
+#endif // NAV_BENCHMARK_HPP
@@ -0,0 +1,82 @@
+// Compares the per-tick cost of reading the nav configuration through
+// chained rapidjson lookups with reading the parsed NavConfig. The set
+// of values read matches what Rover::drive and Rover::publishJoystick
+// read on every tick.
+
+#include <iostream>
+#include <string>
+#include "rapidjson/document.h"
+#include "navConfig.hpp"
+#include "benchmark.hpp"
+
+namespace
+{
+    const char* kConfigJson = R"({
+        "bearingPid": { "kP": 0.1, "kI": 0.5, "kD": 0.00011, "derivativeFilter": 0.05 },
+        "distancePid": { "kP": 0.2, "kI": 0, "kD": 0, "derivativeFilter": 0.05 },
+        "joystick": { "bearingPower": 0.5, "drivingPower": 1.0, "dampen": -1.0 },
+        "navThresholds": { "turningBearing": 20, "drivingBearing": 50, "waypointDistance": 2.0,
+                           "targetDistance": 1.0, "minTurningEffort": 0.25, "gateCenteredAngleDiff": 20 },
+        "roverMeasurements": { "width": 1.5, "maxSpeed": 2, "maxTurnRate": 15 },
+        "computerVision": { "visionDistance": 3.0, "fieldOfViewAngle": 110, "fieldOfViewSafeAngle": 100 },
+        "lcmChannels": { "navStatusChannel": "/nav_status", "repeaterDropInitChannel": "/rr_drop_init",
+                         "repeaterDropCompleteChannel": "/rr_drop_complete", "joystickChannel": "/autonomous" },
+        "radioRepeaterThresholds": { "signalStrengthCutOff": 30.0, "lowSignalWaitTime": 3 },
+        "controlLoop": { "rate": 50, "navStatusKeepAlive": 1 },
+        "pathFollowing": { "enabled": 0, "lookahead": 6 },
+        "obstacleAvoidance": { "algorithm": 0, "planningResolution": 0.5, "planningSize": 64,
+                               "clearance": 0.25, "lookahead": 4, "switchMargin": 1 },
+        "flightRecorder": { "capacity": 16384, "dumpPath": "/tmp/nav_flight.lcmlog",
+                            "crashPath": "/tmp/nav_crash.lcmlog" },
+        "search": { "order": [0, 1], "numSearches": 2, "bailThresh": 10.0,
+                    "searchWaitStepSize": 90.0, "searchWaitTime": 1.0,
+                    "continuousSpin": 0, "framesPerBearing": 3 },
+        "costmap": { "resolution": 0.25, "size": 128, "decayTime": 20, "hitIncrement": 0.35,
+                     "missDecrement": 0.2, "occupiedThreshold": 0.5, "clearDepth": 5 },
+        "targetTracker": { "enabled": 1, "rangeNoise": 0.3, "bearingNoise": 2, "positionNoise": 0.3,
+                           "processNoise": 0.05, "gate": 9.21, "maxRejections": 3, "coastTime": 3 },
+        "probabilityMap": { "resolution": 0.5, "spread": 5, "detectionProbability": 0.5, "giveUp": 0.01 },
+        "courseOptimizer": { "enabled": 0, "budget": 0.01 }
+    })";
+} // namespace
+
+int main()
+{
+    rapidjson::Document document;
+    document.Parse( kConfigJson );
+    NavConfig config;
+    std::string error;
+    if( document.HasParseError() || !parseNavConfig( document, config, error ) )
+    {
+        std::cerr << "Error: invalid benchmark config: " << error << "\n";
+        return 1;
+    }
+
+    double jsonNs = Benchmark::nsPerOp( [&]()
+    {
+        double sum = document[ "navThresholds" ][ "waypointDistance" ].GetDouble() +
+                     document[ "navThresholds" ][ "drivingBearing" ].GetDouble() +
+                     document[ "joystick" ][ "dampen" ].GetDouble() +
+                     document[ "joystick" ][ "drivingPower" ].GetDouble() +
+                     document[ "joystick" ][ "bearingPower" ].GetDouble();
+        std::string joystickChannel = document[ "lcmChannels" ][ "joystickChannel" ].GetString();
+        Benchmark::doNotOptimize( sum );
+        Benchmark::doNotOptimize( joystickChannel );
+    } );
+
+    double structNs = Benchmark::nsPerOp( [&]()
+    {
+        double sum = config.navThresholds.waypointDistance +
+                     config.navThresholds.drivingBearing +
+                     config.joystick.dampen +
+                     config.joystick.drivingPower +
+                     config.joystick.bearingPower;
+        const std::string& joystickChannel = config.lcmChannels.joystickChannel;
+        Benchmark::doNotOptimize( sum );
+        Benchmark::doNotOptimize( joystickChannel );
+    } );
+
+    Benchmark::report( "tick config reads (rapidjson lookups)", jsonNs );
+    Benchmark::report( "tick config reads (NavConfig)", structNs );
+    return 0;
+}
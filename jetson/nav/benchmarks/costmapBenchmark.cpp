@@ -0,0 +1,66 @@
+// Measures the cost of integrating one obstacle message into the
+// costmap as the rover drives, and of the queries the state machines
+// make against it each tick.
+
+#include <cmath>
+#include <cstdio>
+#include "costmap.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    NavConfig config;
+    Costmap costmap( config.costmap.resolution, config.costmap.size );
+    const double width = config.roverMeasurements.width;
+
+    // Drive north at 2 m/s through a field of obstacles seen every
+    // fourth message, ticking at the control loop rate.
+    const double tick = 1 / config.controlLoop.rate;
+    double now = 0;
+    LocalPoint position = { 0, 0 };
+    long messages = 0;
+    auto update = [&]()
+    {
+        now += tick;
+        position.y += 2 * tick;
+        Obstacle obstacle;
+        obstacle.bearing = 0;
+        obstacle.distance = ( messages++ % 4 == 0 ) ? 3 : -1;
+        costmap.recenter( position );
+        costmap.addObservation( position, 10, obstacle, width, now, config.costmap );
+    };
+    for( int i = 0; i < 1000; ++i )
+    {
+        update();
+    }
+
+    printf( "%d x %d cells of %g m\n", costmap.size(), costmap.size(), costmap.resolution() );
+    Benchmark::report( "recenter and add observation", Benchmark::nsPerOp( update ) );
+
+    const double lengths[] = { 2, 5, 10 };
+    for( double length : lengths )
+    {
+        const LocalPoint straight = { position.x, position.y + length };
+        const LocalPoint diagonal = { position.x + length / sqrt( 2 ), position.y + length / sqrt( 2 ) };
+        char name[ 64 ];
+
+        snprintf( name, sizeof( name ), "corridor clear, %g m straight", length );
+        Benchmark::report( name, Benchmark::nsPerOp( [&]()
+        {
+            Benchmark::doNotOptimize( costmap.isCorridorClear( position, straight, width / 2, now, config.costmap ) );
+        } ) );
+
+        snprintf( name, sizeof( name ), "corridor clear, %g m diagonal", length );
+        Benchmark::report( name, Benchmark::nsPerOp( [&]()
+        {
+            Benchmark::doNotOptimize( costmap.isCorridorClear( position, diagonal, width / 2, now, config.costmap ) );
+        } ) );
+    }
+
+    const LocalPoint point = { position.x + 1, position.y + 2 };
+    Benchmark::report( "is occupied", Benchmark::nsPerOp( [&]()
+    {
+        Benchmark::doNotOptimize( costmap.isOccupied( point, now, config.costmap ) );
+    } ) );
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Measures ordering random courses of 10 to 200 waypoints spread over a
+// square kilometer, and how much shorter the drive gets than the order
+// the courses were sent in. Nearest neighbour alone is a budget of zero.
+
+#include <cstdio>
+#include <random>
+#include "courseOptimizer.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    CourseOptimizer optimizer;
+    mt19937 generator( 1 );
+    uniform_real_distribution<double> coordinate( -500, 500 );
+    const LocalPoint start = { 0, 0 };
+    const int sizes[] = { 10, 25, 50, 100, 200 };
+    const int COURSES = 20;
+    const double BUDGET = 1;
+    for( int size : sizes )
+    {
+        // Sample the courses up front so the benchmark only solves.
+        vector< vector<LocalPoint> > courses( COURSES, vector<LocalPoint>( size ) );
+        vector<int> sent( size );
+        for( int i = 0; i < size; ++i )
+        {
+            sent[ i ] = i;
+        }
+        double sentLength = 0;
+        double nearestLength = 0;
+        double improvedLength = 0;
+        for( vector<LocalPoint>& points : courses )
+        {
+            for( LocalPoint& point : points )
+            {
+                point = { coordinate( generator ), coordinate( generator ) };
+            }
+            const vector<bool> fixed( size, false );
+            sentLength += optimizer.length( start, points, sent );
+            nearestLength += optimizer.length( start, points, optimizer.solve( start, points, fixed, 0 ) );
+            improvedLength += optimizer.length( start, points, optimizer.solve( start, points, fixed, BUDGET ) );
+        }
+        printf( "%d waypoints: %.0f m as sent, %.0f m nearest neighbour (%.1f%%), %.0f m improved (%.1f%%)\n",
+                size, sentLength / COURSES, nearestLength / COURSES, 100 * ( 1 - nearestLength / sentLength ),
+                improvedLength / COURSES, 100 * ( 1 - improvedLength / sentLength ) );
+
+        const vector<bool> fixed( size, false );
+        int course = 0;
+        const double nearestNs = Benchmark::nsPerOp( [&]()
+        {
+            course = ( course + 1 ) % COURSES;
+            Benchmark::doNotOptimize( optimizer.solve( start, courses[ course ], fixed, 0 ).front() );
+        }, 0.2 );
+        const double improvedNs = Benchmark::nsPerOp( [&]()
+        {
+            course = ( course + 1 ) % COURSES;
+            Benchmark::doNotOptimize( optimizer.solve( start, courses[ course ], fixed, BUDGET ).front() );
+        }, 0.2 );
+        Benchmark::report( "  nearest neighbour", nearestNs );
+        Benchmark::report( "  nearest neighbour, 2-opt and Or-opt", improvedNs );
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Measures how long the D* Lite planner takes to plan across synthetic
+// boulder fields, and to repair the plan as the rover moves and finds
+// new boulders, against the time budget of one control loop tick.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "obstacle_avoidance/dStarLite.hpp"
+#include "benchmark.hpp"
+
+namespace
+{
+    // Boulders scattered across the field, in number per square meter.
+    const double BOULDER_DENSITY = 0.03;
+
+    // Adds a boulder of radius centered at center to the planner.
+    void addBoulder( DStarLite& planner, const LocalPoint& center, double radius, double resolution )
+    {
+        for( double dx = -radius; dx <= radius; dx += resolution )
+        {
+            for( double dy = -radius; dy <= radius; dy += resolution )
+            {
+                if( dx * dx + dy * dy <= radius * radius )
+                {
+                    planner.setBlocked( { center.x + dx, center.y + dy }, true );
+                }
+            }
+        }
+    } // addBoulder()
+
+    // Generates boulders over a square of side extent meters centered on
+    // the origin, keeping clear of the start and goal.
+    vector<LocalPoint> boulderField( mt19937& random, double extent, const LocalPoint& start,
+                                     const LocalPoint& goal )
+    {
+        uniform_real_distribution<double> coordinate( -extent / 2, extent / 2 );
+        vector<LocalPoint> boulders;
+        const int count = static_cast<int>( BOULDER_DENSITY * extent * extent );
+        while( static_cast<int>( boulders.size() ) < count )
+        {
+            const LocalPoint boulder = { coordinate( random ), coordinate( random ) };
+            if( planarDistance( boulder, start ) > 3 && planarDistance( boulder, goal ) > 3 )
+            {
+                boulders.push_back( boulder );
+            }
+        }
+        return boulders;
+    } // boulderField()
+} // namespace
+
+int main()
+{
+    NavConfig config;
+    const double resolution = config.obstacleAvoidance.planningResolution;
+    const int size = config.obstacleAvoidance.planningSize;
+    const double extent = resolution * ( size - 2 );
+    const double tickNs = 1e9 / config.controlLoop.rate;
+    const double boulderRadius = 0.75 + config.roverMeasurements.width / 2 + config.obstacleAvoidance.clearance;
+
+    const LocalPoint start = { 0, -extent / 2 + 2 };
+    const LocalPoint goal = { 0, extent / 2 - 2 };
+    mt19937 random( 7 );
+    const vector<LocalPoint> boulders = boulderField( random, extent, start, goal );
+    DStarLite planner( resolution, size );
+    printf( "%d x %d cells of %g m, %zu boulders\n", size, size, resolution, boulders.size() );
+
+    // Planning from scratch, as when the rover first sees an obstacle.
+    double worst = 0;
+    double ns = Benchmark::nsPerOp( [&]()
+    {
+        planner.initialize( start, goal );
+        for( const LocalPoint& boulder : boulders )
+        {
+            addBoulder( planner, boulder, boulderRadius, resolution );
+        }
+        Benchmark::doNotOptimize( planner.plan() );
+    } );
+    Benchmark::report( "initial plan", ns );
+    worst = max( worst, ns );
+    printf( "  %d expansions\n", planner.expansions() );
+
+    // Repairing the plan as the rover drives a step along it each tick
+    // and a boulder ahead of it is found every tenth tick.
+    vector<LocalPoint> path;
+    path.reserve( size * size );
+    uniform_real_distribution<double> across( -2, 2 );
+    long ticks = 0;
+    long totalExpansions = 0;
+    auto drive = [&]()
+    {
+        planner.path( path );
+        if( path.size() < 4 )
+        {
+            planner.initialize( start, goal );
+            for( const LocalPoint& boulder : boulders )
+            {
+                addBoulder( planner, boulder, boulderRadius, resolution );
+            }
+            planner.plan();
+            planner.path( path );
+        }
+        const LocalPoint next = path[ 1 ];
+        planner.updateStart( next );
+        if( ++ticks % 10 == 0 && path.size() > 8 )
+        {
+            const LocalPoint boulder = { path[ 6 ].x + across( random ), path[ 6 ].y };
+            if( planarDistance( boulder, next ) > boulderRadius + resolution &&
+                planarDistance( boulder, planner.goal() ) > boulderRadius + resolution )
+            {
+                addBoulder( planner, boulder, boulderRadius, resolution );
+            }
+        }
+        Benchmark::doNotOptimize( planner.plan() );
+        totalExpansions += planner.expansions();
+    };
+    planner.initialize( start, goal );
+    for( const LocalPoint& boulder : boulders )
+    {
+        addBoulder( planner, boulder, boulderRadius, resolution );
+    }
+    planner.plan();
+    ns = Benchmark::nsPerOp( drive );
+    Benchmark::report( "move start and repair", ns );
+    worst = max( worst, ns );
+    printf( "  %.1f expansions per repair\n", static_cast<double>( totalExpansions ) / ticks );
+
+    // Refreshing the blocked cells from a costmap full of obstacles, which
+    // the avoidance state machine does every tick.
+    Costmap costmap( config.costmap.resolution, config.costmap.size );
+    costmap.recenter( start );
+    for( const LocalPoint& boulder : boulders )
+    {
+        costmap.markOccupied( boulder, 0, config.costmap );
+    }
+    planner.initialize( start, goal );
+    ns = Benchmark::nsPerOp( [&]()
+    {
+        Benchmark::doNotOptimize( planner.updateObstacles( costmap, boulderRadius, 0, config.costmap ) );
+        Benchmark::doNotOptimize( planner.plan() );
+    } );
+    Benchmark::report( "update obstacles from costmap and repair", ns );
+    worst = max( worst, ns );
+
+    printf( "worst case uses %.1f%% of a %g ms control loop tick\n", 100 * worst / tickNs, tickNs / 1e6 );
+    return worst < tickNs ? 0 : 1;
+}
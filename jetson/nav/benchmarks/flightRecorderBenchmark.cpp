@@ -0,0 +1,52 @@
+// Measures the cost the flight recorder adds to each iteration of the
+// state machine against the stderr logging it replaces, and the time to
+// dump a full buffer.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include "flightRecorder.hpp"
+#include "navConfig.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    NavConfig config;
+    FlightRecorder recorder( config.flightRecorder.capacity, "/nav_status", "/autonomous" );
+    FlightRecord record = {};
+
+    // The state machine flushed stderr every iteration and printed when
+    // off course. Write to /dev/null so only the formatting and system
+    // call are measured.
+    ofstream devNull( "/dev/null" );
+    Benchmark::report( "print and flush", Benchmark::nsPerOp( [&]()
+    {
+        devNull << "offcourse\n" << flush;
+    } ) );
+    Benchmark::report( "flush", Benchmark::nsPerOp( [&]()
+    {
+        devNull << flush;
+    } ) );
+    Benchmark::report( "record", Benchmark::nsPerOp( [&]()
+    {
+        record.time += 0.02;
+        recorder.record( record );
+    } ) );
+
+    char path[] = "/tmp/flightRecorderBenchmarkXXXXXX";
+    const int fd = mkstemp( path );
+    if( fd < 0 )
+    {
+        return 1;
+    }
+    close( fd );
+    using Clock = chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const bool dumped = recorder.dump( path );
+    const double elapsed = chrono::duration<double>( Clock::now() - start ).count();
+    unlink( path );
+    printf( "dump of %d records %s in %.1f ms\n", recorder.capacity(),
+            dumped ? "written" : "failed", elapsed * 1e3 );
+    return dumped ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+// Compares the per-tick distance and bearing queries done with the
+// degree-and-minute functions against the same queries on the local
+// plane, and measures converting a whole path.
+
+#include <vector>
+#include "localProjection.hpp"
+#include "utilities.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    Odometry origin = Odometry();
+    origin.latitude_deg = 38;
+    origin.latitude_min = 24.36;
+    origin.longitude_deg = -110;
+    origin.longitude_min = -47.52;
+    const LocalProjection projection( origin );
+
+    vector<Odometry> path;
+    for( int i = 0; i < 256; ++i )
+    {
+        path.push_back( addMinToDegrees( origin, 0.001 * ( i % 17 ), -0.001 * ( i % 23 ) ) );
+    }
+    vector<LocalPoint> localPath( path.size() );
+    projection.toLocal( path.begin(), path.end(), localPath.begin() );
+
+    size_t index = 0;
+    const Odometry rover = addMinToDegrees( origin, 0.0004, 0.0007 );
+    const LocalPoint localRover = projection.toLocal( rover );
+
+    double oldNs = Benchmark::nsPerOp( [&]()
+    {
+        const Odometry& dest = path[ index++ & 255 ];
+        double distance = estimateNoneuclid( rover, dest );
+        double bearing = calcBearing( rover, dest );
+        Benchmark::doNotOptimize( distance );
+        Benchmark::doNotOptimize( bearing );
+    } );
+
+    double convertNs = Benchmark::nsPerOp( [&]()
+    {
+        const LocalPoint dest = projection.toLocal( path[ index++ & 255 ] );
+        double distance = planarDistance( localRover, dest );
+        double bearing = planarBearing( localRover, dest );
+        Benchmark::doNotOptimize( distance );
+        Benchmark::doNotOptimize( bearing );
+    } );
+
+    double planarNs = Benchmark::nsPerOp( [&]()
+    {
+        const LocalPoint& dest = localPath[ index++ & 255 ];
+        double distance = planarDistance( localRover, dest );
+        double bearing = planarBearing( localRover, dest );
+        Benchmark::doNotOptimize( distance );
+        Benchmark::doNotOptimize( bearing );
+    } );
+
+    double batchNs = Benchmark::nsPerOp( [&]()
+    {
+        projection.toLocal( path.begin(), path.end(), localPath.begin() );
+        Benchmark::doNotOptimize( localPath.front() );
+    } );
+
+    Benchmark::report( "estimateNoneuclid + calcBearing", oldNs );
+    Benchmark::report( "toLocal + planarDistance + planarBearing", convertNs );
+    Benchmark::report( "planarDistance + planarBearing", planarNs );
+    Benchmark::report( "toLocal of a 256 point path", batchNs );
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Measures how late control ticks start while /target_list arrives in
+// bursts, with the messages handled on the control thread between ticks
+// as nav used to, and on a receive thread of their own as it does now.
+// Runs over the in-process lcm provider so the bursts do not leave the
+// machine. The optional argument is the number of messages per burst.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <lcm/lcm-cpp.hpp>
+#include "clock.hpp"
+#include "controlLoop.hpp"
+#include "lcmHandlers.hpp"
+#include "lcmReceiver.hpp"
+#include "stateMachine.hpp"
+
+namespace
+{
+    // Seconds each configuration runs for.
+    const double DURATION = 5;
+
+    // Seconds between bursts.
+    const double BURST_PERIOD = 0.1;
+
+    // Publishes bursts of burstSize target lists on lcmObject until
+    // running is cleared.
+    void publishBursts( lcm::LCM& lcmObject, int burstSize, const atomic<bool>& running )
+    {
+        TargetList targetList = {};
+        vector<uint8_t> buffer( targetList.getEncodedSize() );
+        targetList.encode( buffer.data(), 0, buffer.size() );
+        while( running )
+        {
+            for( int i = 0; i < burstSize; ++i )
+            {
+                lcmObject.publish( "/target_list", buffer.data(), buffer.size() );
+            }
+            this_thread::sleep_for( chrono::duration<double>( BURST_PERIOD ) );
+        }
+    } // publishBursts()
+
+    // Runs controlLoop for DURATION while bursts are published on
+    // lcmObject, calling tick every tick, and prints its timing.
+    void measure( const char* name, lcm::LCM& lcmObject, ControlLoop& controlLoop, double rate,
+                  int burstSize, function<void()> tick )
+    {
+        atomic<bool> running( true );
+        thread publisher( publishBursts, ref( lcmObject ), burstSize, cref( running ) );
+        const long ticks = static_cast<long>( DURATION * rate );
+        long tickCount = 0;
+        controlLoop.run( [&]()
+        {
+            tick();
+            if( ++tickCount >= ticks )
+            {
+                controlLoop.stop( 0 );
+            }
+        } );
+        running = false;
+        publisher.join();
+
+        const TickStats& stats = controlLoop.stats();
+        printf( "%s: jitter mean %.3f ms max %.3f ms, longest tick %.3f ms, %ld overruns\n", name,
+                stats.ticks ? 1e3 * stats.totalJitter / stats.ticks : 0, 1e3 * stats.maxJitter,
+                1e3 * stats.maxTickDuration, stats.overruns );
+        printJitterHistogram( cout, stats );
+    } // measure()
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const int burstSize = argc > 1 ? atoi( argv[ 1 ] ) : 20000;
+    NavConfig config;
+    SystemClock clock;
+    const double rate = config.controlLoop.rate;
+    printf( "%d /target_list messages every %g s, ticking at %g Hz\n", burstSize, BURST_PERIOD, rate );
+
+    {
+        lcm::LCM lcmObject( "memq://" );
+        StateMachine stateMachine( lcmObject, config, clock );
+        LcmHandlers lcmHandlers( &stateMachine );
+        lcmHandlers.subscribe( lcmObject );
+        ControlLoop controlLoop( lcmObject, rate );
+        measure( "handled between ticks", lcmObject, controlLoop, rate, burstSize, [&]()
+        {
+            stateMachine.run();
+        } );
+    }
+
+    {
+        lcm::LCM lcmObject( "memq://" );
+        StateMachine stateMachine( lcmObject, config, clock );
+        LcmReceiver lcmReceiver( lcmObject );
+        lcmReceiver.start();
+        ControlLoop controlLoop( rate );
+        measure( "handled on a receive thread", lcmObject, controlLoop, rate, burstSize, [&]()
+        {
+            lcmReceiver.deliver( stateMachine );
+            stateMachine.run();
+        } );
+    }
+    return 0;
+}
@@ -0,0 +1,271 @@
+// Measures the geodesy helpers, generating each search pattern and the
+// gate search, and whole ticks of the nav state machine, in nanoseconds
+// and heap allocations per call. With --json the results are also
+// written to a file so runs can be compared for regressions.
+//
+// Usage: nav_benchmark [--json results.json]
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lcm/lcm-cpp.hpp>
+#include "stateMachine.hpp"
+#include "utilities.hpp"
+#include "gate_search/diamondGateSearch.hpp"
+#include "search/searchStateMachine.hpp"
+#include "benchmark.hpp"
+#include "tests/allocationCounter.hpp"
+
+namespace
+{
+    // Calls made while counting allocations.
+    const int ALLOCATION_CALLS = 1000;
+
+    // Seconds each benchmark runs for.
+    const double MIN_SECONDS = 0.2;
+
+    // The cost of one benchmark.
+    struct Result
+    {
+        string name;
+        double nsPerOp;
+        double allocationsPerOp;
+    };
+
+    // Records the state name published on /nav_status.
+    struct NavStatusListener
+    {
+        void navStatus( const lcm::ReceiveBuffer* receiveBuffer,
+                        const string& channel,
+                        const NavStatus* navStatus )
+        {
+            stateName = navStatus->nav_state_name;
+        }
+
+        string stateName;
+    };
+
+    // Measures func, reports it and adds it to results. Allocations are
+    // counted over a fixed number of calls before the timed calls, on
+    // this thread only.
+    template <typename Function>
+    void measure( vector<Result>& results, const string& name, Function func )
+    {
+        const long before = AllocationCounter::threadAllocations();
+        for( int i = 0; i < ALLOCATION_CALLS; ++i )
+        {
+            func();
+        }
+        const double allocationsPerOp = double( AllocationCounter::threadAllocations() - before ) / ALLOCATION_CALLS;
+        const double nsPerOp = Benchmark::nsPerOp( func, MIN_SECONDS );
+        Benchmark::report( name.c_str(), nsPerOp, allocationsPerOp );
+        results.push_back( { name, nsPerOp, allocationsPerOp } );
+    } // measure()
+
+    // Writes results to path as JSON. Returns false if the file cannot
+    // be written.
+    bool writeJson( const string& path, const vector<Result>& results )
+    {
+        FILE* file = fopen( path.c_str(), "w" );
+        if( !file )
+        {
+            return false;
+        }
+        fprintf( file, "{\n    \"benchmarks\": [\n" );
+        for( size_t i = 0; i < results.size(); ++i )
+        {
+            fprintf( file, "        { \"name\": \"%s\", \"ns_per_op\": %.1f, \"allocations_per_op\": %.3f }%s\n",
+                     results[ i ].name.c_str(), results[ i ].nsPerOp, results[ i ].allocationsPerOp,
+                     i + 1 < results.size() ? "," : "" );
+        }
+        fprintf( file, "    ]\n}\n" );
+        return fclose( file ) == 0;
+    } // writeJson()
+
+    // Creates an odometry at the test site.
+    Odometry origin()
+    {
+        Odometry odometry = Odometry();
+        odometry.latitude_deg = 38;
+        odometry.latitude_min = 24.36;
+        odometry.longitude_deg = -110;
+        odometry.longitude_min = -47.52;
+        return odometry;
+    } // origin()
+
+    // Measures the degree-and-minute geodesy helpers on a ring of
+    // destinations around the rover.
+    void geodesy( vector<Result>& results, Rover& rover )
+    {
+        const Odometry start = origin();
+        vector<Odometry> destinations;
+        for( int i = 0; i < 256; ++i )
+        {
+            destinations.push_back( addMinToDegrees( start, 0.001 * ( i % 17 ), -0.001 * ( i % 23 ) ) );
+        }
+        size_t index = 0;
+        measure( results, "estimateNoneuclid", [&]()
+        {
+            Benchmark::doNotOptimize( estimateNoneuclid( start, destinations[ index++ & 255 ] ) );
+        } );
+        measure( results, "calcBearing", [&]()
+        {
+            Benchmark::doNotOptimize( calcBearing( start, destinations[ index++ & 255 ] ) );
+        } );
+        measure( results, "createOdom", [&]()
+        {
+            Benchmark::doNotOptimize( createOdom( start, double( index++ & 255 ), 25, &rover ) );
+        } );
+    } // geodesy()
+
+    // Measures generating each search pattern, including filling in the
+    // points between its corners, and the diamond gate search.
+    void searches( vector<Result>& results, Rover& rover, const NavConfig& config )
+    {
+        const pair<SearchType, const char*> types[] = {
+            { SearchType::SPIRALOUT, "SpiralOut::initializeSearch" },
+            { SearchType::SPIRALIN, "SpiralIn::initializeSearch" },
+            { SearchType::LAWNMOWER, "LawnMower::initializeSearch" },
+            { SearchType::PROBABILITY_MAP, "ProbabilityMapSearch::initializeSearch" }
+        };
+        for( const auto& type : types )
+        {
+            unique_ptr<SearchStateMachine> search( SearchFactory( nullptr, type.first ) );
+            measure( results, type.second, [&]()
+            {
+                search->initializeSearch( &rover, config, config.computerVision.visionDistance );
+            } );
+        }
+
+        DiamondGateSearch gateSearch( nullptr, &rover, config );
+        measure( results, "DiamondGateSearch::initializeSearch", [&]()
+        {
+            gateSearch.initializeSearch();
+        } );
+    } // searches()
+
+    // Measures ticks of a state machine that has been given course and
+    // brought to the state named expected. Each tick hands it new
+    // odometry, jittering in place so the rover never arrives, and runs
+    // it. Returns false if it is in another state before or after.
+    bool ticks( vector<Result>& results, const string& name, const Course& course, const string& expected )
+    {
+        lcm::LCM lcmObject( "memq://" );
+        NavConfig config;
+        VirtualClock clock;
+        StateMachine stateMachine( lcmObject, config, clock );
+        NavStatusListener listener;
+        lcmObject.subscribe( config.lcmChannels.navStatusChannel, &NavStatusListener::navStatus, &listener );
+
+        Odometry odometry = origin();
+        Obstacle obstacle = {};
+        obstacle.distance = -1;
+        TargetList targetList = {};
+        targetList.targetList[ 0 ].distance = -1;
+        targetList.targetList[ 1 ].distance = -1;
+        AutonState autonState;
+        autonState.is_auton = true;
+        stateMachine.updateRoverStatus( course );
+        stateMachine.updateRoverStatus( obstacle );
+        stateMachine.updateRoverStatus( targetList );
+        stateMachine.updateRoverStatus( odometry );
+        stateMachine.updateRoverStatus( autonState );
+
+        const double tickSeconds = 1.0 / config.controlLoop.rate;
+        const double stepMinutes = 0.01 * LAT_METER_IN_MINUTES;
+        long tick = 0;
+        auto step = [&]()
+        {
+            odometry.latitude_min += ( tick++ & 1 ) ? -stepMinutes : stepMinutes;
+            clock.advance( tickSeconds );
+            stateMachine.updateRoverStatus( odometry );
+            stateMachine.updateRoverStatus( obstacle );
+            stateMachine.updateRoverStatus( targetList );
+            stateMachine.run();
+            while( lcmObject.handleTimeout( 0 ) > 0 ) {}
+        };
+        auto inExpectedState = [&]()
+        {
+            if( listener.stateName != expected )
+            {
+                fprintf( stderr, "%s: expected state \"%s\" but the rover is in \"%s\"\n", name.c_str(),
+                         expected.c_str(), listener.stateName.c_str() );
+                return false;
+            }
+            return true;
+        };
+        for( int i = 0; i < 100; ++i )
+        {
+            step();
+        }
+        if( !inExpectedState() )
+        {
+            return false;
+        }
+        measure( results, name, step );
+        return inExpectedState();
+    } // ticks()
+} // namespace
+
+int main( int argc, char** argv )
+{
+    string jsonPath;
+    if( argc == 3 && string( argv[ 1 ] ) == "--json" )
+    {
+        jsonPath = argv[ 2 ];
+    }
+    else if( argc != 1 )
+    {
+        fprintf( stderr, "Usage: %s [--json results.json]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    lcm::LCM lcmObject( "memq://" );
+    NavConfig config;
+    VirtualClock clock;
+    Rover rover( config, lcmObject, clock );
+
+    // Turn the rover on at a search waypoint that is also a gate, with
+    // the first gate post in view.
+    Waypoint waypoint = {};
+    waypoint.odom = origin();
+    waypoint.search = true;
+    waypoint.gate = true;
+    waypoint.gate_width = 3;
+    Rover::RoverStatus status;
+    status.odometry() = origin();
+    status.autonState().is_auton = true;
+    status.course().num_waypoints = 1;
+    status.course().waypoints.push_back( waypoint );
+    status.path().push_back( waypoint );
+    status.target().distance = 5;
+    status.target().bearing = 10;
+    rover.updateRover( status );
+
+    vector<Result> results;
+    geodesy( results, rover );
+    searches( results, rover, config );
+
+    // A waypoint about 185 m due north to drive to, and a search
+    // waypoint right where the rover is.
+    Course driveCourse;
+    driveCourse.num_waypoints = 1;
+    driveCourse.hash = 1;
+    driveCourse.waypoints.push_back( waypoint );
+    driveCourse.waypoints[ 0 ].search = false;
+    driveCourse.waypoints[ 0 ].gate = false;
+    driveCourse.waypoints[ 0 ].odom.latitude_min += 0.1;
+    Course searchCourse = driveCourse;
+    searchCourse.waypoints[ 0 ].odom = origin();
+    searchCourse.waypoints[ 0 ].search = true;
+    bool passed = ticks( results, "StateMachine::run, driving", driveCourse, "Drive" );
+    passed = ticks( results, "StateMachine::run, searching", searchCourse, "Search Spin" ) && passed;
+
+    if( !jsonPath.empty() && !writeJson( jsonPath, results ) )
+    {
+        fprintf( stderr, "Error: cannot write %s\n", jsonPath.c_str() );
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
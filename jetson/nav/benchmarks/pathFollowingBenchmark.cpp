@@ -0,0 +1,72 @@
+// Compares how long simulated missions take when Drive follows the
+// course with pure pursuit against stopping to turn in place whenever
+// the rover is off course. Runs every scenario given on the command
+// line with the same sensor noise seeds in both modes.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "simulator/scenario.hpp"
+#include "simulator/sweep.hpp"
+
+namespace
+{
+    // Number of missions run per scenario and mode.
+    const int MISSIONS = 50;
+
+    // Runs the missions of scenario with config and prints how many
+    // were completed and the mean and 90th percentile mission time.
+    // Returns the mean mission time.
+    double report( const char* name, const NavConfig& config, const Scenario& scenario )
+    {
+        SweepSpec spec;
+        spec.missions = MISSIONS;
+        const vector<MissionResult> missions = runSweep( config, scenario, spec );
+
+        vector<double> times;
+        int completed = 0;
+        int collisions = 0;
+        double total = 0;
+        for( const MissionResult& mission : missions )
+        {
+            completed += mission.result.completed;
+            collisions += mission.result.collisions;
+            total += mission.result.time;
+            times.push_back( mission.result.time );
+        }
+        sort( times.begin(), times.end() );
+        const double mean = total / missions.size();
+        printf( "  %-24s %3d/%d completed  mean %7.1f s  p90 %7.1f s  %d collisions\n",
+                name, completed, MISSIONS, mean, times[ times.size() * 9 / 10 ], collisions );
+        return mean;
+    } // report()
+} // namespace
+
+int main( int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        fprintf( stderr, "Usage: %s <scenario.json>...\n", argv[ 0 ] );
+        return 1;
+    }
+    for( int i = 1; i < argc; ++i )
+    {
+        Scenario scenario;
+        string error;
+        if( !loadScenario( argv[ i ], scenario, error ) )
+        {
+            fprintf( stderr, "Invalid scenario %s: %s\n", argv[ i ], error.c_str() );
+            return 1;
+        }
+
+        NavConfig config;
+        printf( "%s\n", argv[ i ] );
+        config.pathFollowing.enabled = 0;
+        const double stopTurnDrive = report( "stop, turn and drive", config, scenario );
+        config.pathFollowing.enabled = 1;
+        const double purePursuit = report( "pure pursuit", config, scenario );
+        printf( "  pure pursuit takes %.0f%% of the time\n", 100 * purePursuit / stopTurnDrive );
+    }
+    return 0;
+}
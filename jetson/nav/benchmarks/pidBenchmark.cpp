@@ -0,0 +1,190 @@
+// Measures the step response of the bearing pid loop on a model of the
+// rover turning in place, so gains can be tuned offline to converge
+// quickly without overshooting. The loop as it was before it took a
+// measured timestep, with its per-iteration gains, is kept here as the
+// baseline. Also measures the cost of one update.
+
+#include <cmath>
+#include <cstdio>
+#include "navConfig.hpp"
+#include "pid.hpp"
+#include "benchmark.hpp"
+
+namespace
+{
+    // Seconds simulated per step response.
+    const double DURATION = 20;
+
+    // Time constant in seconds of the rover's turn rate following the
+    // joystick command.
+    const double ACTUATOR_LAG = 0.15;
+
+    // Degrees from the setpoint the bearing must stay within to have
+    // settled.
+    const double SETTLED_BAND = 2;
+
+    // Wraps an angle in degrees into [-180, 180).
+    double wrapAngle( double angle )
+    {
+        angle = fmod( angle + 180, 360 );
+        return ( angle < 0 ? angle + 360 : angle ) - 180;
+    } // wrapAngle()
+
+    // The pid loop before it took a measured timestep. Gains are per
+    // iteration, the integral is unbounded and the caller unwraps the
+    // bearing.
+    class LegacyPidLoop
+    {
+    public:
+        LegacyPidLoop( double kP, double kI, double kD )
+            : mKp( kP ), mKi( kI ), mKd( kD ), mFirst( true ), mAccumulated( 0 ), mLast( 0 ) {}
+
+        double update( double current, double desired )
+        {
+            if( fabs( current - desired ) > 180 )
+            {
+                desired += current < 180 ? -360 : 360;
+            }
+            const double error = desired - current;
+            mAccumulated += error;
+            double effort = mKp * error + mKi * mAccumulated;
+            if( !mFirst )
+            {
+                effort += mKd * ( error - mLast );
+            }
+            mLast = error;
+            mFirst = false;
+            return fmin( fmax( effort, -1.0 ), 1.0 );
+        }
+
+    private:
+        double mKp;
+        double mKi;
+        double mKd;
+        bool mFirst;
+        double mAccumulated;
+        double mLast;
+    };
+
+    // The shape of a step response.
+    struct StepResponse
+    {
+        // Seconds to first come within the settled band, and to stay
+        // within it for good. -1 if it never does.
+        double riseTime;
+        double settlingTime;
+        // Largest overshoot past the setpoint in degrees.
+        double overshoot;
+    };
+
+    // Turns the rover model from start to target with update, which maps
+    // the bearing and setpoint to a turning effort.
+    template <typename Update>
+    StepResponse stepResponse( double start, double target, double rate, double maxTurnRate, Update update )
+    {
+        const double dt = 1 / rate;
+        const double direction = wrapAngle( target - start ) < 0 ? -1 : 1;
+        double bearing = start;
+        double turnRate = 0;
+        StepResponse response = { -1, -1, 0 };
+        for( double time = 0; time < DURATION; time += dt )
+        {
+            const double error = wrapAngle( target - bearing );
+            if( fabs( error ) <= SETTLED_BAND )
+            {
+                if( response.riseTime < 0 )
+                {
+                    response.riseTime = time;
+                }
+                if( response.settlingTime < 0 )
+                {
+                    response.settlingTime = time;
+                }
+            }
+            else
+            {
+                response.settlingTime = -1;
+            }
+            response.overshoot = fmax( response.overshoot, -direction * error );
+
+            const double effort = update( fmod( bearing + 360, 360 ), target, dt );
+            turnRate += ( maxTurnRate * effort - turnRate ) * dt / ( ACTUATOR_LAG + dt );
+            bearing = fmod( bearing + turnRate * dt + 360, 360 );
+        }
+        return response;
+    } // stepResponse()
+
+    // Prints a step response.
+    void report( const char* name, const StepResponse& response )
+    {
+        printf( "%-40s rise %6.2f s  settle %6.2f s  overshoot %5.1f deg\n",
+                name, response.riseTime, response.settlingTime, response.overshoot );
+    } // report()
+} // namespace
+
+int main()
+{
+    NavConfig config;
+    const double rate = config.controlLoop.rate;
+    const double maxTurnRate = config.roverMeasurements.maxTurnRate;
+    const PidGains& gains = config.bearingPid;
+
+    // The legacy gains are per iteration of the control loop.
+    const double legacyKi = gains.kI / rate;
+    const double legacyKd = gains.kD * rate;
+
+    const struct
+    {
+        const char* name;
+        double start;
+        double target;
+    } steps[] =
+    {
+        { "90 deg", 0, 90 },
+        { "180 deg", 0, 180 },
+        { "60 deg through north", 330, 30 },
+    };
+    for( const auto& step : steps )
+    {
+        printf( "%s step\n", step.name );
+        LegacyPidLoop legacy( gains.kP, legacyKi, legacyKd );
+        report( "  legacy", stepResponse( step.start, step.target, rate, maxTurnRate,
+            [&]( double current, double desired, double ) { return legacy.update( current, desired ); } ) );
+
+        PidLoop pid( gains.kP, gains.kI, gains.kD );
+        pid.setDerivativeFilter( gains.derivativeFilter );
+        pid.setPeriod( 360 );
+        report( "  anti-windup, filtered derivative", stepResponse( step.start, step.target, rate, maxTurnRate,
+            [&]( double current, double desired, double dt ) { return pid.update( current, desired, dt ); } ) );
+    }
+
+    // Sweep the proportional and derivative gains on the 90 degree step
+    // to show the trade between speed and overshoot.
+    printf( "90 deg step, kI = %g\n", gains.kI );
+    const double kPs[] = { 0.05, 0.1, 0.2, 0.4 };
+    const double kDs[] = { 0, 0.005, 0.02 };
+    for( double kP : kPs )
+    {
+        for( double kD : kDs )
+        {
+            PidLoop pid( kP, gains.kI, kD );
+            pid.setDerivativeFilter( gains.derivativeFilter );
+            pid.setPeriod( 360 );
+            char name[ 64 ];
+            snprintf( name, sizeof( name ), "  kP %-5g kD %-5g", kP, kD );
+            report( name, stepResponse( 0, 90, rate, maxTurnRate,
+                [&]( double current, double desired, double dt ) { return pid.update( current, desired, dt ); } ) );
+        }
+    }
+
+    PidLoop pid( gains.kP, gains.kI, gains.kD );
+    pid.setDerivativeFilter( gains.derivativeFilter );
+    pid.setPeriod( 360 );
+    double bearing = 0;
+    Benchmark::report( "update", Benchmark::nsPerOp( [&]()
+    {
+        bearing = fmod( bearing + 0.7, 360 );
+        Benchmark::doNotOptimize( pid.update( bearing, 90, 0.02 ) );
+    } ) );
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Measures updating the probability map with what the camera sees, which
+// the probability map search does every tick, against the control tick,
+// and starting a search, which resets the map and plans the first
+// viewpoint the same way every later viewpoint is planned.
+
+#include <cstdio>
+#include <memory>
+#include <lcm/lcm-cpp.hpp>
+#include "rover.hpp"
+#include "search/probabilityMapSearch.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    lcm::LCM lcmObject( "memq://" );
+    NavConfig config;
+    SystemClock clock;
+    Rover rover( config, lcmObject, clock );
+
+    // Turn the rover on at the search waypoint.
+    Odometry origin = Odometry();
+    origin.latitude_deg = 38;
+    origin.latitude_min = 24.36;
+    origin.longitude_deg = -110;
+    origin.longitude_min = -47.52;
+    Waypoint waypoint = {};
+    waypoint.odom = origin;
+    waypoint.search = true;
+    Rover::RoverStatus status;
+    status.odometry() = origin;
+    status.autonState().is_auton = true;
+    status.course().num_waypoints = 1;
+    status.course().waypoints.push_back( waypoint );
+    status.path().push_back( waypoint );
+    rover.updateRover( status );
+
+    const double tickNs = 1e9 / config.controlLoop.rate;
+    const double bailThresholds[] = { 10, 20 };
+    for( double bailThresh : bailThresholds )
+    {
+        config.search.bailThresh = bailThresh;
+        printf( "bail %g m, %g m cells, vision %g m\n", bailThresh, config.probabilityMap.resolution,
+                config.computerVision.visionDistance );
+
+        // Sweep the view around the map as a spin would.
+        ProbabilityMap map;
+        map.reset( { 0, 0 }, bailThresh, config.probabilityMap.spread, config.probabilityMap.resolution );
+        double bearing = 0;
+        const double observeNs = Benchmark::nsPerOp( [&]()
+        {
+            bearing = bearing < 359 ? bearing + 1 : 0;
+            map.observe( { 1, 2 }, bearing, config.computerVision.visionDistance,
+                         config.computerVision.fieldOfViewAngle, 0.99 );
+            Benchmark::doNotOptimize( map.remaining() );
+        } );
+        Benchmark::report( "  observe one frame", observeNs );
+        printf( "  %.4f%% of a %g ms tick\n", 100 * observeNs / tickNs, tickNs / 1e6 );
+
+        unique_ptr<SearchStateMachine> search( SearchFactory( nullptr, SearchType::PROBABILITY_MAP ) );
+        const double planNs = Benchmark::nsPerOp( [&]()
+        {
+            search->initializeSearch( &rover, config, config.computerVision.visionDistance );
+        }, 0.2 );
+        Benchmark::report( "  reset the map and plan a viewpoint", planNs );
+    }
+    return 0;
+}
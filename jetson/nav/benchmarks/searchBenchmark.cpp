@@ -0,0 +1,119 @@
+// Measures generating a spiral out search pattern as the bail threshold
+// grows and the vision distance shrinks. The legacy generator, which
+// inserted intermediate points into the middle of a deque, is kept here
+// as the baseline.
+
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <lcm/lcm-cpp.hpp>
+#include "rover.hpp"
+#include "utilities.hpp"
+#include "search/searchStateMachine.hpp"
+#include "benchmark.hpp"
+
+namespace
+{
+    // The spiral out generator as it was before the search points moved
+    // to the local plane.
+    void legacySpiralOut( Rover* phoebe, const NavConfig& roverConfig, const double visionDistance,
+                          deque<Odometry>& searchPoints )
+    {
+        searchPoints.clear();
+        vector< pair<short, short> > multipliers = { { 0, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } };
+        while( multipliers[ 0 ].second * visionDistance < roverConfig.search.bailThresh )
+        {
+            for( auto& multiplier : multipliers )
+            {
+                Odometry nextSearchPoint = phoebe->roverStatus().path().front().odom;
+                double totalLatitudeMinutes = nextSearchPoint.latitude_min +
+                    ( multiplier.first * visionDistance * LAT_METER_IN_MINUTES );
+                double totalLongitudeMinutes = nextSearchPoint.longitude_min +
+                    ( multiplier.second * visionDistance / phoebe->projection().metersPerLonMinute() );
+                nextSearchPoint.latitude_deg += totalLatitudeMinutes / 60;
+                nextSearchPoint.latitude_min = ( totalLatitudeMinutes - ( ( (int) totalLatitudeMinutes ) / 60 ) * 60 );
+                nextSearchPoint.longitude_deg += totalLongitudeMinutes / 60;
+                nextSearchPoint.longitude_min = ( totalLongitudeMinutes - ( ( (int) totalLongitudeMinutes ) / 60 ) * 60 );
+                searchPoints.push_back( nextSearchPoint );
+                multiplier.first < 0 ? --multiplier.first : ++multiplier.first;
+                multiplier.second < 0 ? --multiplier.second : ++multiplier.second;
+            }
+        }
+
+        const double maxDifference = 2 * roverConfig.computerVision.visionDistance;
+        for( int i = 0; i < int( searchPoints.size() ) - 1; ++i )
+        {
+            Odometry point1 = searchPoints.at( i );
+            Odometry point2 = searchPoints.at( i + 1 );
+            double distance = estimateNoneuclid( point1, point2 );
+            if( distance > maxDifference )
+            {
+                int numPoints = int( ceil( distance / maxDifference ) - 1 );
+                double newDifference = distance / ( numPoints + 1 );
+                double bearing = calcBearing( point1, point2 );
+                for( int j = 0; j < numPoints; ++j )
+                {
+                    Odometry newOdom = createOdom( searchPoints.at( i ), bearing, newDifference, phoebe );
+                    searchPoints.insert( searchPoints.begin() + i + 1, newOdom );
+                    ++i;
+                }
+            }
+        }
+    } // legacySpiralOut()
+} // namespace
+
+int main()
+{
+    lcm::LCM lcmObject( "memq://" );
+    NavConfig config;
+    SystemClock clock;
+    Rover rover( config, lcmObject, clock );
+
+    // Turn the rover on at the search waypoint.
+    Odometry origin = Odometry();
+    origin.latitude_deg = 38;
+    origin.latitude_min = 24.36;
+    origin.longitude_deg = -110;
+    origin.longitude_min = -47.52;
+    Waypoint waypoint = {};
+    waypoint.odom = origin;
+    waypoint.search = true;
+    Rover::RoverStatus status;
+    status.odometry() = origin;
+    status.autonState().is_auton = true;
+    status.course().num_waypoints = 1;
+    status.course().waypoints.push_back( waypoint );
+    status.path().push_back( waypoint );
+    rover.updateRover( status );
+
+    unique_ptr<SearchStateMachine> search( SearchFactory( nullptr, SearchType::SPIRALOUT ) );
+    deque<Odometry> legacyPoints;
+
+    const double bailThresholds[] = { 10, 20, 40, 80, 160 };
+    const double visionDistances[] = { 3, 0.75 };
+    for( double bailThresh : bailThresholds )
+    {
+        config.search.bailThresh = bailThresh;
+        for( double visionDistance : visionDistances )
+        {
+            legacySpiralOut( &rover, config, visionDistance, legacyPoints );
+            printf( "bail %g m, vision %g m: %zu points\n", bailThresh, visionDistance, legacyPoints.size() );
+
+            double legacyNs = Benchmark::nsPerOp( [&]()
+            {
+                legacySpiralOut( &rover, config, visionDistance, legacyPoints );
+                Benchmark::doNotOptimize( legacyPoints.back() );
+            }, 0.1 );
+
+            double localNs = Benchmark::nsPerOp( [&]()
+            {
+                search->initializeSearch( &rover, config, visionDistance );
+            }, 0.1 );
+
+            Benchmark::report( "  legacy deque inserts", legacyNs );
+            Benchmark::report( "  single pass on the local plane", localNs );
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Measures the cost of fusing a target message into the target tracker,
+// which the rover does every time perception reports, and of predicting
+// a target, which search does every tick, against the control tick.
+
+#include <cstdio>
+#include "targetTracker.hpp"
+#include "benchmark.hpp"
+
+int main()
+{
+    NavConfig config;
+    TargetTracker tracker;
+
+    // Drive north at 2 m/s towards two posts seen in every message,
+    // with the rest of the tracks filled by tags seen earlier.
+    const double tick = 1 / config.controlLoop.rate;
+    const LocalPoint posts[] = { { -1, 30 }, { 1, 30 } };
+    double now = 0;
+    LocalPoint position = { 0, 0 };
+    for( int id = 10; id < 10 + TargetTracker::MAX_TRACKS - 2; ++id )
+    {
+        Target target;
+        target.distance = 5;
+        target.bearing = 0;
+        target.id = id;
+        tracker.update( position, 0, target, now, config.targetTracker );
+    }
+    long messages = 0;
+    auto update = [&]()
+    {
+        now += tick;
+        position.y = 2 * now - 60 * static_cast<long>( now / 30 );
+        for( int i = 0; i < 2; ++i )
+        {
+            Target target;
+            target.distance = planarDistance( position, posts[ i ] );
+            target.bearing = planarBearing( position, posts[ i ] ) + ( messages % 3 - 1 ) * 0.5;
+            target.id = i;
+            tracker.update( position, 0, target, now, config.targetTracker );
+        }
+        ++messages;
+    };
+
+    const double tickNs = tick * 1e9;
+    const double updateNs = Benchmark::nsPerOp( update );
+    Benchmark::report( "fuse a target list of two tags", updateNs );
+    const double predictNs = Benchmark::nsPerOp( [&]()
+    {
+        Benchmark::doNotOptimize( tracker.predict( position, 0, 1, now, config.targetTracker ) );
+    } );
+    Benchmark::report( "predict a tag", predictNs );
+    printf( "%.4f%% of a %g ms tick\n", 100 * ( updateNs + predictNs ) / tickNs, tick * 1e3 );
+    return 0;
+}
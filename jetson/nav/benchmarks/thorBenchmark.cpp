@@ -0,0 +1,246 @@
+// Compares the Thor primitives with their mutex-based counterparts at 1
+// to N threads: reads of a shared value with a writer updating it, and
+// queues with N producers feeding one consumer. Reports throughput and
+// the tail of the per-operation latency, which includes the ~20 ns it
+// takes to read the clock. The optional argument is N, by default the
+// larger of 4 and the number of cores.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "thor.hpp"
+#include "benchmark.hpp"
+
+using namespace std;
+
+namespace
+{
+    // Seconds each measurement runs for.
+    const double DURATION = 0.5;
+
+    // Number of log2 nanosecond latency buckets.
+    const int BUCKETS = 40;
+
+    using Clock = chrono::steady_clock;
+
+    // A value the size of an odometry message.
+    struct Value
+    {
+        double fields[ 6 ];
+    };
+
+    // Counts operations by latency, in power of two nanosecond buckets.
+    struct LatencyHistogram
+    {
+        long counts[ BUCKETS ] = {};
+
+        // Records one operation that took nanoseconds.
+        void add( long nanoseconds )
+        {
+            int bucket = 0;
+            while( nanoseconds > 1 && bucket < BUCKETS - 1 )
+            {
+                nanoseconds >>= 1;
+                ++bucket;
+            }
+            ++counts[ bucket ];
+        } // add()
+
+        // Adds the counts of other.
+        void merge( const LatencyHistogram& other )
+        {
+            for( int i = 0; i < BUCKETS; ++i )
+            {
+                counts[ i ] += other.counts[ i ];
+            }
+        } // merge()
+
+        // Gets the total number of operations.
+        long total() const
+        {
+            long sum = 0;
+            for( long count : counts )
+            {
+                sum += count;
+            }
+            return sum;
+        } // total()
+
+        // Gets the upper limit in nanoseconds of the bucket holding the
+        // given fraction of operations.
+        long percentile( double fraction ) const
+        {
+            const long target = static_cast<long>( fraction * total() );
+            long sum = 0;
+            for( int i = 0; i < BUCKETS; ++i )
+            {
+                sum += counts[ i ];
+                if( sum > target )
+                {
+                    return 2L << i;
+                }
+            }
+            return 2L << ( BUCKETS - 1 );
+        } // percentile()
+    };
+
+    // Prints the throughput and latency of one measurement.
+    void report( const char* name, int threads, const LatencyHistogram& latency )
+    {
+        printf( "%-28s %2d threads %10.2f Mops/s  p50 %6ld ns  p99 %7ld ns  p99.9 %8ld ns\n", name, threads,
+                latency.total() / DURATION / 1e6, latency.percentile( 0.5 ), latency.percentile( 0.99 ),
+                latency.percentile( 0.999 ) );
+    } // report()
+
+    // Runs operation on threads threads for DURATION and returns the
+    // merged latency of every call. operation is passed the index of
+    // its thread.
+    template <typename Operation>
+    LatencyHistogram timeThreads( int threads, Operation operation )
+    {
+        vector<LatencyHistogram> latencies( threads );
+        vector<thread> workers;
+        const Clock::time_point end = Clock::now() + chrono::duration_cast<Clock::duration>(
+            chrono::duration<double>( DURATION ) );
+        for( int i = 0; i < threads; ++i )
+        {
+            workers.emplace_back( [&, i]()
+            {
+                Clock::time_point now = Clock::now();
+                while( now < end )
+                {
+                    operation( i );
+                    const Clock::time_point done = Clock::now();
+                    latencies[ i ].add( chrono::duration_cast<chrono::nanoseconds>( done - now ).count() );
+                    now = done;
+                }
+            } );
+        }
+        LatencyHistogram latency;
+        for( int i = 0; i < threads; ++i )
+        {
+            workers[ i ].join();
+            latency.merge( latencies[ i ] );
+        }
+        return latency;
+    } // timeThreads()
+
+    // Measures threads readers cloning cell while a writer sets it.
+    template <typename Cell>
+    void measureReads( const char* name, int threads )
+    {
+        Cell cell;
+        atomic<bool> running( true );
+        thread writer( [&]()
+        {
+            Value value = {};
+            while( running )
+            {
+                value.fields[ 0 ] += 1;
+                cell.set( value );
+                this_thread::sleep_for( chrono::microseconds( 100 ) );
+            }
+        } );
+        const LatencyHistogram latency = timeThreads( threads, [&]( int )
+        {
+            Benchmark::doNotOptimize( cell.clone() );
+        } );
+        running = false;
+        writer.join();
+        report( name, threads, latency );
+    } // measureReads()
+
+    // A queue guarded by a mutex, as a baseline.
+    class MutexQueue
+    {
+    public:
+        explicit MutexQueue( size_t capacity ) : mCapacity( capacity ) {}
+
+        bool try_push( const long& value )
+        {
+            lock_guard<mutex> lock( mMutex );
+            if( mValues.size() == mCapacity )
+            {
+                return false;
+            }
+            mValues.push_back( value );
+            return true;
+        }
+
+        bool try_pop( long& value )
+        {
+            lock_guard<mutex> lock( mMutex );
+            if( mValues.empty() )
+            {
+                return false;
+            }
+            value = mValues.front();
+            mValues.pop_front();
+            return true;
+        }
+
+    private:
+        size_t mCapacity;
+        mutex mMutex;
+        deque<long> mValues;
+    };
+
+    // Measures threads producers pushing into queue while one consumer
+    // drains it. A push that finds the queue full yields and retries.
+    template <typename Queue>
+    void measureQueue( const char* name, int threads )
+    {
+        Queue queue( 4096 );
+        atomic<bool> running( true );
+        thread consumer( [&]()
+        {
+            long value;
+            while( running )
+            {
+                if( !queue.try_pop( value ) )
+                {
+                    this_thread::yield();
+                }
+            }
+        } );
+        const LatencyHistogram latency = timeThreads( threads, [&]( int i )
+        {
+            while( !queue.try_push( i ) )
+            {
+                this_thread::yield();
+            }
+        } );
+        running = false;
+        consumer.join();
+        report( name, threads, latency );
+    } // measureQueue()
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const int maxThreads = argc > 1 ? atoi( argv[ 1 ] ) :
+        max( 4, static_cast<int>( thread::hardware_concurrency() ) );
+
+    printf( "Reads of a %zu byte value set every 100 us\n", sizeof( Value ) );
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+        measureReads<Thor::Volatile<Value>>( "  Volatile (mutex)", threads );
+        measureReads<Thor::LockFreeVolatile<Value>>( "  LockFreeVolatile", threads );
+    }
+
+    printf( "Pushes into a queue of 4096 drained by one consumer\n" );
+    measureQueue<MutexQueue>( "  mutex deque", 1 );
+    measureQueue<Thor::SpscQueue<long>>( "  SpscQueue", 1 );
+    for( int threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+        measureQueue<MutexQueue>( "  mutex deque", threads );
+        measureQueue<Thor::MpscQueue<long>>( "  MpscQueue", threads );
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "clock.hpp"
+
+#include <time.h>
+
+// Gets the current time of CLOCK_MONOTONIC in seconds.
+double SystemClock::now() const
+{
+    timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec + now.tv_nsec * 1e-9;
+} // now()
+
+// Constructs a VirtualClock that reads start until it is advanced.
+VirtualClock::VirtualClock( double start )
+    : mNow( start )
+{
+} // VirtualClock()
+
+// Gets the current virtual time in seconds.
+double VirtualClock::now() const
+{
+    return mNow;
+} // now()
+
+// Moves the virtual time forward by seconds.
+void VirtualClock::advance( double seconds )
+{
+    mNow += seconds;
+} // advance()
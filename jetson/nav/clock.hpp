@@ -0,0 +1,40 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+// This class is the source of time for the nav state machines. The
+// rover reads the time through this interface rather than from the
+// system so that a simulation can run faster than real time and be
+// reproduced exactly.
+class Clock
+{
+public:
+    virtual ~Clock() {}
+
+    // Gets the current time in seconds. Only differences between
+    // times are meaningful.
+    virtual double now() const = 0;
+};
+
+// This class reads the system's monotonic clock.
+class SystemClock : public Clock
+{
+public:
+    double now() const override;
+};
+
+// This class is a clock that only moves when it is advanced.
+class VirtualClock : public Clock
+{
+public:
+    VirtualClock( double start = 0 );
+
+    double now() const override;
+
+    void advance( double seconds );
+
+private:
+    // The current time in seconds.
+    double mNow;
+};
+
+#endif // CLOCK_HPP
@@ -0,0 +1,221 @@
+#include "controlLoop.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+namespace
+{
+    // Seconds between reports of the tick statistics.
+    const double REPORT_PERIOD = 30;
+
+    // Gets the current time of CLOCK_MONOTONIC in seconds.
+    double monotonicNow()
+    {
+        timespec now;
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    } // monotonicNow()
+
+    // Gets the jitter histogram bucket of a tick that started jitter
+    // seconds late.
+    int jitterBucket( double jitter )
+    {
+        int bucket = 0;
+        for( double limit = 1e-6; jitter >= limit && bucket < JITTER_BUCKETS - 1; limit *= 2 )
+        {
+            ++bucket;
+        }
+        return bucket;
+    } // jitterBucket()
+} // namespace
+
+// Constructs a ControlLoop that ticks at rate Hz and handles messages
+// of lcmObject between ticks.
+ControlLoop::ControlLoop( lcm::LCM& lcmObject, double rate )
+    : ControlLoop( rate )
+{
+    mLcmObject = &lcmObject;
+} // ControlLoop( lcm::LCM&, double )
+
+// Constructs a ControlLoop that ticks at rate Hz and handles no lcm
+// messages itself.
+ControlLoop::ControlLoop( double rate )
+    : mLcmObject( nullptr )
+    , mTimerFd( timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC ) )
+    , mPeriod( 0 )
+    , mNextDeadline( 0 )
+    , mLastReport( monotonicNow() )
+    , mStopped( false )
+    , mStatus( 0 )
+{
+    if( mTimerFd < 0 )
+    {
+        cerr << "Error: cannot create control loop timer\n";
+        exit( 1 );
+    }
+    setRate( rate );
+} // ControlLoop( double )
+
+// Destructs the ControlLoop object. Closes the timer.
+ControlLoop::~ControlLoop()
+{
+    close( mTimerFd );
+} // ~ControlLoop()
+
+// Sets the tick rate in Hz and restarts the timer so that the next tick
+// is one period from now.
+void ControlLoop::setRate( double rate )
+{
+    mPeriod = 1.0 / rate;
+    itimerspec spec;
+    spec.it_interval.tv_sec = static_cast<time_t>( mPeriod );
+    spec.it_interval.tv_nsec = static_cast<long>( fmod( mPeriod, 1.0 ) * 1e9 );
+    spec.it_value = spec.it_interval;
+    mNextDeadline = monotonicNow() + mPeriod;
+    timerfd_settime( mTimerFd, 0, &spec, nullptr );
+} // setRate()
+
+// Registers an additional file descriptor to wait on. callback is run
+// whenever fd becomes readable.
+void ControlLoop::addFileDescriptor( int fd, function<void()> callback )
+{
+    if( fd >= 0 )
+    {
+        mFileDescriptors.emplace_back( fd, callback );
+    }
+} // addFileDescriptor()
+
+// Runs tick at the fixed rate until lcm reports an error or stop is
+// called. Returns the error code or the status passed to stop.
+int ControlLoop::run( function<void()> tick )
+{
+    vector<pollfd> pollFds;
+    pollFds.push_back( { mTimerFd, POLLIN, 0 } );
+    if( mLcmObject )
+    {
+        pollFds.push_back( { mLcmObject->getFileno(), POLLIN, 0 } );
+    }
+    const size_t firstFileDescriptor = pollFds.size();
+    for( auto& fileDescriptor : mFileDescriptors )
+    {
+        pollFds.push_back( { fileDescriptor.first, POLLIN, 0 } );
+    }
+
+    while( !mStopped )
+    {
+        if( poll( pollFds.data(), pollFds.size(), -1 ) < 0 )
+        {
+            continue; // interrupted by a signal
+        }
+
+        for( size_t i = 0; i < mFileDescriptors.size(); ++i )
+        {
+            if( pollFds[ firstFileDescriptor + i ].revents & POLLIN )
+            {
+                mFileDescriptors[ i ].second();
+            }
+        }
+
+        if( mLcmObject && ( pollFds[ 1 ].revents & POLLIN ) && !drainLcm() )
+        {
+            return -1;
+        }
+
+        uint64_t expirations = 0;
+        if( !( pollFds[ 0 ].revents & POLLIN ) ||
+            read( mTimerFd, &expirations, sizeof( expirations ) ) != sizeof( expirations ) )
+        {
+            continue;
+        }
+
+        if( mLcmObject && !drainLcm() )
+        {
+            return -1;
+        }
+
+        // Expirations beyond the first are ticks we were too late for.
+        // The tick is late by however long draining lcm took as well.
+        double start = monotonicNow();
+        mNextDeadline += mPeriod * ( expirations - 1 );
+        double jitter = fmax( 0, start - mNextDeadline );
+        mNextDeadline += mPeriod;
+        mStats.overruns += expirations - 1;
+        mStats.totalJitter += jitter;
+        mStats.maxJitter = fmax( mStats.maxJitter, jitter );
+        ++mStats.jitterHistogram[ jitterBucket( jitter ) ];
+
+        tick();
+
+        double end = monotonicNow();
+        ++mStats.ticks;
+        mStats.maxTickDuration = fmax( mStats.maxTickDuration, end - start );
+        if( end - mLastReport >= REPORT_PERIOD )
+        {
+            reportStats( end );
+        }
+    }
+    return mStatus;
+} // run()
+
+// Makes run return status once the current tick or callback returns.
+void ControlLoop::stop( int status )
+{
+    mStopped = true;
+    mStatus = status;
+} // stop()
+
+// Gets the tick statistics since the last report.
+const TickStats& ControlLoop::stats() const
+{
+    return mStats;
+} // stats()
+
+// Handles every lcm message that is already waiting without blocking.
+// Returns false if lcm reported an error.
+bool ControlLoop::drainLcm()
+{
+    int status;
+    while( ( status = mLcmObject->handleTimeout( 0 ) ) > 0 ) {}
+    return status == 0;
+} // drainLcm()
+
+// Prints the tick statistics and starts a new reporting period.
+void ControlLoop::reportStats( double now )
+{
+    cerr << "Control loop: " << mStats.ticks / ( now - mLastReport ) << " Hz, jitter mean "
+         << ( mStats.ticks ? 1e3 * mStats.totalJitter / mStats.ticks : 0 ) << " ms max "
+         << 1e3 * mStats.maxJitter << " ms, longest tick " << 1e3 * mStats.maxTickDuration
+         << " ms, " << mStats.overruns << " overruns\n";
+    printJitterHistogram( cerr, mStats );
+    mStats = TickStats();
+    mLastReport = now;
+} // reportStats()
+
+// Prints the nonempty buckets of the jitter histogram of stats, by the
+// upper limit of each bucket in microseconds.
+void printJitterHistogram( ostream& out, const TickStats& stats )
+{
+    out << "Jitter histogram:";
+    for( int bucket = 0; bucket < JITTER_BUCKETS; ++bucket )
+    {
+        if( !stats.jitterHistogram[ bucket ] )
+        {
+            continue;
+        }
+        if( bucket < JITTER_BUCKETS - 1 )
+        {
+            out << " <" << ( 1L << bucket );
+        }
+        else
+        {
+            out << " >=" << ( 1L << ( bucket - 1 ) );
+        }
+        out << " us: " << stats.jitterHistogram[ bucket ];
+    }
+    out << "\n";
+} // printJitterHistogram()
@@ -0,0 +1,96 @@
+#ifndef CONTROL_LOOP_HPP
+#define CONTROL_LOOP_HPP
+
+#include <functional>
+#include <ostream>
+#include <vector>
+#include <lcm/lcm-cpp.hpp>
+
+using namespace std;
+
+// Number of buckets in the jitter histogram. Bucket 0 counts ticks that
+// started less than 1 us late, bucket i those that started 2^(i-1) to
+// 2^i us late and the last bucket everything later.
+const int JITTER_BUCKETS = 18;
+
+// Timing statistics of the control loop since they were last reset.
+struct TickStats
+{
+    // Number of ticks run.
+    long ticks = 0;
+
+    // Number of ticks that were skipped because the previous tick or
+    // message handling ran past the deadline.
+    long overruns = 0;
+
+    // Sum and maximum of how late ticks started after their deadline,
+    // in seconds.
+    double totalJitter = 0;
+    double maxJitter = 0;
+
+    // Number of ticks by how late they started.
+    long jitterHistogram[ JITTER_BUCKETS ] = {};
+
+    // Longest time spent running a single tick, in seconds.
+    double maxTickDuration = 0;
+};
+
+void printJitterHistogram( ostream& out, const TickStats& stats );
+
+// This class runs a tick function at a fixed rate using a timerfd.
+// Between ticks it waits on the lcm file descriptor, if it has one, and
+// any other registered descriptors, so that incoming messages are
+// handled as they arrive, and all pending messages are drained right
+// before each tick. Without an lcm object, messages are left to be
+// received on another thread.
+class ControlLoop
+{
+public:
+    ControlLoop( lcm::LCM& lcmObject, double rate );
+
+    ControlLoop( double rate );
+
+    ~ControlLoop();
+
+    void setRate( double rate );
+
+    void addFileDescriptor( int fd, function<void()> callback );
+
+    int run( function<void()> tick );
+
+    void stop( int status );
+
+    const TickStats& stats() const;
+
+private:
+    bool drainLcm();
+
+    void reportStats( double now );
+
+    // Lcm object whose messages are handled between ticks, or nullptr.
+    lcm::LCM* mLcmObject;
+
+    // File descriptor of the tick timer.
+    int mTimerFd;
+
+    // Tick period in seconds.
+    double mPeriod;
+
+    // Time the next tick is due, in seconds of CLOCK_MONOTONIC.
+    double mNextDeadline;
+
+    // Additional descriptors to wait on and their callbacks.
+    vector<pair<int, function<void()>>> mFileDescriptors;
+
+    // Statistics since the last report.
+    TickStats mStats;
+
+    // Time of the last statistics report.
+    double mLastReport;
+
+    // Whether stop was called, and the status run returns.
+    bool mStopped;
+    int mStatus;
+};
+
+#endif // CONTROL_LOOP_HPP
@@ -0,0 +1,302 @@
+#include "costmap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "utilities.hpp"
+
+namespace
+{
+    // Distance from point to the segment from start to end.
+    double distanceToSegment( double px, double py, const LocalPoint& start, const LocalPoint& end )
+    {
+        const double dx = end.x - start.x;
+        const double dy = end.y - start.y;
+        const double lengthSquared = dx * dx + dy * dy;
+        double t = 0;
+        if( lengthSquared > 0 )
+        {
+            t = ( ( px - start.x ) * dx + ( py - start.y ) * dy ) / lengthSquared;
+            t = min( 1.0, max( 0.0, t ) );
+        }
+        return hypot( px - ( start.x + t * dx ), py - ( start.y + t * dy ) );
+    } // distanceToSegment()
+} // namespace
+
+// Constructs an empty costmap of size by size cells, each resolution
+// meters on a side. size must be a power of two.
+Costmap::Costmap( double resolution, int size )
+    : mResolution( resolution )
+    , mSize( size )
+    , mMask( size - 1 )
+    , mShift( 0 )
+    , mMinX( -size / 2 )
+    , mMinY( -size / 2 )
+    , mEpoch( 0 )
+    , mHasEpoch( false )
+    , mCells( size * size )
+{
+    while( ( 1 << mShift ) < mSize )
+    {
+        ++mShift;
+    }
+    clear();
+} // Costmap()
+
+// Forgets every observation. Used when the local plane is re-anchored.
+void Costmap::clear()
+{
+    fill( mCells.begin(), mCells.end(), Cell{ 0, 0 } );
+    mHasEpoch = false;
+} // clear()
+
+// Scrolls the window so that it is centred on center. Cells that scroll
+// into view are cleared; cells that stay in view are not touched.
+void Costmap::recenter( const LocalPoint& center )
+{
+    const int minX = cellCoordinate( center.x ) - mSize / 2;
+    const int minY = cellCoordinate( center.y ) - mSize / 2;
+    if( abs( minX - mMinX ) >= mSize || abs( minY - mMinY ) >= mSize )
+    {
+        fill( mCells.begin(), mCells.end(), Cell{ 0, 0 } );
+        mMinX = minX;
+        mMinY = minY;
+        return;
+    }
+
+    // Columns entering the window, across every row.
+    const int firstColumn = minX > mMinX ? mMinX + mSize : minX;
+    const int lastColumn = minX > mMinX ? minX + mSize : mMinX;
+    for( int x = firstColumn; x < lastColumn; ++x )
+    {
+        for( int row = 0; row < mSize; ++row )
+        {
+            mCells[ ( row << mShift ) | ( x & mMask ) ] = Cell{ 0, 0 };
+        }
+    }
+    mMinX = minX;
+
+    // Rows entering the window, which are contiguous.
+    const int firstRow = minY > mMinY ? mMinY + mSize : minY;
+    const int lastRow = minY > mMinY ? minY + mSize : mMinY;
+    for( int y = firstRow; y < lastRow; ++y )
+    {
+        auto row = mCells.begin() + ( ( y & mMask ) << mShift );
+        fill( row, row + mSize, Cell{ 0, 0 } );
+    }
+    mMinY = minY;
+} // recenter()
+
+// Integrates an obstacle message perceived by a rover of the given
+// width at position, facing bearing. The corridor ahead of the rover is
+// seen clear up to the obstacle, or up to the configured clear depth if
+// there is none, and the obstacle is a segment across the rover's path
+// at the reported distance.
+void Costmap::addObservation( const LocalPoint& position, double bearing, const Obstacle& obstacle,
+                              double width, double now, const NavConfig::Costmap& config )
+{
+    const float observed = stamp( now );
+    const double heading = degreeToRadian( bearing );
+    const double forwardX = sin( heading );
+    const double forwardY = cos( heading );
+    const double halfWidth = width / 2;
+
+    const bool detected = obstacle.distance >= 0;
+    const double clearDepth = detected ? obstacle.distance - mResolution : config.clearDepth;
+    if( clearDepth > 0 )
+    {
+        for( double offset = -halfWidth; offset <= halfWidth; offset += mResolution )
+        {
+            const LocalPoint start = { position.x + offset * forwardY, position.y - offset * forwardX };
+            const LocalPoint end = { start.x + clearDepth * forwardX, start.y + clearDepth * forwardY };
+            addToSegment( start, end, float( -config.missDecrement ), observed, config );
+        }
+    }
+    if( detected )
+    {
+        const LocalPoint center = { position.x + obstacle.distance * forwardX,
+                                    position.y + obstacle.distance * forwardY };
+        const LocalPoint left = { center.x - halfWidth * forwardY, center.y + halfWidth * forwardX };
+        const LocalPoint right = { center.x + halfWidth * forwardY, center.y - halfWidth * forwardX };
+        addToSegment( left, right, float( config.hitIncrement ), observed, config );
+    }
+} // addObservation()
+
+// Records a detection of an obstacle at point.
+void Costmap::markOccupied( const LocalPoint& point, double now, const NavConfig::Costmap& config )
+{
+    addToCell( cellCoordinate( point.x ), cellCoordinate( point.y ),
+               float( config.hitIncrement ), stamp( now ), config );
+} // markOccupied()
+
+// Records that point was seen free of obstacles.
+void Costmap::markFree( const LocalPoint& point, double now, const NavConfig::Costmap& config )
+{
+    addToCell( cellCoordinate( point.x ), cellCoordinate( point.y ),
+               float( -config.missDecrement ), stamp( now ), config );
+} // markFree()
+
+// Gets the occupancy in [0, 1] of the cell containing point at time now.
+double Costmap::occupancy( const LocalPoint& point, double now, const NavConfig::Costmap& config ) const
+{
+    const int cellX = cellCoordinate( point.x );
+    const int cellY = cellCoordinate( point.y );
+    if( !mHasEpoch || !isInWindow( cellX, cellY ) )
+    {
+        return 0;
+    }
+    return decayedLevel( cell( cellX, cellY ), float( now - mEpoch ), config );
+} // occupancy()
+
+// Returns true if the cell containing point is occupied at time now.
+bool Costmap::isOccupied( const LocalPoint& point, double now, const NavConfig::Costmap& config ) const
+{
+    return occupancy( point, now, config ) >= config.occupiedThreshold;
+} // isOccupied()
+
+// Returns true if no occupied cell lies within halfWidth of the segment
+// from start to end. Only the cells in the segment's bounding box are
+// visited and the walk stops at the first occupied cell.
+bool Costmap::isCorridorClear( const LocalPoint& start, const LocalPoint& end, double halfWidth,
+                               double now, const NavConfig::Costmap& config ) const
+{
+    if( !mHasEpoch )
+    {
+        return true;
+    }
+    const float queried = float( now - mEpoch );
+    const double reach = halfWidth + mResolution / 2;
+    const int minX = max( mMinX, cellCoordinate( min( start.x, end.x ) - halfWidth ) );
+    const int maxX = min( mMinX + mSize - 1, cellCoordinate( max( start.x, end.x ) + halfWidth ) );
+    const int minY = max( mMinY, cellCoordinate( min( start.y, end.y ) - halfWidth ) );
+    const int maxY = min( mMinY + mSize - 1, cellCoordinate( max( start.y, end.y ) + halfWidth ) );
+    for( int y = minY; y <= maxY; ++y )
+    {
+        const double centerY = ( y + 0.5 ) * mResolution;
+        for( int x = minX; x <= maxX; ++x )
+        {
+            const Cell& current = cell( x, y );
+            if( current.level < config.occupiedThreshold ||
+                decayedLevel( current, queried, config ) < config.occupiedThreshold )
+            {
+                continue;
+            }
+            if( distanceToSegment( ( x + 0.5 ) * mResolution, centerY, start, end ) <= reach )
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+} // isCorridorClear()
+
+// Gets the side of a cell in meters.
+double Costmap::resolution() const
+{
+    return mResolution;
+} // resolution()
+
+// Gets the number of cells per side of the window.
+int Costmap::size() const
+{
+    return mSize;
+} // size()
+
+// Converts a coordinate on the local plane to a global cell coordinate.
+int Costmap::cellCoordinate( double meters ) const
+{
+    return int( floor( meters / mResolution ) );
+} // cellCoordinate()
+
+// Returns true if the cell is inside the current window.
+bool Costmap::isInWindow( int cellX, int cellY ) const
+{
+    return cellX >= mMinX && cellX < mMinX + mSize &&
+           cellY >= mMinY && cellY < mMinY + mSize;
+} // isInWindow()
+
+// Gets the cell at the given global cell coordinates, which must be in
+// the window.
+Costmap::Cell& Costmap::cell( int cellX, int cellY )
+{
+    return mCells[ ( ( cellY & mMask ) << mShift ) | ( cellX & mMask ) ];
+} // cell()
+
+const Costmap::Cell& Costmap::cell( int cellX, int cellY ) const
+{
+    return mCells[ ( ( cellY & mMask ) << mShift ) | ( cellX & mMask ) ];
+} // cell()
+
+// Converts a clock time to a cell stamp, starting the epoch if this is
+// the first observation since the map was cleared.
+float Costmap::stamp( double now )
+{
+    if( !mHasEpoch )
+    {
+        mEpoch = now;
+        mHasEpoch = true;
+    }
+    return float( now - mEpoch );
+} // stamp()
+
+// Gets the occupancy of cell at the time given by stamp.
+float Costmap::decayedLevel( const Cell& cell, float stamp, const NavConfig::Costmap& config ) const
+{
+    const float decayed = cell.level - ( stamp - cell.stamp ) / float( config.decayTime );
+    return max( 0.0f, decayed );
+} // decayedLevel()
+
+// Adds delta to the decayed occupancy of a cell, if it is in the window.
+void Costmap::addToCell( int cellX, int cellY, float delta, float stamp, const NavConfig::Costmap& config )
+{
+    if( !isInWindow( cellX, cellY ) )
+    {
+        return;
+    }
+    Cell& current = cell( cellX, cellY );
+    current.level = min( 1.0f, max( 0.0f, decayedLevel( current, stamp, config ) + delta ) );
+    current.stamp = stamp;
+} // addToCell()
+
+// Adds delta to every cell the segment from start to end passes
+// through, visiting each cell once.
+void Costmap::addToSegment( const LocalPoint& start, const LocalPoint& end, float delta, float stamp,
+                            const NavConfig::Costmap& config )
+{
+    int x = cellCoordinate( start.x );
+    int y = cellCoordinate( start.y );
+    const int endX = cellCoordinate( end.x );
+    const int endY = cellCoordinate( end.y );
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    const double infinity = numeric_limits<double>::infinity();
+
+    const int stepX = dx > 0 ? 1 : -1;
+    const int stepY = dy > 0 ? 1 : -1;
+    const double deltaX = dx != 0 ? mResolution / fabs( dx ) : infinity;
+    const double deltaY = dy != 0 ? mResolution / fabs( dy ) : infinity;
+    double nextX = dx != 0 ? ( dx > 0 ? ( x + 1 ) * mResolution - start.x
+                                      : start.x - x * mResolution ) / fabs( dx )
+                           : infinity;
+    double nextY = dy != 0 ? ( dy > 0 ? ( y + 1 ) * mResolution - start.y
+                                      : start.y - y * mResolution ) / fabs( dy )
+                           : infinity;
+
+    int remaining = abs( endX - x ) + abs( endY - y );
+    addToCell( x, y, delta, stamp, config );
+    while( remaining-- > 0 )
+    {
+        if( nextX < nextY )
+        {
+            nextX += deltaX;
+            x += stepX;
+        }
+        else
+        {
+            nextY += deltaY;
+            y += stepY;
+        }
+        addToCell( x, y, delta, stamp, config );
+    }
+} // addToSegment()
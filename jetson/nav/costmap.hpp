@@ -0,0 +1,108 @@
+#ifndef COSTMAP_HPP
+#define COSTMAP_HPP
+
+#include <vector>
+#include "rover_msgs/Obstacle.hpp"
+#include "localProjection.hpp"
+#include "navConfig.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// This class is a rolling occupancy grid on the local plane, centred on
+// the rover. The grid is a square ring buffer of cells addressed by
+// their global cell coordinates modulo the grid size, so following the
+// rover only clears the rows and columns that scroll into view and
+// never moves the remembered cells. Each cell stores its occupancy and
+// when it was last observed; occupancy decays linearly with time and
+// the decay is applied lazily when a cell is read or written. Cells
+// outside the window are unknown and treated as free.
+class Costmap
+{
+public:
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    Costmap( double resolution, int size );
+
+    void clear();
+
+    void recenter( const LocalPoint& center );
+
+    void addObservation( const LocalPoint& position, double bearing, const Obstacle& obstacle,
+                         double width, double now, const NavConfig::Costmap& config );
+
+    void markOccupied( const LocalPoint& point, double now, const NavConfig::Costmap& config );
+
+    void markFree( const LocalPoint& point, double now, const NavConfig::Costmap& config );
+
+    double occupancy( const LocalPoint& point, double now, const NavConfig::Costmap& config ) const;
+
+    bool isOccupied( const LocalPoint& point, double now, const NavConfig::Costmap& config ) const;
+
+    bool isCorridorClear( const LocalPoint& start, const LocalPoint& end, double halfWidth,
+                          double now, const NavConfig::Costmap& config ) const;
+
+    double resolution() const;
+
+    int size() const;
+
+private:
+    /*************************************************************************/
+    /* Private Types */
+    /*************************************************************************/
+    struct Cell
+    {
+        // Occupancy in [0, 1] when the cell was last observed.
+        float level;
+
+        // Seconds after mEpoch that the cell was last observed.
+        float stamp;
+    };
+
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    int cellCoordinate( double meters ) const;
+
+    bool isInWindow( int cellX, int cellY ) const;
+
+    Cell& cell( int cellX, int cellY );
+
+    const Cell& cell( int cellX, int cellY ) const;
+
+    float stamp( double now );
+
+    float decayedLevel( const Cell& cell, float stamp, const NavConfig::Costmap& config ) const;
+
+    void addToCell( int cellX, int cellY, float delta, float stamp, const NavConfig::Costmap& config );
+
+    void addToSegment( const LocalPoint& start, const LocalPoint& end, float delta, float stamp,
+                       const NavConfig::Costmap& config );
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // Side of a cell in meters.
+    double mResolution;
+
+    // Cells per side of the grid, a power of two, the mask that wraps a
+    // cell coordinate into the grid and log2 of the size.
+    int mSize;
+    int mMask;
+    int mShift;
+
+    // Global cell coordinates of the lower left corner of the window.
+    int mMinX;
+    int mMinY;
+
+    // Clock time the cell stamps count from, so that they fit a float.
+    // Set by the first observation after the map is cleared.
+    double mEpoch;
+    bool mHasEpoch;
+
+    // The cells, row major, indexed by the wrapped cell coordinates.
+    vector<Cell> mCells;
+};
+
+#endif // COSTMAP_HPP
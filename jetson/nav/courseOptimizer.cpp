@@ -0,0 +1,234 @@
+#include "courseOptimizer.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Node standing for the open end of the last leg. It is no distance
+    // from every node, so a leg can end at any of its waypoints.
+    const int NO_END = -1;
+
+    // Meters a move must save to be taken, so rounding cannot make the
+    // local search cycle.
+    const double MIN_SAVING = 1e-9;
+
+    // Longest run of waypoints Or-opt moves.
+    const int MAX_RUN = 3;
+} // namespace
+
+// Constructs an optimizer that has not solved a course.
+CourseOptimizer::CourseOptimizer()
+    : mNodes( 0 )
+{
+} // CourseOptimizer()
+
+// Reorders the course's waypoints to shorten the drive from start
+// through all of them, spending at most budget seconds improving the
+// order. The course's other fields are left as they are.
+void CourseOptimizer::optimize( const Odometry& start, Course& course, double budget )
+{
+    const int count = course.num_waypoints;
+    LocalProjection projection( start );
+    mPoints.resize( count );
+    mFixed.resize( count );
+    for( int i = 0; i < count; ++i )
+    {
+        mPoints[ i ] = projection.toLocal( course.waypoints[ i ].odom );
+        mFixed[ i ] = course.waypoints[ i ].gate;
+    }
+    solve( { 0, 0 }, mPoints, mFixed, budget );
+
+    mWaypoints.assign( course.waypoints.begin(), course.waypoints.begin() + count );
+    for( int i = 0; i < count; ++i )
+    {
+        course.waypoints[ i ] = mWaypoints[ mOrder[ i ] ];
+    }
+} // optimize()
+
+// Finds a short order to visit points in from start, keeping the points
+// that are fixed at their index. Every leg gets its nearest neighbour
+// order, which is then improved until no move helps or budget seconds
+// have passed. Returns the indices of the points in the order to visit
+// them.
+const vector<int>& CourseOptimizer::solve( const LocalPoint& start, const vector<LocalPoint>& points,
+                                           const vector<bool>& fixed, double budget )
+{
+    mDeadline = chrono::steady_clock::now() +
+                chrono::duration_cast<chrono::steady_clock::duration>( chrono::duration<double>( budget ) );
+    const int count = static_cast<int>( points.size() );
+    mNodes = count + 1;
+    mDistances.resize( mNodes * mNodes );
+    for( int from = 0; from < mNodes; ++from )
+    {
+        const LocalPoint& fromPoint = from == 0 ? start : points[ from - 1 ];
+        for( int to = 0; to < mNodes; ++to )
+        {
+            mDistances[ from * mNodes + to ] = planarDistance( fromPoint, to == 0 ? start : points[ to - 1 ] );
+        }
+    }
+
+    mOrder.clear();
+    int legStart = 0;
+    int next = 0;
+    while( true )
+    {
+        mLeg.clear();
+        mLeg.push_back( legStart );
+        for( ; next < count && !fixed[ next ]; ++next )
+        {
+            mLeg.push_back( next + 1 );
+        }
+        const int legEnd = next < count ? next + 1 : NO_END;
+        mLeg.push_back( legEnd );
+
+        nearestNeighbour( mLeg );
+        while( !expired() && ( twoOpt( mLeg ) || orOpt( mLeg ) ) )
+        {
+        }
+        for( size_t i = 1; i + 1 < mLeg.size(); ++i )
+        {
+            mOrder.push_back( mLeg[ i ] - 1 );
+        }
+        if( legEnd == NO_END )
+        {
+            break;
+        }
+        mOrder.push_back( legEnd - 1 );
+        legStart = legEnd;
+        ++next;
+    }
+    return mOrder;
+} // solve()
+
+// Gets the meters driven from start through points in order.
+double CourseOptimizer::length( const LocalPoint& start, const vector<LocalPoint>& points,
+                                const vector<int>& order ) const
+{
+    double total = 0;
+    const LocalPoint* previous = &start;
+    for( int index : order )
+    {
+        total += planarDistance( *previous, points[ index ] );
+        previous = &points[ index ];
+    }
+    return total;
+} // length()
+
+// Gets the meters between two nodes.
+double CourseOptimizer::distance( int from, int to ) const
+{
+    if( from == NO_END || to == NO_END )
+    {
+        return 0;
+    }
+    return mDistances[ from * mNodes + to ];
+} // distance()
+
+// Gets whether the compute budget has run out.
+bool CourseOptimizer::expired() const
+{
+    return chrono::steady_clock::now() >= mDeadline;
+} // expired()
+
+// Orders the waypoints between the fixed ends of the leg by always
+// driving to the nearest waypoint not yet visited.
+void CourseOptimizer::nearestNeighbour( vector<int>& leg ) const
+{
+    for( size_t i = 1; i + 1 < leg.size(); ++i )
+    {
+        size_t nearest = i;
+        for( size_t j = i + 1; j + 1 < leg.size(); ++j )
+        {
+            if( distance( leg[ i - 1 ], leg[ j ] ) < distance( leg[ i - 1 ], leg[ nearest ] ) )
+            {
+                nearest = j;
+            }
+        }
+        swap( leg[ i ], leg[ nearest ] );
+    }
+} // nearestNeighbour()
+
+// Makes one pass over every pair of edges of the leg, reversing the run
+// of waypoints between them wherever that is shorter. Returns whether
+// the leg got shorter.
+bool CourseOptimizer::twoOpt( vector<int>& leg ) const
+{
+    bool improved = false;
+    const int size = static_cast<int>( leg.size() );
+    for( int i = 0; i + 3 < size && !expired(); ++i )
+    {
+        for( int j = i + 2; j + 1 < size; ++j )
+        {
+            const double saving = distance( leg[ i ], leg[ i + 1 ] ) + distance( leg[ j ], leg[ j + 1 ] ) -
+                                  distance( leg[ i ], leg[ j ] ) - distance( leg[ i + 1 ], leg[ j + 1 ] );
+            if( saving > MIN_SAVING )
+            {
+                reverse( leg.begin() + i + 1, leg.begin() + j + 1 );
+                improved = true;
+            }
+        }
+    }
+    return improved;
+} // twoOpt()
+
+// Makes one pass over every run of up to MAX_RUN waypoints of the leg,
+// moving it, either way round, to the edge where that is shortest if
+// that is shorter than where it is. Returns whether the leg got shorter.
+bool CourseOptimizer::orOpt( vector<int>& leg ) const
+{
+    bool improved = false;
+    const int size = static_cast<int>( leg.size() );
+    for( int run = 1; run <= MAX_RUN; ++run )
+    {
+        for( int i = 1; i + run < size && !expired(); ++i )
+        {
+            const int first = leg[ i ];
+            const int last = leg[ i + run - 1 ];
+            const double removed = distance( leg[ i - 1 ], first ) + distance( last, leg[ i + run ] ) -
+                                   distance( leg[ i - 1 ], leg[ i + run ] );
+            int bestEdge = -1;
+            bool bestReversed = false;
+            double bestSaving = MIN_SAVING;
+            for( int j = 0; j + 1 < size; ++j )
+            {
+                if( j >= i - 1 && j < i + run )
+                {
+                    continue;
+                }
+                const double edge = distance( leg[ j ], leg[ j + 1 ] );
+                const double forward = distance( leg[ j ], first ) + distance( last, leg[ j + 1 ] ) - edge;
+                const double backward = distance( leg[ j ], last ) + distance( first, leg[ j + 1 ] ) - edge;
+                const double saving = removed - min( forward, backward );
+                if( saving > bestSaving )
+                {
+                    bestSaving = saving;
+                    bestEdge = j;
+                    bestReversed = backward < forward;
+                }
+            }
+            if( bestEdge < 0 )
+            {
+                continue;
+            }
+
+            // Rotate the run into the edge and find where it landed.
+            int runStart;
+            if( bestEdge < i )
+            {
+                rotate( leg.begin() + bestEdge + 1, leg.begin() + i, leg.begin() + i + run );
+                runStart = bestEdge + 1;
+            }
+            else
+            {
+                rotate( leg.begin() + i, leg.begin() + i + run, leg.begin() + bestEdge + 1 );
+                runStart = bestEdge + 1 - run;
+            }
+            if( bestReversed )
+            {
+                reverse( leg.begin() + runStart, leg.begin() + runStart + run );
+            }
+            improved = true;
+        }
+    }
+    return improved;
+} // orOpt()
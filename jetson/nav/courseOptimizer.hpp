@@ -0,0 +1,78 @@
+#ifndef COURSE_OPTIMIZER_HPP
+#define COURSE_OPTIMIZER_HPP
+
+#include <chrono>
+#include <vector>
+#include "rover_msgs/Course.hpp"
+#include "localProjection.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// This class reorders the waypoints of a course to shorten the drive
+// from the rover's position through all of them. Gate waypoints keep
+// their place in the course and split it into legs. The waypoints of a
+// leg are visited in any order, starting from the previous gate (or the
+// rover) and ending at the next gate, if any. Each leg starts from the
+// nearest neighbour order and is improved by 2-opt (reversing a run of
+// waypoints) and Or-opt (moving a run of up to three waypoints
+// elsewhere) until no move shortens it or the compute budget runs out.
+// Distances between waypoints are computed once into a matrix on the
+// local plane. The buffers are kept between courses, so solving a course
+// no larger than an earlier one does not allocate.
+class CourseOptimizer
+{
+public:
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    CourseOptimizer();
+
+    void optimize( const Odometry& start, Course& course, double budget );
+
+    const vector<int>& solve( const LocalPoint& start, const vector<LocalPoint>& points,
+                              const vector<bool>& fixed, double budget );
+
+    double length( const LocalPoint& start, const vector<LocalPoint>& points, const vector<int>& order ) const;
+
+private:
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    double distance( int from, int to ) const;
+
+    bool expired() const;
+
+    void nearestNeighbour( vector<int>& leg ) const;
+
+    bool twoOpt( vector<int>& leg ) const;
+
+    bool orOpt( vector<int>& leg ) const;
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // Distances in meters between the rover's start (node 0) and the
+    // waypoints (node i + 1 for waypoint i), row by row.
+    vector<double> mDistances;
+
+    // Nodes per row of mDistances.
+    int mNodes;
+
+    // Order the waypoints are visited in, by index in the course.
+    vector<int> mOrder;
+
+    // Nodes of the leg being improved, from its fixed start to its fixed
+    // end, or to NO_END if the leg ends the course.
+    vector<int> mLeg;
+
+    // Time at which the budget runs out.
+    chrono::steady_clock::time_point mDeadline;
+
+    // Scratch copies of the course for optimize.
+    vector<LocalPoint> mPoints;
+    vector<bool> mFixed;
+    vector<Waypoint> mWaypoints;
+};
+
+#endif // COURSE_OPTIMIZER_HPP
@@ -0,0 +1,218 @@
+#include "flightRecorder.hpp"
+
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "rover.hpp"
+#include "stateMachine.hpp"
+#include "rover_msgs/TargetList.hpp"
+
+namespace
+{
+    // First word of every event in an lcm event log.
+    const uint32_t LOG_SYNC_WORD = 0xEDA1DA01;
+
+    // Signals that mean nav is crashing.
+    const int CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+
+    // Writes value into buffer big endian, as the event log expects.
+    template <typename T>
+    uint8_t* writeBigEndian( uint8_t* buffer, T value )
+    {
+        for( int i = sizeof( T ) - 1; i >= 0; --i )
+        {
+            *buffer++ = static_cast<uint8_t>( static_cast<uint64_t>( value ) >> ( 8 * i ) );
+        }
+        return buffer;
+    } // writeBigEndian()
+
+    // Writes all of data to fd. Returns false if it could not.
+    bool writeAll( int fd, const void* data, size_t size )
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>( data );
+        while( size > 0 )
+        {
+            const ssize_t written = write( fd, bytes, size );
+            if( written <= 0 )
+            {
+                return false;
+            }
+            bytes += written;
+            size -= written;
+        }
+        return true;
+    } // writeAll()
+} // namespace
+
+FlightRecorder* FlightRecorder::sCrashRecorder = nullptr;
+
+// Constructs a FlightRecorder that keeps the last records, at least
+// capacity of them, and writes nav's outputs on the given channels when
+// dumped.
+FlightRecorder::FlightRecorder( int capacity, const string& navStatusChannel, const string& joystickChannel )
+    : mMask( 0 )
+    , mNext( 0 )
+    , mNavStatusChannel( navStatusChannel )
+    , mJoystickChannel( joystickChannel )
+    , mEventNumber( 0 )
+{
+    uint64_t size = 1;
+    while( size < static_cast<uint64_t>( capacity ) )
+    {
+        size *= 2;
+    }
+    mSlots.reset( new Slot[ size ] );
+    mMask = size - 1;
+    for( uint64_t i = 0; i < size; ++i )
+    {
+        mSlots[ i ].sequence.store( 0, memory_order_relaxed );
+        for( atomic<uint64_t>& word : mSlots[ i ].words )
+        {
+            word.store( 0, memory_order_relaxed );
+        }
+    }
+    mNavStatus.nav_state_name.reserve( longestNavStateName() );
+} // FlightRecorder()
+
+// Records one iteration of the state machine, overwriting the oldest
+// record once the buffer is full. Must only be called from one thread.
+void FlightRecorder::record( const FlightRecord& flightRecord )
+{
+    uint64_t words[ RECORD_WORDS ] = {};
+    memcpy( words, &flightRecord, sizeof( FlightRecord ) );
+    const uint64_t index = mNext.load( memory_order_relaxed );
+    Slot& slot = mSlots[ index & mMask ];
+    slot.sequence.store( 2 * index + 1, memory_order_relaxed );
+    atomic_thread_fence( memory_order_release );
+    for( size_t i = 0; i < RECORD_WORDS; ++i )
+    {
+        slot.words[ i ].store( words[ i ], memory_order_relaxed );
+    }
+    slot.sequence.store( 2 * index + 2, memory_order_release );
+    mNext.store( index + 1, memory_order_release );
+} // record()
+
+// Writes the records to an lcm event log at path, oldest first. Each
+// record becomes its inputs on /odometry, /obstacle and /target_list
+// followed by nav's status and joystick command. Does not allocate and
+// only makes async-signal-safe calls, so it can run in a signal
+// handler. Returns false if the log could not be written.
+bool FlightRecorder::dump( const char* path )
+{
+    const int fd = open( path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    const uint64_t end = mNext.load( memory_order_acquire );
+    const uint64_t begin = end > mMask + 1 ? end - ( mMask + 1 ) : 0;
+    mEventNumber = 0;
+    bool written = true;
+    for( uint64_t index = begin; index < end && written; ++index )
+    {
+        // Copy the slot out and check it was not overwritten meanwhile.
+        // A slot being written is skipped rather than waited for, since
+        // the writer may be the thread the dump interrupted.
+        const Slot& slot = mSlots[ index & mMask ];
+        const uint64_t sequence = slot.sequence.load( memory_order_acquire );
+        if( sequence != 2 * index + 2 )
+        {
+            continue;
+        }
+        uint64_t words[ RECORD_WORDS ];
+        for( size_t i = 0; i < RECORD_WORDS; ++i )
+        {
+            words[ i ] = slot.words[ i ].load( memory_order_relaxed );
+        }
+        atomic_thread_fence( memory_order_acquire );
+        if( slot.sequence.load( memory_order_relaxed ) != sequence )
+        {
+            continue;
+        }
+        FlightRecord record;
+        memcpy( &record, words, sizeof( FlightRecord ) );
+
+        const int64_t timestamp = static_cast<int64_t>( record.time * 1e6 );
+        TargetList targetList;
+        targetList.targetList[ 0 ] = record.targets[ 0 ];
+        targetList.targetList[ 1 ] = record.targets[ 1 ];
+        mNavStatus.nav_state_name.assign( navStateName( static_cast<NavState>( record.toState ) ) );
+        mNavStatus.completed_wps = record.completedWaypoints;
+        mNavStatus.total_wps = record.totalWaypoints;
+
+        written = writeEvent( fd, timestamp, "/odometry", mBuffer,
+                              record.odometry.encode( mBuffer, 0, sizeof( mBuffer ) ) ) &&
+                  writeEvent( fd, timestamp, "/obstacle", mBuffer,
+                              record.obstacle.encode( mBuffer, 0, sizeof( mBuffer ) ) ) &&
+                  writeEvent( fd, timestamp, "/target_list", mBuffer,
+                              targetList.encode( mBuffer, 0, sizeof( mBuffer ) ) ) &&
+                  writeEvent( fd, timestamp, mNavStatusChannel.c_str(), mBuffer,
+                              mNavStatus.encode( mBuffer, 0, sizeof( mBuffer ) ) ) &&
+                  writeEvent( fd, timestamp, mJoystickChannel.c_str(), mBuffer,
+                              record.joystick.encode( mBuffer, 0, sizeof( mBuffer ) ) );
+    }
+    return close( fd ) == 0 && written;
+} // dump()
+
+// Gets the number of records recorded since construction, including
+// those that have been overwritten.
+long FlightRecorder::recorded() const
+{
+    return mNext.load( memory_order_acquire );
+} // recorded()
+
+// Gets the number of records the buffer holds.
+int FlightRecorder::capacity() const
+{
+    return mMask + 1;
+} // capacity()
+
+// Dumps this recorder to path if nav crashes with a fatal signal, then
+// lets the signal take its course.
+void FlightRecorder::installCrashHandler( const string& path )
+{
+    mCrashPath = path;
+    sCrashRecorder = this;
+    struct sigaction action;
+    memset( &action, 0, sizeof( action ) );
+    action.sa_handler = &FlightRecorder::handleCrash;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset( &action.sa_mask );
+    for( int signal : CRASH_SIGNALS )
+    {
+        sigaction( signal, &action, nullptr );
+    }
+} // installCrashHandler()
+
+// Writes one event of size bytes of data to the log. A negative size is
+// an encoding error. Returns false if the event could not be written.
+bool FlightRecorder::writeEvent( int fd, int64_t timestamp, const char* channel, const void* data, int size )
+{
+    if( size < 0 )
+    {
+        return false;
+    }
+    const int32_t channelLength = strlen( channel );
+    uint8_t header[ 28 ];
+    uint8_t* position = writeBigEndian( header, LOG_SYNC_WORD );
+    position = writeBigEndian( position, mEventNumber++ );
+    position = writeBigEndian( position, timestamp );
+    position = writeBigEndian( position, channelLength );
+    writeBigEndian( position, static_cast<int32_t>( size ) );
+    return writeAll( fd, header, sizeof( header ) ) &&
+           writeAll( fd, channel, channelLength ) &&
+           writeAll( fd, data, size );
+} // writeEvent()
+
+// Dumps the recorder on a fatal signal and re-raises it with its default
+// action, which the handler was reset to.
+void FlightRecorder::handleCrash( int signal )
+{
+    if( sCrashRecorder )
+    {
+        sCrashRecorder->dump( sCrashRecorder->mCrashPath.c_str() );
+    }
+    raise( signal );
+} // handleCrash()
@@ -0,0 +1,127 @@
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "rover_msgs/Joystick.hpp"
+#include "rover_msgs/NavStatus.hpp"
+#include "rover_msgs/Obstacle.hpp"
+#include "rover_msgs/Odometry.hpp"
+#include "rover_msgs/Target.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// What the state machine saw and decided in one iteration of run.
+struct FlightRecord
+{
+    // Clock time of the iteration in seconds.
+    double time;
+
+    // Inputs the iteration ran on.
+    Odometry odometry;
+    Obstacle obstacle;
+    Target targets[ 2 ];
+
+    // Nav states before and after the iteration, by value.
+    uint8_t fromState;
+    uint8_t toState;
+
+    // Waypoints completed and in the course.
+    int32_t completedWaypoints;
+    int32_t totalWaypoints;
+
+    // Last joystick command sent to the drive system.
+    Joystick joystick;
+};
+
+// This class keeps the last records of the state machine in a fixed
+// size ring buffer. Recording is a copy into the next slot: it does not
+// lock or allocate, so it costs nanoseconds per iteration. Each slot is
+// guarded by a sequence number and holds its record as atomic words, so
+// the buffer can be dumped from a signal handler or another thread while
+// the state machine is writing; a slot caught half written is skipped.
+//
+// A dump is a standard lcm event log of the records, oldest first, on
+// the channels nav listens and publishes on, so lcm-logplayer can replay
+// the inputs into nav (e.g. with --regexp to leave out nav's own
+// outputs) and lcm-spy can show what nav did.
+class FlightRecorder
+{
+public:
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    FlightRecorder( int capacity, const string& navStatusChannel, const string& joystickChannel );
+
+    void record( const FlightRecord& flightRecord );
+
+    bool dump( const char* path );
+
+    long recorded() const;
+
+    int capacity() const;
+
+    void installCrashHandler( const string& path );
+
+private:
+    /*************************************************************************/
+    /* Private Types */
+    /*************************************************************************/
+    static_assert( is_trivially_copyable<FlightRecord>::value, "a slot copies its record word by word" );
+
+    // Number of words a record is stored in.
+    static const size_t RECORD_WORDS = ( sizeof( FlightRecord ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+    struct Slot
+    {
+        // Twice the index of the record in the slot, plus one while the
+        // record is being written.
+        atomic<uint64_t> sequence;
+
+        // The record, kept as atomic words as in Thor::Seqlock, so that
+        // reading it while it is written is a torn copy to skip rather
+        // than a data race.
+        atomic<uint64_t> words[ RECORD_WORDS ];
+    };
+
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    bool writeEvent( int fd, int64_t timestamp, const char* channel, const void* data, int size );
+
+    static void handleCrash( int signal );
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // Ring buffer of records. The capacity is a power of two.
+    unique_ptr<Slot[]> mSlots;
+    uint64_t mMask;
+
+    // Index of the next record. Only the state machine writes it.
+    atomic<uint64_t> mNext;
+
+    // Channels nav publishes its status and joystick commands on.
+    string mNavStatusChannel;
+    string mJoystickChannel;
+
+    // Number of events written by the dump in progress.
+    int64_t mEventNumber;
+
+    // Message and buffer reused to encode events so that dumping does
+    // not allocate, which keeps it safe in a signal handler.
+    NavStatus mNavStatus;
+    uint8_t mBuffer[ 256 ];
+
+    // Path the crash handler dumps to.
+    string mCrashPath;
+
+    // Recorder the crash handler dumps.
+    static FlightRecorder* sCrashRecorder;
+};
+
+#endif // FLIGHT_RECORDER_HPP
@@ -6,7 +6,7 @@
 class DiamondGateSearch : public GateStateMachine
 {
 public:
-    DiamondGateSearch( StateMachine* stateMachine, Rover* rover, const rapidjson::Document& roverConfig );
+    DiamondGateSearch( StateMachine* stateMachine, Rover* rover, const NavConfig& roverConfig );
 
     virtual ~DiamondGateSearch() override;
 
@@ -3,13 +3,30 @@
 #include "utilities.hpp"
 #include "stateMachine.hpp"
 #include "./gate_search/diamondGateSearch.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+namespace
+{
+    // Meters in front of and behind the gate the center points are.
+    const double GATE_APPROACH_DEPTH = 3;
+
+    // Meters ahead along the line through the gate the rover steers to.
+    const double GATE_LOOKAHEAD = 1.5;
+} // namespace
+
 // Constructs a GateStateMachine object with roverStateMachine
-GateStateMachine::GateStateMachine( StateMachine* stateMachine, Rover* rover, const rapidjson::Document& roverConfig )
+GateStateMachine::GateStateMachine( StateMachine* stateMachine, Rover* rover, const NavConfig& roverConfig )
     : mRoverStateMachine( stateMachine )
     , mRoverConfig( roverConfig )
+    , CP1ToCP2CorrectDir( true )
+    , mCenterPoint1Clockwise( true )
+    , mNextStop( 0 )
+    , mOriginalSpinAngle( 0 )
+    , mWaitStarted( false )
+    , mWaitStartTime( 0 )
+    , mShimmyDirection( 1 )
     , mPhoebe( rover ) {}
 
 GateStateMachine::~GateStateMachine() {}
@@ -72,36 +89,53 @@ NavState GateStateMachine::run()
     } // switch
 } // run
 
-//
+// Executes the logic for a gate spin, which looks for the second post
+// the same way a search spin looks for a target: continuously at the
+// rate perception keeps up with, or stopping every waitStepSize
+// degrees.
 NavState GateStateMachine::executeGateSpin()
 {
     // degrees to turn to before performing a search wait.
-    double waitStepSize = mRoverConfig[ "search" ][ "searchWaitStepSize" ].GetDouble();
-    static double nextStop = 0; // to force the rover to wait initially
-    static double mOriginalSpinAngle = 0; //initialize, is corrected on first call
+    double waitStepSize = mRoverConfig.search.searchWaitStepSize;
 
     if( mPhoebe->roverStatus().target2().distance >= 0 ||
         ( mPhoebe->roverStatus().target().distance >= 0 && mPhoebe->roverStatus().target().id != lastKnownPost1.id ))
     {
+        mNextStop = 0;
         updatePost2Info();
         calcCenterPoint();
         return NavState::GateTurnToCentPoint;
     }
 
-    if ( nextStop == 0 )
+    const double bearing = mPhoebe->roverStatus().odometry().bearing_deg;
+    if ( mNextStop == 0 )
     {
         // get current angle and set as origAngle
-        mOriginalSpinAngle = mPhoebe->roverStatus().odometry().bearing_deg; //doublecheck
-        nextStop = mOriginalSpinAngle;
+        mOriginalSpinAngle = bearing; //doublecheck
+        mNextStop = mOriginalSpinAngle;
     }
-    if( mPhoebe->turn( nextStop ) )
+    const double spinRate = mPhoebe->spinRate();
+    if( mRoverConfig.search.continuousSpin && spinRate > 0 )
     {
-        if( nextStop - mOriginalSpinAngle >= 360 )
+        // Follow the bearing unwrapped so the spin ends after a full
+        // turn.
+        mNextStop += mod( bearing - mNextStop + 180, 360 ) - 180;
+        if( mNextStop - mOriginalSpinAngle >= 360 )
         {
-            nextStop = 0;
+            mNextStop = 0;
             return NavState::GateTurn;
         }
-        nextStop += waitStepSize;
+        mPhoebe->spin( spinRate );
+        return NavState::GateSpin;
+    }
+    if( mPhoebe->turn( mNextStop ) )
+    {
+        if( mNextStop - mOriginalSpinAngle >= 360 )
+        {
+            mNextStop = 0;
+            return NavState::GateTurn;
+        }
+        mNextStop += waitStepSize;
         return NavState::GateSpinWait;
     }
     return NavState::GateSpin;
@@ -110,27 +144,25 @@ NavState GateStateMachine::executeGateSpin()
 //
 NavState GateStateMachine::executeGateSpinWait()
 {
-    static bool started = false;
-    static time_t startTime;
-
     if( mPhoebe->roverStatus().target2().distance >= 0 ||
         ( mPhoebe->roverStatus().target().distance >= 0 && mPhoebe->roverStatus().target().id != lastKnownPost1.id ))
     {
+        mNextStop = 0;
         updatePost2Info();
         calcCenterPoint();
         return NavState::GateTurnToCentPoint;
     }
 
-    if( !started )
+    if( !mWaitStarted )
     {
         mPhoebe->stop();
-        startTime = time( nullptr );
-        started = true;
+        mWaitStartTime = mPhoebe->clock().now();
+        mWaitStarted = true;
     }
-    double waitTime = mRoverConfig[ "search" ][ "searchWaitTime" ].GetDouble();
-    if( difftime( time( nullptr ), startTime ) > waitTime )
+    double waitTime = mRoverConfig.search.searchWaitTime;
+    if( mPhoebe->clock().now() - mWaitStartTime > waitTime )
     {
-        started = false;
+        mWaitStarted = false;
         return NavState::GateSpin;
     }
     return NavState::GateSpinWait;
@@ -141,6 +173,7 @@ NavState GateStateMachine::executeGateTurn()
 {
     if( mGateSearchPoints.empty() )
     {
+        refinePost( lastKnownPost1 );
         initializeSearch();
     }
 
@@ -195,6 +228,7 @@ NavState GateStateMachine::executeGateDrive()
 
 NavState GateStateMachine::executeGateTurnToCentPoint()
 {
+    refineGate();
     if( mPhoebe->turn( centerPoint1 ) )
     {
         return NavState::GateDriveToCentPoint;
@@ -204,6 +238,7 @@ NavState GateStateMachine::executeGateTurnToCentPoint()
 
 NavState GateStateMachine::executeGateDriveToCentPoint()
 {
+    refineGate();
     // TODO: Obstacle Avoidance?
     DriveStatus driveStatus = mPhoebe->drive( centerPoint1 );
 
@@ -220,6 +255,7 @@ NavState GateStateMachine::executeGateDriveToCentPoint()
 
 NavState GateStateMachine::executeGateFace()
 {
+    refineGate();
     if( mPhoebe->turn( centerPoint2 ) )
     {
         return NavState::GateShimmy;
@@ -229,17 +265,23 @@ NavState GateStateMachine::executeGateFace()
 
 NavState GateStateMachine::executeGateShimmy()
 {
-    static int direction = 1; // 1 = forward, -1 = backwards
-    const double fovDepth = mRoverConfig["computerVision"]["visionDistance"].GetDouble();
-    const double fovAngle = mRoverConfig["computerVision"]["fieldOfViewSafeAngle"].GetDouble();
-    const Odometry currOdom = mPhoebe->roverStatus().odometry();
+    // With the posts mapped the drive through keeps to the line through
+    // the middle of the gate, so there is nothing to line up by eye.
+    refineGate();
+    if( isGateMapped() )
+    {
+        mShimmyDirection = 1;
+        return NavState::GateDriveThrough;
+    }
+    const double fovDepth = mRoverConfig.computerVision.visionDistance;
+    const double fovAngle = mRoverConfig.computerVision.fieldOfViewSafeAngle;
 
     // If we are centered
     const double targetAnglesDiff = mPhoebe->roverStatus().target().bearing +
                                     mPhoebe->roverStatus().target2().bearing;
-    if(targetAnglesDiff < mRoverConfig["navThresholds"]["gateCenteredAngleDiff"].GetDouble())
+    if(targetAnglesDiff < mRoverConfig.navThresholds.gateCenteredAngleDiff)
     {
-        direction = 1;
+        mShimmyDirection = 1;
         return NavState::GateDriveThrough;
     }
 
@@ -251,31 +293,48 @@ NavState GateStateMachine::executeGateShimmy()
     if(!visibleTargetAngles || !visibleTargetDists)
     {
         mPhoebe->stop();
-        direction = direction == 1 ? -1 : 1;
+        mShimmyDirection = mShimmyDirection == 1 ? -1 : 1;
         return NavState::GateFace;
     }
 
     // Otherwise keep driving
     const double gateWidth = mPhoebe->roverStatus().path().front().gate_width;
-    const double gateAngle = calcBearing(lastKnownPost1.odom, lastKnownPost2.odom); // Angle from post 1 to post 2
-    const Odometry gateCent = createOdom(lastKnownPost1.odom, gateAngle, gateWidth / 2, mPhoebe);
-    const double roverToGateCentAngle = calcBearing(currOdom, gateCent); // ablsolute angle
-    mPhoebe->drive(direction, roverToGateCentAngle); // TODO: drive straight when going backwards
+    const LocalPoint post1 = mPhoebe->projection().toLocal(lastKnownPost1.odom);
+    const LocalPoint post2 = mPhoebe->projection().toLocal(lastKnownPost2.odom);
+    const double gateAngle = planarBearing(post1, post2); // Angle from post 1 to post 2
+    const LocalPoint gateCent = offsetPoint(post1, gateAngle, gateWidth / 2);
+    const double roverToGateCentAngle = planarBearing(mPhoebe->position(), gateCent); // ablsolute angle
+    mPhoebe->drive(mShimmyDirection, roverToGateCentAngle); // TODO: drive straight when going backwards
     return NavState::GateShimmy;
 } // executeGateShimmy()
 
 NavState GateStateMachine::executeGateDriveThrough()
 {
+    refineGate();
     // TODO: Obstacle Avoidance?
-    DriveStatus driveStatus = mPhoebe->drive( centerPoint2 );
+    DriveStatus driveStatus;
+    if( isGateMapped() )
+    {
+        // Keep to the line through the middle of the gate.
+        const LocalPoint lookaheadPoint = gateLinePoint( distanceAlongGate() + GATE_LOOKAHEAD );
+        driveStatus = mPhoebe->drive( planarDistance( mPhoebe->position(), centerPoint2 ),
+                                      planarBearing( mPhoebe->position(), lookaheadPoint ) );
+        if( driveStatus == DriveStatus::OffCourse )
+        {
+            mPhoebe->turn( lookaheadPoint );
+        }
+    }
+    else
+    {
+        driveStatus = mPhoebe->drive( centerPoint2 );
+    }
 
     if( driveStatus == DriveStatus::Arrived )
     {
         if(!CP1ToCP2CorrectDir)
         {
-            const Odometry temp = centerPoint1;
-            centerPoint1 = centerPoint2;
-            centerPoint2 = temp;
+            mCenterPoint1Clockwise = !mCenterPoint1Clockwise;
+            placeCenterPoints();
             CP1ToCP2CorrectDir = true;
             return NavState::GateFace;
         }
@@ -324,21 +383,15 @@ void GateStateMachine::updatePost2Info()
 // through it in the correct direction.
 void GateStateMachine::calcCenterPoint()
 {
-    const Odometry& currOdom = mPhoebe->roverStatus().odometry();
-    const double distFromGate = 3;
-    const double gateWidth = mPhoebe->roverStatus().path().front().gate_width;
-    const double tagToPointAngle = radianToDegree(atan2(distFromGate, gateWidth / 2));
-    const double gateAngle = calcBearing(lastKnownPost1.odom, lastKnownPost2.odom);
-    const double absAngle1 = mod(gateAngle + tagToPointAngle, 360);
-    const double absAngle2 = mod(absAngle1 + 180, 360);
-    const double tagToPointDist = sqrt(pow(gateWidth / 2, 2) + pow(distFromGate, 2));
+    refinePost( lastKnownPost1 );
+    refinePost( lastKnownPost2 );
     // Assuming that CV works well enough that we don't pass through the gate before
     // finding the second post. Thus, centerPoint1 will always be closer.
     // TODO: verify this
-    centerPoint1 = createOdom(lastKnownPost1.odom, absAngle1, tagToPointDist, mPhoebe);
-    centerPoint2 = createOdom(lastKnownPost2.odom, absAngle2, tagToPointDist, mPhoebe);
-    const double cp1Dist = estimateNoneuclid(currOdom, centerPoint1);
-    const double cp2Dist = estimateNoneuclid(currOdom, centerPoint2);
+    mCenterPoint1Clockwise = true;
+    placeCenterPoints();
+    const double cp1Dist = planarDistance(mPhoebe->position(), centerPoint1);
+    const double cp2Dist = planarDistance(mPhoebe->position(), centerPoint2);
     if(lastKnownPost1.id % 2)
     {
         CP1ToCP2CorrectDir = true;
@@ -349,16 +402,91 @@ void GateStateMachine::calcCenterPoint()
     }
     if(cp1Dist > cp2Dist)
     {
-        const Odometry temp = centerPoint1;
-        centerPoint1 = centerPoint2;
-        centerPoint2 = temp;
+        mCenterPoint1Clockwise = false;
+        placeCenterPoints();
         CP1ToCP2CorrectDir = !CP1ToCP2CorrectDir;
     }
-
 } // calcCenterPoint()
 
+// Moves the stored location of post to the rover's map estimate of it,
+// which averages every sighting of the post so far, if the map is used
+// and the post is on it.
+void GateStateMachine::refinePost( Waypoint& post )
+{
+    if( !mRoverConfig.targetTracker.enabled )
+    {
+        return;
+    }
+    const TargetTracker::Track* landmark = mPhoebe->targetTracker().landmark( post.id );
+    if( landmark )
+    {
+        post.odom = mPhoebe->projection().toOdometry( landmark->position );
+    }
+} // refinePost()
+
+// Refines both posts and moves the center points to match, keeping the
+// side of the gate the rover is approaching from. Called every tick the
+// rover heads for the gate, so the geometry improves as the posts are
+// seen again instead of staying fixed at their first sightings.
+void GateStateMachine::refineGate()
+{
+    refinePost( lastKnownPost1 );
+    refinePost( lastKnownPost2 );
+    placeCenterPoints();
+} // refineGate()
+
+// Places the center points GATE_APPROACH_DEPTH in front of and behind
+// the middle of the gate from the stored posts, centerPoint1 on the side
+// given by mCenterPoint1Clockwise.
+void GateStateMachine::placeCenterPoints()
+{
+    const double distFromGate = GATE_APPROACH_DEPTH;
+    const double gateWidth = mPhoebe->roverStatus().path().front().gate_width;
+    const double tagToPointAngle = radianToDegree(atan2(distFromGate, gateWidth / 2));
+    const LocalPoint post1 = mPhoebe->projection().toLocal(lastKnownPost1.odom);
+    const LocalPoint post2 = mPhoebe->projection().toLocal(lastKnownPost2.odom);
+    const double gateAngle = planarBearing(post1, post2);
+    const double absAngle1 = mod(gateAngle + tagToPointAngle, 360);
+    const double absAngle2 = mod(absAngle1 + 180, 360);
+    const double tagToPointDist = sqrt(pow(gateWidth / 2, 2) + pow(distFromGate, 2));
+    const LocalPoint clockwisePoint = offsetPoint(post1, absAngle1, tagToPointDist);
+    const LocalPoint counterClockwisePoint = offsetPoint(post2, absAngle2, tagToPointDist);
+    centerPoint1 = mCenterPoint1Clockwise ? clockwisePoint : counterClockwisePoint;
+    centerPoint2 = mCenterPoint1Clockwise ? counterClockwisePoint : clockwisePoint;
+} // placeCenterPoints()
+
+// Returns true if the gate is located by the rover's map of the posts
+// rather than by single sightings of them.
+bool GateStateMachine::isGateMapped() const
+{
+    return mRoverConfig.targetTracker.enabled &&
+           mPhoebe->targetTracker().landmark( lastKnownPost1.id ) &&
+           mPhoebe->targetTracker().landmark( lastKnownPost2.id );
+} // isGateMapped()
+
+// Gets the rover's distance from the middle of the gate along the line
+// from centerPoint1 to centerPoint2, negative before the gate.
+double GateStateMachine::distanceAlongGate() const
+{
+    const double length = planarDistance( centerPoint1, centerPoint2 );
+    const double directionX = ( centerPoint2.x - centerPoint1.x ) / length;
+    const double directionY = ( centerPoint2.y - centerPoint1.y ) / length;
+    const double offsetX = mPhoebe->position().x - ( centerPoint1.x + centerPoint2.x ) / 2;
+    const double offsetY = mPhoebe->position().y - ( centerPoint1.y + centerPoint2.y ) / 2;
+    return offsetX * directionX + offsetY * directionY;
+} // distanceAlongGate()
+
+// Gets the point along meters along the line from centerPoint1 through
+// the middle of the gate, clamped to the line's ends.
+LocalPoint GateStateMachine::gateLinePoint( double along ) const
+{
+    const double fraction = min( 1.0, max( 0.0, 0.5 + along / planarDistance( centerPoint1, centerPoint2 ) ) );
+    return { centerPoint1.x + fraction * ( centerPoint2.x - centerPoint1.x ),
+             centerPoint1.y + fraction * ( centerPoint2.y - centerPoint1.y ) };
+} // gateLinePoint()
+
 // Creates an GateStateMachine object
-GateStateMachine* GateFactory( StateMachine* stateMachine, Rover* phoebe, const rapidjson::Document& roverConfig )
+GateStateMachine* GateFactory( StateMachine* stateMachine, Rover* phoebe, const NavConfig& roverConfig )
 {
     return new DiamondGateSearch( stateMachine, phoebe, roverConfig );
 } // GateFactor()
@@ -15,7 +15,7 @@ public:
     /*************************************************************************/
     /* Public Member Functions */
     /*************************************************************************/
-    GateStateMachine( StateMachine* stateMachine, Rover* rover, const rapidjson::Document& roverConfig );
+    GateStateMachine( StateMachine* stateMachine, Rover* rover, const NavConfig& roverConfig );
 
     virtual ~GateStateMachine();
 
@@ -61,6 +61,18 @@ private:
 
     void calcCenterPoint();
 
+    void refinePost( Waypoint& post );
+
+    void refineGate();
+
+    void placeCenterPoints();
+
+    bool isGateMapped() const;
+
+    double distanceAlongGate() const;
+
+    LocalPoint gateLinePoint( double along ) const;
+
     /*************************************************************************/
     /* Private Member Variables */
     /*************************************************************************/
@@ -68,15 +80,34 @@ private:
     StateMachine* mRoverStateMachine;
 
     // Reference to config variables
-    const rapidjson::Document& mRoverConfig;
+    const NavConfig& mRoverConfig;
 
-    // Points in frnot of center of gate
-    Odometry centerPoint1;
-    Odometry centerPoint2;
+    // Points in frnot of center of gate, on the local plane
+    LocalPoint centerPoint1;
+    LocalPoint centerPoint2;
 
     //
     bool CP1ToCP2CorrectDir;
 
+    // Whether centerPoint1 is the point on the side of the gate that is
+    // clockwise from the line from post 1 to post 2.
+    bool mCenterPoint1Clockwise;
+
+    // Bearing the gate spin turns to next, or during a continuous spin
+    // the bearing turned to so far, unwrapped. Zero until the spin
+    // starts, which forces the rover to wait initially.
+    double mNextStop;
+
+    // Bearing the rover had when the gate spin started.
+    double mOriginalSpinAngle;
+
+    // Whether the rover is waiting for CV and since when.
+    bool mWaitStarted;
+    double mWaitStartTime;
+
+    // Direction the rover shimmies in: 1 = forward, -1 = backwards.
+    int mShimmyDirection;
+
 protected:
     /*************************************************************************/
     /* Protected Member Variables */
@@ -85,6 +116,6 @@ protected:
     Rover* mPhoebe;
 };
 
-GateStateMachine* GateFactory( StateMachine* stateMachine, Rover* phoebe, const rapidjson::Document& roverConfig );
+GateStateMachine* GateFactory( StateMachine* stateMachine, Rover* phoebe, const NavConfig& roverConfig );
 
 #endif //GATE_STATE_MACHINE_HPP
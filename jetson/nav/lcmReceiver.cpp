@@ -0,0 +1,158 @@
+#include "lcmReceiver.hpp"
+
+namespace
+{
+    // Milliseconds the receive thread waits for a message before
+    // checking whether it should stop.
+    const int RECEIVE_TIMEOUT = 100;
+} // namespace
+
+// Constructs an LcmReceiver that subscribes to the nav input channels
+// of lcmObject. Messages are not handled until start is called.
+LcmReceiver::LcmReceiver( lcm::LCM& lcmObject )
+    : mLcmObject( lcmObject )
+    , mRunning( false )
+    , mFailed( false )
+{
+    mLcmObject.subscribe( "/auton", &LcmReceiver::autonState, this );
+    mLcmObject.subscribe( "/course", &LcmReceiver::course, this );
+    mLcmObject.subscribe( "/obstacle", &LcmReceiver::obstacle, this );
+    mLcmObject.subscribe( "/odometry", &LcmReceiver::odometry, this );
+    mLcmObject.subscribe( "/radio", &LcmReceiver::radioSignalStrength, this );
+    mLcmObject.subscribe( "/rr_drop_complete", &LcmReceiver::repeaterDropComplete, this );
+    mLcmObject.subscribe( "/target_list", &LcmReceiver::targetList, this );
+} // LcmReceiver()
+
+// Destructs the LcmReceiver object. Stops the receive thread.
+LcmReceiver::~LcmReceiver()
+{
+    stop();
+} // ~LcmReceiver()
+
+// Starts handling messages on the receive thread. The thread inherits
+// the signal mask of the caller.
+void LcmReceiver::start()
+{
+    if( !mRunning.exchange( true ) )
+    {
+        mThread = thread( &LcmReceiver::receive, this );
+    }
+} // start()
+
+// Stops the receive thread and waits for it to finish.
+void LcmReceiver::stop()
+{
+    mRunning = false;
+    if( mThread.joinable() )
+    {
+        mThread.join();
+    }
+} // stop()
+
+// Returns false if the receive thread stopped because lcm reported an
+// error.
+bool LcmReceiver::good() const
+{
+    return !mFailed;
+} // good()
+
+// Hands the messages received since the last delivery to the state
+// machine. Must only be called from the thread running the state
+// machine.
+void LcmReceiver::deliver( StateMachine& stateMachine )
+{
+    AutonState autonState;
+    if( mAutonState.fetch( autonState ) )
+    {
+        stateMachine.updateRoverStatus( autonState );
+    }
+    const Course* course = mCourse.fetch();
+    if( course )
+    {
+        stateMachine.updateRoverStatus( *course );
+    }
+    Obstacle obstacle;
+    if( mObstacle.fetch( obstacle ) )
+    {
+        stateMachine.updateRoverStatus( obstacle );
+    }
+    Odometry odometry;
+    if( mOdometry.fetch( odometry ) )
+    {
+        stateMachine.updateRoverStatus( odometry );
+    }
+    RadioSignalStrength radioSignalStrength;
+    if( mRadioSignalStrength.fetch( radioSignalStrength ) )
+    {
+        stateMachine.updateRoverStatus( radioSignalStrength );
+    }
+    RepeaterDropComplete repeaterDropComplete;
+    if( mRepeaterDropComplete.fetch( repeaterDropComplete ) )
+    {
+        stateMachine.updateRepeaterComplete();
+    }
+    TargetList targetList;
+    if( mTargetList.fetch( targetList ) )
+    {
+        stateMachine.updateRoverStatus( targetList );
+    }
+} // deliver()
+
+// Handles messages until stopped or lcm reports an error.
+void LcmReceiver::receive()
+{
+    while( mRunning )
+    {
+        if( mLcmObject.handleTimeout( RECEIVE_TIMEOUT ) < 0 )
+        {
+            mFailed = true;
+            return;
+        }
+    }
+} // receive()
+
+// Posts the auton state lcm message for the control thread.
+void LcmReceiver::autonState( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                              const AutonState* autonState )
+{
+    mAutonState.set( *autonState );
+} // autonState()
+
+// Posts the course lcm message for the control thread.
+void LcmReceiver::course( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Course* course )
+{
+    mCourse.set( *course );
+} // course()
+
+// Posts the obstacle lcm message for the control thread.
+void LcmReceiver::obstacle( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Obstacle* obstacle )
+{
+    mObstacle.set( *obstacle );
+} // obstacle()
+
+// Posts the odometry lcm message for the control thread.
+void LcmReceiver::odometry( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Odometry* odometry )
+{
+    mOdometry.set( *odometry );
+} // odometry()
+
+// Posts the radio lcm message for the control thread.
+void LcmReceiver::radioSignalStrength( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                                       const RadioSignalStrength* radioSignalStrength )
+{
+    mRadioSignalStrength.set( *radioSignalStrength );
+} // radioSignalStrength()
+
+// Posts that the radio repeater was dropped for the control thread.
+void LcmReceiver::repeaterDropComplete( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                                        const RepeaterDropComplete* repeaterDropComplete )
+{
+    mRepeaterDropComplete.set( *repeaterDropComplete );
+} // repeaterDropComplete()
+
+// Posts the target lcm message for the control thread.
+void LcmReceiver::targetList( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                              const TargetList* targetList )
+{
+    mTargetList.set( *targetList );
+} // targetList()
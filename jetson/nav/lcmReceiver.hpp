@@ -0,0 +1,82 @@
+#ifndef LCM_RECEIVER_HPP
+#define LCM_RECEIVER_HPP
+
+#include <atomic>
+#include <thread>
+#include <lcm/lcm-cpp.hpp>
+#include "stateMachine.hpp"
+#include "thor.hpp"
+#include "rover_msgs/AutonState.hpp"
+#include "rover_msgs/Course.hpp"
+#include "rover_msgs/Obstacle.hpp"
+#include "rover_msgs/Odometry.hpp"
+#include "rover_msgs/RadioSignalStrength.hpp"
+#include "rover_msgs/RepeaterDropComplete.hpp"
+#include "rover_msgs/TargetList.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// This class receives the nav input lcm messages on a thread of its
+// own and leaves the latest message of each channel in a lock-free
+// cell. The control thread delivers the latest messages to the state
+// machine at the start of each tick, so decoding and handling a burst
+// of messages never delays a tick and a long tick never backs up the
+// lcm socket.
+class LcmReceiver
+{
+public:
+    LcmReceiver( lcm::LCM& lcmObject );
+
+    ~LcmReceiver();
+
+    void start();
+
+    void stop();
+
+    bool good() const;
+
+    void deliver( StateMachine& stateMachine );
+
+private:
+    void receive();
+
+    void autonState( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const AutonState* autonState );
+
+    void course( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Course* course );
+
+    void obstacle( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Obstacle* obstacle );
+
+    void odometry( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const Odometry* odometry );
+
+    void radioSignalStrength( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                              const RadioSignalStrength* radioSignalStrength );
+
+    void repeaterDropComplete( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                               const RepeaterDropComplete* repeaterDropComplete );
+
+    void targetList( const lcm::ReceiveBuffer* receiveBuffer, const string& channel, const TargetList* targetList );
+
+    // Lcm object the messages are received from.
+    lcm::LCM& mLcmObject;
+
+    // Thread handling the lcm messages.
+    thread mThread;
+
+    // Whether the receive thread should keep running, and whether it
+    // stopped because lcm reported an error.
+    atomic<bool> mRunning;
+    atomic<bool> mFailed;
+
+    // Latest message received on each channel. The course holds a
+    // variable number of waypoints, so it cannot go through a seqlock.
+    Thor::Seqlock<AutonState> mAutonState;
+    Thor::TripleBuffer<Course> mCourse;
+    Thor::Seqlock<Obstacle> mObstacle;
+    Thor::Seqlock<Odometry> mOdometry;
+    Thor::Seqlock<RadioSignalStrength> mRadioSignalStrength;
+    Thor::Seqlock<RepeaterDropComplete> mRepeaterDropComplete;
+    Thor::Seqlock<TargetList> mTargetList;
+};
+
+#endif // LCM_RECEIVER_HPP
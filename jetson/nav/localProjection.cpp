@@ -0,0 +1,93 @@
+#include "localProjection.hpp"
+
+#include <cmath>
+#include "utilities.hpp"
+
+// Constructs a LocalProjection anchored at latitude and longitude zero.
+LocalProjection::LocalProjection()
+    : LocalProjection( Odometry() )
+{
+} // LocalProjection()
+
+// Constructs a LocalProjection anchored at origin. The meters per
+// minute match those used by createOdom so points round trip exactly.
+LocalProjection::LocalProjection( const Odometry& origin )
+    : mOrigin( origin )
+    , mOriginLatMinutes( origin.latitude_deg * 60 + origin.latitude_min )
+    , mOriginLonMinutes( origin.longitude_deg * 60 + origin.longitude_min )
+    , mMetersPerLatMinute( 1 / LAT_METER_IN_MINUTES )
+    , mMetersPerLonMinute( EARTH_CIRCUM * cos( degreeToRadian( origin.latitude_deg, origin.latitude_min ) ) / 360 / 60 )
+{
+} // LocalProjection()
+
+// Projects odometry onto the local plane.
+LocalPoint LocalProjection::toLocal( const Odometry& odometry ) const
+{
+    const double latMinutes = odometry.latitude_deg * 60 + odometry.latitude_min;
+    const double lonMinutes = odometry.longitude_deg * 60 + odometry.longitude_min;
+    return { ( lonMinutes - mOriginLonMinutes ) * mMetersPerLonMinute,
+             ( latMinutes - mOriginLatMinutes ) * mMetersPerLatMinute };
+} // toLocal()
+
+// Converts a local point back to odometry. The degrees are truncated
+// toward zero and the minutes carry the same sign, matching
+// degreeToRadian. The bearing and speed are zero.
+Odometry LocalProjection::toOdometry( const LocalPoint& point ) const
+{
+    return toOdometry( point, Odometry() );
+} // toOdometry()
+
+// Converts a local point back to odometry, copying the bearing and
+// speed from base.
+Odometry LocalProjection::toOdometry( const LocalPoint& point, const Odometry& base ) const
+{
+    Odometry odometry = base;
+    const double latMinutes = mOriginLatMinutes + point.y / mMetersPerLatMinute;
+    const double lonMinutes = mOriginLonMinutes + point.x / mMetersPerLonMinute;
+    odometry.latitude_deg = static_cast<int32_t>( latMinutes / 60 );
+    odometry.latitude_min = latMinutes - odometry.latitude_deg * 60.0;
+    odometry.longitude_deg = static_cast<int32_t>( lonMinutes / 60 );
+    odometry.longitude_min = lonMinutes - odometry.longitude_deg * 60.0;
+    return odometry;
+} // toOdometry()
+
+// Gets the odometry the projection is anchored at.
+const Odometry& LocalProjection::origin() const
+{
+    return mOrigin;
+} // origin()
+
+// Gets the number of meters per minute of latitude.
+double LocalProjection::metersPerLatMinute() const
+{
+    return mMetersPerLatMinute;
+} // metersPerLatMinute()
+
+// Gets the number of meters per minute of longitude at the origin.
+double LocalProjection::metersPerLonMinute() const
+{
+    return mMetersPerLonMinute;
+} // metersPerLonMinute()
+
+// Calculates the distance in meters between two local points.
+double planarDistance( const LocalPoint& start, const LocalPoint& dest )
+{
+    return hypot( dest.x - start.x, dest.y - start.y );
+} // planarDistance()
+
+// Calculates the absolute bearing in degrees, clockwise from north in
+// [0, 360), from start to dest.
+double planarBearing( const LocalPoint& start, const LocalPoint& dest )
+{
+    const double bearing = radianToDegree( atan2( dest.x - start.x, dest.y - start.y ) );
+    return bearing < 0 ? bearing + 360 : bearing;
+} // planarBearing()
+
+// Creates the local point at the given absolute bearing (degrees) and
+// distance (meters) from start.
+LocalPoint offsetPoint( const LocalPoint& start, const double bearing, const double distance )
+{
+    const double bearingRadians = degreeToRadian( bearing );
+    return { start.x + distance * sin( bearingRadians ),
+             start.y + distance * cos( bearingRadians ) };
+} // offsetPoint()
@@ -0,0 +1,83 @@
+#ifndef LOCAL_PROJECTION_HPP
+#define LOCAL_PROJECTION_HPP
+
+#include "rover_msgs/Odometry.hpp"
+
+using namespace rover_msgs;
+
+// A point in the local tangent plane, in meters east (x) and north (y)
+// of the projection's origin.
+struct LocalPoint
+{
+    double x;
+    double y;
+};
+
+// This class projects degree-and-minute odometry onto a local east-north
+// plane anchored at an origin (the rover's position when the course
+// starts). Within the few kilometers of a course the projection is a
+// linear map, so converting a point costs a couple of multiplications
+// and distances and bearings become planar operations.
+class LocalProjection
+{
+public:
+    LocalProjection();
+
+    LocalProjection( const Odometry& origin );
+
+    LocalPoint toLocal( const Odometry& odometry ) const;
+
+    Odometry toOdometry( const LocalPoint& point ) const;
+
+    Odometry toOdometry( const LocalPoint& point, const Odometry& base ) const;
+
+    // Converts the odometry in [first, last) to local points written to
+    // out.
+    template <typename InputIt, typename OutputIt>
+    OutputIt toLocal( InputIt first, InputIt last, OutputIt out ) const
+    {
+        for( ; first != last; ++first, ++out )
+        {
+            *out = toLocal( *first );
+        }
+        return out;
+    } // toLocal()
+
+    // Converts the local points in [first, last) to odometry written to
+    // out.
+    template <typename InputIt, typename OutputIt>
+    OutputIt toOdometry( InputIt first, InputIt last, OutputIt out ) const
+    {
+        for( ; first != last; ++first, ++out )
+        {
+            *out = toOdometry( *first );
+        }
+        return out;
+    } // toOdometry()
+
+    const Odometry& origin() const;
+
+    double metersPerLatMinute() const;
+
+    double metersPerLonMinute() const;
+
+private:
+    // The odometry the projection is anchored at.
+    Odometry mOrigin;
+
+    // The origin's latitude and longitude in minutes.
+    double mOriginLatMinutes;
+    double mOriginLonMinutes;
+
+    // Meters per minute of latitude and of longitude at the origin.
+    double mMetersPerLatMinute;
+    double mMetersPerLonMinute;
+};
+
+double planarDistance( const LocalPoint& start, const LocalPoint& dest );
+
+double planarBearing( const LocalPoint& start, const LocalPoint& dest );
+
+LocalPoint offsetPoint( const LocalPoint& start, const double bearing, const double distance );
+
+#endif // LOCAL_PROJECTION_HPP
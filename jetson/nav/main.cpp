@@ -1,120 +1,91 @@
+#include <csignal>
 #include <iostream>
+#include <sys/signalfd.h>
+#include <unistd.h>
 #include <lcm/lcm-cpp.hpp>
 #include "stateMachine.hpp"
+#include "lcmReceiver.hpp"
+#include "clock.hpp"
+#include "navConfigWatcher.hpp"
+#include "controlLoop.hpp"
 
 using namespace rover_msgs;
 using namespace std;
 
-// This class handles all incoming LCM messages for the autonomous
-// navigation of the rover.
-class LcmHandlers
+// Runs the autonomous navigation of the rover.
+int main()
 {
-public:
-    // Constructs an LcmHandler with the given state machine to work
-    // with.
-    LcmHandlers( StateMachine* stateMachine )
-        : mStateMachine( stateMachine )
-    {}
-
-    // Sends the auton state lcm message to the state machine.
-    void autonState(
-        const lcm::ReceiveBuffer* recieveBuffer,
-        const string& channel,
-        const AutonState* autonState
-        )
-    {
-        mStateMachine->updateRoverStatus( *autonState );
-    }
-
-    // Sends the course lcm message to the state machine.
-    void course(
-        const lcm::ReceiveBuffer* recieveBuffer,
-        const string& channel,
-        const Course* course
-        )
+    lcm::LCM lcmObject;
+    if( !lcmObject.good() )
     {
-        mStateMachine->updateRoverStatus( *course );
+        cerr << "Error: cannot create LCM\n";
+        return 1;
     }
 
-    // Sends the obstacle lcm message to the state machine.
-    void obstacle(
-        const lcm::ReceiveBuffer* receiveBuffer,
-        const string& channel,
-        const Obstacle* obstacle
-        )
+    const char* configRoot = getenv( "MROVER_CONFIG" );
+    if( !configRoot )
     {
-        mStateMachine->updateRoverStatus( *obstacle );
+        cerr << "Error: MROVER_CONFIG is not set\n";
+        return 1;
     }
-
-    // Sends the odometry lcm message to the state machine.
-    void odometry(
-        const lcm::ReceiveBuffer* recieveBuffer,
-        const string& channel,
-        const Odometry* odometry
-        )
+    NavConfigWatcher configWatcher( string( configRoot ) + "/config_nav/config.json" );
+    NavConfig config;
+    string configError;
+    if( !configWatcher.load( config, configError ) )
     {
-        mStateMachine->updateRoverStatus( *odometry );
+        cerr << "Error: invalid nav config " << configWatcher.path() << ": " << configError << "\n";
+        return 1;
     }
 
-    // Sends the target lcm message to the state machine.
-    void targetList(
-        const lcm::ReceiveBuffer* receiveBuffer,
-        const string& channel,
-        const TargetList* targetListIn
-        )
-    {
-        mStateMachine->updateRoverStatus( *targetListIn );
-    }
+    // Dump the flight recorder on a crash, and on SIGUSR1 between ticks.
+    // SIGUSR1 is blocked before any thread starts, including the state
+    // machine's search planner and the receive thread, so that only the
+    // signalfd sees it.
+    sigset_t dumpSignals;
+    sigemptyset( &dumpSignals );
+    sigaddset( &dumpSignals, SIGUSR1 );
+    sigprocmask( SIG_BLOCK, &dumpSignals, nullptr );
+    const int dumpFd = signalfd( -1, &dumpSignals, SFD_NONBLOCK | SFD_CLOEXEC );
 
-    // Sends the radio lcm message to the state machine.
-    void radioSignalStrength(
-        const lcm::ReceiveBuffer* receiveBuffer,
-        const string& channel,
-        const RadioSignalStrength* signalIn
-        )
-    {
-        mStateMachine->updateRoverStatus( *signalIn );
-    }
+    SystemClock clock;
+    StateMachine roverStateMachine( lcmObject, config, clock );
+    LcmReceiver lcmReceiver( lcmObject );
+    roverStateMachine.flightRecorder().installCrashHandler( config.flightRecorder.crashPath );
 
-    // Updates Radio Repeater bool in state machine.
-    void repeaterDropComplete(
-        const lcm::ReceiveBuffer* receiveBuffer,
-        const string& channel,
-        const RepeaterDropComplete* completeIn
-        )
+    // Lcm messages are received on their own thread and handed to the
+    // state machine at the start of each tick.
+    lcmReceiver.start();
+    ControlLoop controlLoop( config.controlLoop.rate );
+    controlLoop.addFileDescriptor( configWatcher.fileDescriptor(), [&]()
     {
-        mStateMachine->updateRepeaterComplete( );
-    }
-
-private:
-    // The state machine to send the lcm messages to.
-    StateMachine* mStateMachine;
-};
-
-// Runs the autonomous navigation of the rover.
-int main()
-{
-    lcm::LCM lcmObject;
-    if( !lcmObject.good() )
+        if( configWatcher.poll( config ) )
+        {
+            roverStateMachine.updateConfig( config );
+            controlLoop.setRate( config.controlLoop.rate );
+        }
+    } );
+    controlLoop.addFileDescriptor( dumpFd, [&]()
     {
-        cerr << "Error: cannot create LCM\n";
-        return 1;
-    }
-
-    StateMachine roverStateMachine( lcmObject );
-    LcmHandlers lcmHandlers( &roverStateMachine );
-
-    lcmObject.subscribe( "/auton", &LcmHandlers::autonState, &lcmHandlers );
-    lcmObject.subscribe( "/course", &LcmHandlers::course, &lcmHandlers );
-    lcmObject.subscribe( "/obstacle", &LcmHandlers::obstacle, &lcmHandlers );
-    lcmObject.subscribe( "/odometry", &LcmHandlers::odometry, &lcmHandlers );
-    lcmObject.subscribe( "/radio", &LcmHandlers::radioSignalStrength, &lcmHandlers );
-    lcmObject.subscribe( "/rr_drop_complete", &LcmHandlers::repeaterDropComplete, &lcmHandlers );
-    lcmObject.subscribe( "/target_list", &LcmHandlers::targetList, &lcmHandlers );
-
-    while( lcmObject.handle() == 0 )
+        signalfd_siginfo info;
+        while( read( dumpFd, &info, sizeof( info ) ) == sizeof( info ) ) {}
+        if( roverStateMachine.flightRecorder().dump( config.flightRecorder.dumpPath.c_str() ) )
+        {
+            cerr << "Dumped the flight recorder to " << config.flightRecorder.dumpPath << "\n";
+        }
+        else
+        {
+            cerr << "Error: cannot dump the flight recorder to " << config.flightRecorder.dumpPath << "\n";
+        }
+    } );
+    return controlLoop.run( [&]()
     {
+        if( !lcmReceiver.good() )
+        {
+            cerr << "Error: lcm stopped receiving\n";
+            controlLoop.stop( -1 );
+            return;
+        }
+        lcmReceiver.deliver( roverStateMachine );
         roverStateMachine.run();
-    }
-    return 0;
+    } );
 } // main()
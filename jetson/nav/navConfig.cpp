@@ -0,0 +1,307 @@
+#include "navConfig.hpp"
+
+namespace
+{
+    // Finds the member key of the given section of the config. Records
+    // an error and returns nullptr if either does not exist.
+    const rapidjson::Value* findMember( const rapidjson::Value& json, const char* section,
+                                        const char* key, string& error )
+    {
+        if( !json.IsObject() || !json.HasMember( section ) || !json[ section ].IsObject() )
+        {
+            error = string( "missing section \"" ) + section + "\"";
+            return nullptr;
+        }
+        const rapidjson::Value& sectionValue = json[ section ];
+        if( !sectionValue.HasMember( key ) )
+        {
+            error = string( "missing value \"" ) + section + "." + key + "\"";
+            return nullptr;
+        }
+        return &sectionValue[ key ];
+    } // findMember()
+
+    // Reads a number from the config. Returns false if it is missing or
+    // is not a number.
+    bool readDouble( const rapidjson::Value& json, const char* section, const char* key,
+                     double& out, string& error )
+    {
+        const rapidjson::Value* value = findMember( json, section, key, error );
+        if( !value )
+        {
+            return false;
+        }
+        if( !value->IsNumber() )
+        {
+            error = string( "\"" ) + section + "." + key + "\" is not a number";
+            return false;
+        }
+        out = value->GetDouble();
+        return true;
+    } // readDouble()
+
+    // Reads an integer from the config. Returns false if it is missing
+    // or is not an integer.
+    bool readInt( const rapidjson::Value& json, const char* section, const char* key,
+                  int& out, string& error )
+    {
+        const rapidjson::Value* value = findMember( json, section, key, error );
+        if( !value )
+        {
+            return false;
+        }
+        if( !value->IsInt() )
+        {
+            error = string( "\"" ) + section + "." + key + "\" is not an integer";
+            return false;
+        }
+        out = value->GetInt();
+        return true;
+    } // readInt()
+
+    // Reads a string from the config. Returns false if it is missing or
+    // is not a string.
+    bool readString( const rapidjson::Value& json, const char* section, const char* key,
+                     string& out, string& error )
+    {
+        const rapidjson::Value* value = findMember( json, section, key, error );
+        if( !value )
+        {
+            return false;
+        }
+        if( !value->IsString() )
+        {
+            error = string( "\"" ) + section + "." + key + "\" is not a string";
+            return false;
+        }
+        out.assign( value->GetString(), value->GetStringLength() );
+        return true;
+    } // readString()
+
+    // Reads the gains of a pid loop from the config.
+    bool readPid( const rapidjson::Value& json, const char* section, PidGains& out, string& error )
+    {
+        return readDouble( json, section, "kP", out.kP, error ) &&
+               readDouble( json, section, "kI", out.kI, error ) &&
+               readDouble( json, section, "kD", out.kD, error ) &&
+               readDouble( json, section, "derivativeFilter", out.derivativeFilter, error );
+    } // readPid()
+
+    // Reads the search order from the config and checks that it is
+    // consistent with numSearches.
+    bool readSearchOrder( const rapidjson::Value& json, NavConfig::Search& out, string& error )
+    {
+        const rapidjson::Value* order = findMember( json, "search", "order", error );
+        if( !order )
+        {
+            return false;
+        }
+        if( !order->IsArray() || order->Empty() )
+        {
+            error = "\"search.order\" is not a non-empty array";
+            return false;
+        }
+        out.order.clear();
+        for( const rapidjson::Value& searchType : order->GetArray() )
+        {
+            if( !searchType.IsInt() )
+            {
+                error = "\"search.order\" contains a non-integer";
+                return false;
+            }
+            out.order.push_back( searchType.GetInt() );
+        }
+        if( !readInt( json, "search", "numSearches", out.numSearches, error ) )
+        {
+            return false;
+        }
+        if( out.numSearches < 1 || out.numSearches > int( out.order.size() ) )
+        {
+            error = "\"search.numSearches\" must be between 1 and the length of \"search.order\"";
+            return false;
+        }
+        return true;
+    } // readSearchOrder()
+} // namespace
+
+// Validates the json config and copies it into config. Returns false
+// and leaves config untouched if a value is missing or has the wrong
+// type, in which case error describes the problem.
+bool parseNavConfig( const rapidjson::Value& json, NavConfig& config, string& error )
+{
+    NavConfig parsed;
+    bool valid =
+        readPid( json, "bearingPid", parsed.bearingPid, error ) &&
+        readPid( json, "distancePid", parsed.distancePid, error ) &&
+
+        readDouble( json, "joystick", "bearingPower", parsed.joystick.bearingPower, error ) &&
+        readDouble( json, "joystick", "drivingPower", parsed.joystick.drivingPower, error ) &&
+        readDouble( json, "joystick", "dampen", parsed.joystick.dampen, error ) &&
+
+        readDouble( json, "navThresholds", "turningBearing", parsed.navThresholds.turningBearing, error ) &&
+        readDouble( json, "navThresholds", "drivingBearing", parsed.navThresholds.drivingBearing, error ) &&
+        readDouble( json, "navThresholds", "waypointDistance", parsed.navThresholds.waypointDistance, error ) &&
+        readDouble( json, "navThresholds", "targetDistance", parsed.navThresholds.targetDistance, error ) &&
+        readDouble( json, "navThresholds", "minTurningEffort", parsed.navThresholds.minTurningEffort, error ) &&
+        readDouble( json, "navThresholds", "gateCenteredAngleDiff", parsed.navThresholds.gateCenteredAngleDiff, error ) &&
+
+        readDouble( json, "roverMeasurements", "width", parsed.roverMeasurements.width, error ) &&
+        readDouble( json, "roverMeasurements", "maxSpeed", parsed.roverMeasurements.maxSpeed, error ) &&
+        readDouble( json, "roverMeasurements", "maxTurnRate", parsed.roverMeasurements.maxTurnRate, error ) &&
+
+        readDouble( json, "computerVision", "visionDistance", parsed.computerVision.visionDistance, error ) &&
+        readDouble( json, "computerVision", "fieldOfViewAngle", parsed.computerVision.fieldOfViewAngle, error ) &&
+        readDouble( json, "computerVision", "fieldOfViewSafeAngle", parsed.computerVision.fieldOfViewSafeAngle, error ) &&
+
+        readString( json, "lcmChannels", "navStatusChannel", parsed.lcmChannels.navStatusChannel, error ) &&
+        readString( json, "lcmChannels", "repeaterDropInitChannel", parsed.lcmChannels.repeaterDropInitChannel, error ) &&
+        readString( json, "lcmChannels", "repeaterDropCompleteChannel", parsed.lcmChannels.repeaterDropCompleteChannel, error ) &&
+        readString( json, "lcmChannels", "joystickChannel", parsed.lcmChannels.joystickChannel, error ) &&
+
+        readDouble( json, "radioRepeaterThresholds", "signalStrengthCutOff", parsed.radioRepeaterThresholds.signalStrengthCutOff, error ) &&
+        readDouble( json, "radioRepeaterThresholds", "lowSignalWaitTime", parsed.radioRepeaterThresholds.lowSignalWaitTime, error ) &&
+
+        readDouble( json, "controlLoop", "rate", parsed.controlLoop.rate, error ) &&
+        readDouble( json, "controlLoop", "navStatusKeepAlive", parsed.controlLoop.navStatusKeepAlive, error ) &&
+
+        readInt( json, "pathFollowing", "enabled", parsed.pathFollowing.enabled, error ) &&
+        readDouble( json, "pathFollowing", "lookahead", parsed.pathFollowing.lookahead, error ) &&
+
+        readInt( json, "obstacleAvoidance", "algorithm", parsed.obstacleAvoidance.algorithm, error ) &&
+        readDouble( json, "obstacleAvoidance", "planningResolution", parsed.obstacleAvoidance.planningResolution, error ) &&
+        readInt( json, "obstacleAvoidance", "planningSize", parsed.obstacleAvoidance.planningSize, error ) &&
+        readDouble( json, "obstacleAvoidance", "clearance", parsed.obstacleAvoidance.clearance, error ) &&
+        readDouble( json, "obstacleAvoidance", "lookahead", parsed.obstacleAvoidance.lookahead, error ) &&
+        readDouble( json, "obstacleAvoidance", "switchMargin", parsed.obstacleAvoidance.switchMargin, error ) &&
+
+        readInt( json, "flightRecorder", "capacity", parsed.flightRecorder.capacity, error ) &&
+        readString( json, "flightRecorder", "dumpPath", parsed.flightRecorder.dumpPath, error ) &&
+        readString( json, "flightRecorder", "crashPath", parsed.flightRecorder.crashPath, error ) &&
+
+        readSearchOrder( json, parsed.search, error ) &&
+        readDouble( json, "search", "bailThresh", parsed.search.bailThresh, error ) &&
+        readDouble( json, "search", "searchWaitStepSize", parsed.search.searchWaitStepSize, error ) &&
+        readDouble( json, "search", "searchWaitTime", parsed.search.searchWaitTime, error ) &&
+        readInt( json, "search", "continuousSpin", parsed.search.continuousSpin, error ) &&
+        readDouble( json, "search", "framesPerBearing", parsed.search.framesPerBearing, error ) &&
+
+        readDouble( json, "costmap", "resolution", parsed.costmap.resolution, error ) &&
+        readInt( json, "costmap", "size", parsed.costmap.size, error ) &&
+        readDouble( json, "costmap", "decayTime", parsed.costmap.decayTime, error ) &&
+        readDouble( json, "costmap", "hitIncrement", parsed.costmap.hitIncrement, error ) &&
+        readDouble( json, "costmap", "missDecrement", parsed.costmap.missDecrement, error ) &&
+        readDouble( json, "costmap", "occupiedThreshold", parsed.costmap.occupiedThreshold, error ) &&
+        readDouble( json, "costmap", "clearDepth", parsed.costmap.clearDepth, error ) &&
+
+        readInt( json, "targetTracker", "enabled", parsed.targetTracker.enabled, error ) &&
+        readDouble( json, "targetTracker", "rangeNoise", parsed.targetTracker.rangeNoise, error ) &&
+        readDouble( json, "targetTracker", "bearingNoise", parsed.targetTracker.bearingNoise, error ) &&
+        readDouble( json, "targetTracker", "positionNoise", parsed.targetTracker.positionNoise, error ) &&
+        readDouble( json, "targetTracker", "processNoise", parsed.targetTracker.processNoise, error ) &&
+        readDouble( json, "targetTracker", "gate", parsed.targetTracker.gate, error ) &&
+        readInt( json, "targetTracker", "maxRejections", parsed.targetTracker.maxRejections, error ) &&
+        readDouble( json, "targetTracker", "coastTime", parsed.targetTracker.coastTime, error ) &&
+
+        readDouble( json, "probabilityMap", "resolution", parsed.probabilityMap.resolution, error ) &&
+        readDouble( json, "probabilityMap", "spread", parsed.probabilityMap.spread, error ) &&
+        readDouble( json, "probabilityMap", "detectionProbability", parsed.probabilityMap.detectionProbability, error ) &&
+        readDouble( json, "probabilityMap", "giveUp", parsed.probabilityMap.giveUp, error ) &&
+
+        readInt( json, "courseOptimizer", "enabled", parsed.courseOptimizer.enabled, error ) &&
+        readDouble( json, "courseOptimizer", "budget", parsed.courseOptimizer.budget, error );
+
+    if( valid && ( parsed.bearingPid.derivativeFilter < 0 || parsed.distancePid.derivativeFilter < 0 ) )
+    {
+        error = "pid \"derivativeFilter\" must not be negative";
+        valid = false;
+    }
+    if( valid && parsed.controlLoop.rate <= 0 )
+    {
+        error = "\"controlLoop.rate\" must be positive";
+        valid = false;
+    }
+    if( valid && parsed.controlLoop.navStatusKeepAlive <= 0 )
+    {
+        error = "\"controlLoop.navStatusKeepAlive\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.roverMeasurements.maxSpeed <= 0 || parsed.roverMeasurements.maxTurnRate <= 0 ) )
+    {
+        error = "\"roverMeasurements.maxSpeed\" and \"roverMeasurements.maxTurnRate\" must be positive";
+        valid = false;
+    }
+    if( valid && parsed.pathFollowing.lookahead <= 0 )
+    {
+        error = "\"pathFollowing.lookahead\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.obstacleAvoidance.algorithm < 0 || parsed.obstacleAvoidance.algorithm > 1 ) )
+    {
+        error = "\"obstacleAvoidance.algorithm\" must be 0 (simple) or 1 (D* Lite)";
+        valid = false;
+    }
+    if( valid && ( parsed.obstacleAvoidance.planningResolution <= 0 ||
+                   parsed.obstacleAvoidance.planningSize < 4 || parsed.obstacleAvoidance.planningSize > 1024 ) )
+    {
+        error = "\"obstacleAvoidance\" planning grid must have a positive resolution and 4 to 1024 cells per side";
+        valid = false;
+    }
+    if( valid && ( parsed.flightRecorder.capacity < 1 || parsed.flightRecorder.capacity > ( 1 << 20 ) ) )
+    {
+        error = "\"flightRecorder.capacity\" must be 1 to 1048576";
+        valid = false;
+    }
+    if( valid && parsed.search.framesPerBearing <= 0 )
+    {
+        error = "\"search.framesPerBearing\" must be positive";
+        valid = false;
+    }
+    if( valid && parsed.costmap.resolution <= 0 )
+    {
+        error = "\"costmap.resolution\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.costmap.size < 2 || parsed.costmap.size > 4096 ||
+                   ( parsed.costmap.size & ( parsed.costmap.size - 1 ) ) != 0 ) )
+    {
+        error = "\"costmap.size\" must be a power of two no larger than 4096";
+        valid = false;
+    }
+    if( valid && parsed.costmap.decayTime <= 0 )
+    {
+        error = "\"costmap.decayTime\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.targetTracker.rangeNoise <= 0 || parsed.targetTracker.bearingNoise <= 0 ||
+                   parsed.targetTracker.positionNoise < 0 || parsed.targetTracker.processNoise < 0 ) )
+    {
+        error = "\"targetTracker\" range and bearing noise must be positive and the others not negative";
+        valid = false;
+    }
+    if( valid && ( parsed.targetTracker.gate <= 0 || parsed.targetTracker.maxRejections < 1 ) )
+    {
+        error = "\"targetTracker.gate\" and \"targetTracker.maxRejections\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.probabilityMap.resolution <= 0 || parsed.probabilityMap.spread <= 0 ) )
+    {
+        error = "\"probabilityMap.resolution\" and \"probabilityMap.spread\" must be positive";
+        valid = false;
+    }
+    if( valid && ( parsed.probabilityMap.detectionProbability <= 0 || parsed.probabilityMap.detectionProbability > 1 ||
+                   parsed.probabilityMap.giveUp <= 0 || parsed.probabilityMap.giveUp >= 1 ) )
+    {
+        error = "\"probabilityMap.detectionProbability\" must be in (0, 1] and \"probabilityMap.giveUp\" in (0, 1)";
+        valid = false;
+    }
+    if( valid && parsed.courseOptimizer.budget < 0 )
+    {
+        error = "\"courseOptimizer.budget\" must not be negative";
+        valid = false;
+    }
+    if( valid )
+    {
+        config = parsed;
+    }
+    return valid;
+} // parseNavConfig()
@@ -0,0 +1,211 @@
+#ifndef NAV_CONFIG_HPP
+#define NAV_CONFIG_HPP
+
+#include <string>
+#include <vector>
+#include "rapidjson/document.h"
+
+using namespace std;
+
+// Gains of a single pid loop, per second, and the time constant of the
+// low-pass filter on its derivative in seconds.
+struct PidGains
+{
+    double kP;
+    double kI;
+    double kD;
+    double derivativeFilter;
+};
+
+// Typed snapshot of config_nav/config.json. The json document is
+// validated and copied into this struct once so that the control path
+// reads plain members instead of doing string-keyed lookups. Default
+// values match the checked in config.json.
+struct NavConfig
+{
+    PidGains bearingPid = { 0.1, 0.5, 0.00011, 0.05 };
+
+    PidGains distancePid = { 0.2, 0, 0, 0.05 };
+
+    struct Joystick
+    {
+        double bearingPower = 0.5;
+        double drivingPower = 1.0;
+        double dampen = -1.0;
+    } joystick;
+
+    struct NavThresholds
+    {
+        double turningBearing = 20;
+        double drivingBearing = 50;
+        double waypointDistance = 2.0;
+        double targetDistance = 1.0;
+        double minTurningEffort = 0.25;
+        double gateCenteredAngleDiff = 20;
+    } navThresholds;
+
+    struct RoverMeasurements
+    {
+        double width = 1.5;
+        // Speed in m/s and turn rate in degrees/s at full joystick
+        // effort, after the joystick powers are applied.
+        double maxSpeed = 2;
+        double maxTurnRate = 15;
+    } roverMeasurements;
+
+    struct ComputerVision
+    {
+        double visionDistance = 3.0;
+        double fieldOfViewAngle = 110;
+        double fieldOfViewSafeAngle = 100;
+    } computerVision;
+
+    struct LcmChannels
+    {
+        string navStatusChannel = "/nav_status";
+        string repeaterDropInitChannel = "/rr_drop_init";
+        string repeaterDropCompleteChannel = "/rr_drop_complete";
+        string joystickChannel = "/autonomous";
+    } lcmChannels;
+
+    struct RadioRepeaterThresholds
+    {
+        double signalStrengthCutOff = 30.0;
+        double lowSignalWaitTime = 3;
+    } radioRepeaterThresholds;
+
+    struct ControlLoop
+    {
+        // Rate at which the state machine runs, in Hz.
+        double rate = 50;
+        // Seconds between nav status messages while the state does not
+        // change.
+        double navStatusKeepAlive = 1;
+    } controlLoop;
+
+    struct PathFollowing
+    {
+        // Whether Drive follows the course with pure pursuit instead of
+        // stopping to turn in place whenever it is off course. Off until
+        // roverMeasurements has been measured on the rover.
+        int enabled = 0;
+        // Meters along the course ahead of the rover it steers towards.
+        double lookahead = 6;
+    } pathFollowing;
+
+    struct ObstacleAvoidance
+    {
+        // ObstacleAvoidanceAlgorithm to use: 0 = simple, 1 = D* Lite.
+        int algorithm = 0;
+        // Side of a planning cell in meters and cells per side of the
+        // planning grid.
+        double planningResolution = 0.5;
+        int planningSize = 64;
+        // Meters kept between the side of the rover and obstacles.
+        double clearance = 0.25;
+        // Farthest distance in meters along the path the rover steers to,
+        // and meters a new path must save before the rover changes course.
+        double lookahead = 4;
+        double switchMargin = 1;
+    } obstacleAvoidance;
+
+    struct FlightRecorder
+    {
+        // Iterations of the state machine kept, rounded up to a power of
+        // two. At 50 Hz the default keeps the last five minutes.
+        int capacity = 16384;
+        // Lcm event logs written on request (SIGUSR1) and on a crash.
+        string dumpPath = "/tmp/nav_flight.lcmlog";
+        string crashPath = "/tmp/nav_crash.lcmlog";
+    } flightRecorder;
+
+    struct Search
+    {
+        // Searches tried in turn at a search waypoint: 0 spiral out,
+        // 1 lawn mower, 2 spiral in, 3 probability map.
+        vector<int> order = { 0, 1 };
+        int numSearches = 2;
+        double bailThresh = 10.0;
+        double searchWaitStepSize = 90.0;
+        double searchWaitTime = 1.0;
+        // Whether search and gate search spin turns without stopping,
+        // at a rate perception keeps up with, instead of waiting for
+        // searchWaitTime every searchWaitStepSize degrees. Off until
+        // roverMeasurements.maxTurnRate has been measured on the rover.
+        int continuousSpin = 0;
+        // Frames every bearing stays in view for during a continuous
+        // spin.
+        double framesPerBearing = 3;
+    } search;
+
+    struct Costmap
+    {
+        // Side of a cell in meters and cells per side of the window
+        // around the rover, which must be a power of two.
+        double resolution = 0.25;
+        int size = 128;
+        // Seconds for a fully occupied cell to decay to free.
+        double decayTime = 20;
+        // Occupancy added by a detection and removed by a clear view.
+        double hitIncrement = 0.35;
+        double missDecrement = 0.2;
+        // Occupancy at which a cell blocks the rover.
+        double occupiedThreshold = 0.5;
+        // Depth in meters seen clear when no obstacle is reported.
+        double clearDepth = 5;
+    } costmap;
+
+    struct TargetTracker
+    {
+        // Whether search and gate search steer by the tracked
+        // estimates of the targets, which coast through detection
+        // dropouts and refine with every sighting, instead of only the
+        // latest detection.
+        int enabled = 1;
+        // Standard deviations of a detection's range in meters and
+        // bearing in degrees, and of the rover's position in meters.
+        double rangeNoise = 0.3;
+        double bearingNoise = 2;
+        double positionNoise = 0.3;
+        // Variance in square meters a track gains per second, covering
+        // odometry drift while the target is not seen.
+        double processNoise = 0.05;
+        // Squared Mahalanobis distance beyond which a detection is not
+        // fused into its track, and the number of such detections in a
+        // row after which the track restarts from the detection.
+        double gate = 9.21;
+        int maxRejections = 3;
+        // Seconds search follows a track without a detection. Tracks
+        // are kept as landmarks for as long as there is room.
+        double coastTime = 3;
+    } targetTracker;
+
+    struct ProbabilityMap
+    {
+        // Side of a cell in meters. The map covers search.bailThresh
+        // around the search waypoint.
+        double resolution = 0.5;
+        // Standard deviation in meters of how far from the search
+        // waypoint the target is.
+        double spread = 5;
+        // Probability that perception detects a target in view in one
+        // frame.
+        double detectionProbability = 0.5;
+        // Probability of the target being left to find at which the
+        // search gives up.
+        double giveUp = 0.01;
+    } probabilityMap;
+
+    struct CourseOptimizer
+    {
+        // Whether a new course is reordered to shorten the drive from
+        // the rover through its waypoints. Gates keep their place.
+        int enabled = 0;
+        // Seconds spent improving the order of a course.
+        double budget = 0.01;
+    } courseOptimizer;
+};
+
+bool parseNavConfig( const rapidjson::Value& json, NavConfig& config, string& error );
+
+#endif // NAV_CONFIG_HPP
@@ -0,0 +1,187 @@
+#include "navConfigWatcher.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+    // A private, writable mapping of a file followed by at least one
+    // zero byte so that it can be parsed in place as a c string.
+    class MappedFile
+    {
+    public:
+        MappedFile( const string& path )
+            : mData( nullptr )
+            , mLength( 0 )
+        {
+            int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+            if( fd < 0 )
+            {
+                return;
+            }
+            struct stat fileStat;
+            if( fstat( fd, &fileStat ) == 0 && fileStat.st_size > 0 )
+            {
+                // Reserve an anonymous (zeroed) region one byte longer
+                // than the file and map the file over the start of it.
+                size_t fileSize = fileStat.st_size;
+                mLength = fileSize + 1;
+                void* region = mmap( nullptr, mLength, PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+                if( region != MAP_FAILED )
+                {
+                    if( mmap( region, fileSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_FIXED, fd, 0 ) != MAP_FAILED )
+                    {
+                        mData = static_cast<char*>( region );
+                    }
+                    else
+                    {
+                        munmap( region, mLength );
+                    }
+                }
+            }
+            close( fd );
+        }
+
+        ~MappedFile()
+        {
+            if( mData )
+            {
+                munmap( mData, mLength );
+            }
+        }
+
+        char* data() const
+        {
+            return mData;
+        }
+
+    private:
+        char* mData;
+        size_t mLength;
+    };
+} // namespace
+
+// Constructs a NavConfigWatcher for the configuration file at
+// configPath. The file's directory is watched rather than the file
+// itself so that editors that save by renaming are also noticed.
+NavConfigWatcher::NavConfigWatcher( const string& configPath )
+    : mConfigPath( configPath )
+    , mInotifyFd( -1 )
+{
+    size_t slash = mConfigPath.find_last_of( '/' );
+    string directory = slash == string::npos ? "." : mConfigPath.substr( 0, slash );
+    mConfigName = slash == string::npos ? mConfigPath : mConfigPath.substr( slash + 1 );
+
+    mInotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if( mInotifyFd >= 0 &&
+        inotify_add_watch( mInotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO ) < 0 )
+    {
+        close( mInotifyFd );
+        mInotifyFd = -1;
+    }
+    if( mInotifyFd < 0 )
+    {
+        cerr << "Warning: cannot watch " << mConfigPath << " for changes\n";
+    }
+} // NavConfigWatcher()
+
+// Destructs the NavConfigWatcher object. Stops watching the file.
+NavConfigWatcher::~NavConfigWatcher()
+{
+    if( mInotifyFd >= 0 )
+    {
+        close( mInotifyFd );
+    }
+} // ~NavConfigWatcher()
+
+// Maps, parses and validates the configuration file into config.
+// Returns false and leaves config untouched if the file cannot be read
+// or is invalid, in which case error describes the problem.
+bool NavConfigWatcher::load( NavConfig& config, string& error ) const
+{
+    MappedFile file( mConfigPath );
+    if( !file.data() )
+    {
+        error = "cannot read file";
+        return false;
+    }
+    rapidjson::Document document;
+    document.ParseInsitu( file.data() );
+    if( document.HasParseError() )
+    {
+        error = "not valid json";
+        return false;
+    }
+    return parseNavConfig( document, config, error );
+} // load()
+
+// Checks, without blocking, whether the configuration file has been
+// written since the last call. If it has and the new file is valid, it
+// is loaded into config and true is returned. An invalid file is
+// reported and ignored so the running configuration stays in effect.
+bool NavConfigWatcher::poll( NavConfig& config )
+{
+    if( mInotifyFd < 0 )
+    {
+        return false;
+    }
+    bool changed = false;
+    alignas( inotify_event ) char eventBuffer[ 4096 ];
+    long length;
+    while( ( length = read( mInotifyFd, eventBuffer, sizeof( eventBuffer ) ) ) > 0 )
+    {
+        changed |= isConfigEvent( eventBuffer, length );
+    }
+    if( !changed )
+    {
+        return false;
+    }
+
+    auto start = chrono::steady_clock::now();
+    string error;
+    if( !load( config, error ) )
+    {
+        cerr << "Ignoring invalid nav config " << mConfigPath << ": " << error << "\n";
+        return false;
+    }
+    auto elapsed = chrono::duration_cast<chrono::microseconds>( chrono::steady_clock::now() - start );
+    cerr << "Reloaded nav config in " << elapsed.count() << " us\n";
+    return true;
+} // poll()
+
+// Gets the inotify file descriptor, which becomes readable when the
+// configuration file's directory changes. -1 if watching is
+// unavailable.
+int NavConfigWatcher::fileDescriptor() const
+{
+    return mInotifyFd;
+} // fileDescriptor()
+
+// Gets the path to the configuration file.
+const string& NavConfigWatcher::path() const
+{
+    return mConfigPath;
+} // path()
+
+// Returns true if any of the inotify events in eventBuffer refer to the
+// configuration file.
+bool NavConfigWatcher::isConfigEvent( const char* eventBuffer, long length ) const
+{
+    for( const char* ptr = eventBuffer; ptr < eventBuffer + length; )
+    {
+        const inotify_event* event = reinterpret_cast<const inotify_event*>( ptr );
+        if( event->len > 0 && mConfigName == event->name )
+        {
+            return true;
+        }
+        ptr += sizeof( inotify_event ) + event->len;
+    }
+    return false;
+} // isConfigEvent()
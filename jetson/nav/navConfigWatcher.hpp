@@ -0,0 +1,41 @@
+#ifndef NAV_CONFIG_WATCHER_HPP
+#define NAV_CONFIG_WATCHER_HPP
+
+#include <string>
+#include "navConfig.hpp"
+
+using namespace std;
+
+// This class loads the nav configuration file and watches it for
+// changes so that the configuration can be reloaded while nav is
+// running. The file is memory mapped and parsed in place.
+class NavConfigWatcher
+{
+public:
+    NavConfigWatcher( const string& configPath );
+
+    ~NavConfigWatcher();
+
+    bool load( NavConfig& config, string& error ) const;
+
+    bool poll( NavConfig& config );
+
+    int fileDescriptor() const;
+
+    const string& path() const;
+
+private:
+    bool isConfigEvent( const char* eventBuffer, long length ) const;
+
+    // Path to the configuration file.
+    string mConfigPath;
+
+    // Name of the configuration file within its directory.
+    string mConfigName;
+
+    // Non-blocking inotify descriptor watching the configuration
+    // file's directory, or -1 if watching is unavailable.
+    int mInotifyFd;
+};
+
+#endif // NAV_CONFIG_WATCHER_HPP
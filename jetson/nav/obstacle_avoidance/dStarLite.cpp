@@ -0,0 +1,378 @@
+#include "dStarLite.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+    const float INFINITE_COST = numeric_limits<float>::infinity();
+
+    const float SQRT_2 = 1.41421356f;
+} // namespace
+
+// Returns true if this key sorts before other.
+bool DStarLite::Key::operator<( const Key& other ) const
+{
+    return primary < other.primary ||
+           ( primary == other.primary && secondary < other.secondary );
+} // operator<()
+
+// Orders queue entries for a min-heap.
+bool DStarLite::QueueEntry::operator>( const QueueEntry& other ) const
+{
+    return other.key < key;
+} // operator>()
+
+// Constructs a planner over a size by size grid of cells, each
+// resolution meters on a side.
+DStarLite::DStarLite( double resolution, int size )
+    : mResolution( resolution )
+    , mSize( size )
+    , mOrigin( { 0, 0 } )
+    , mStart( 0 )
+    , mGoal( 0 )
+    , mGoalPoint( { 0, 0 } )
+    , mLastStart( 0 )
+    , mKeyModifier( 0 )
+    , mCostToGoal( size * size, INFINITE_COST )
+    , mLookahead( size * size, INFINITE_COST )
+    , mBlocked( size * size, 0 )
+    , mQueued( size * size, 0 )
+    , mKeys( size * size )
+    , mExpansions( 0 )
+{
+    mQueue.reserve( 4 * size * size );
+} // DStarLite()
+
+// Places the grid so that it covers start and goal and forgets the
+// previous plan and obstacles. A goal too far away to fit in the grid
+// is moved towards start until it fits.
+void DStarLite::initialize( const LocalPoint& start, const LocalPoint& goal )
+{
+    const double maxDistance = ( mSize - 2 ) * mResolution;
+    const double distance = planarDistance( start, goal );
+    mGoalPoint = goal;
+    if( distance > maxDistance )
+    {
+        const double scale = maxDistance / distance;
+        mGoalPoint = { start.x + ( goal.x - start.x ) * scale,
+                       start.y + ( goal.y - start.y ) * scale };
+    }
+    const double halfSpan = mSize * mResolution / 2;
+    mOrigin = { ( start.x + mGoalPoint.x ) / 2 - halfSpan,
+                ( start.y + mGoalPoint.y ) / 2 - halfSpan };
+
+    fill( mCostToGoal.begin(), mCostToGoal.end(), INFINITE_COST );
+    fill( mLookahead.begin(), mLookahead.end(), INFINITE_COST );
+    fill( mBlocked.begin(), mBlocked.end(), 0 );
+    fill( mQueued.begin(), mQueued.end(), 0 );
+    mQueue.clear();
+
+    mStart = cellIndex( start );
+    mLastStart = mStart;
+    mGoal = cellIndex( mGoalPoint );
+    mKeyModifier = 0;
+    mLookahead[ mGoal ] = 0;
+    push( mGoal, calculateKey( mGoal ) );
+} // initialize()
+
+// Returns true if point lies on the grid.
+bool DStarLite::contains( const LocalPoint& point ) const
+{
+    const double span = mSize * mResolution;
+    return point.x >= mOrigin.x && point.x < mOrigin.x + span &&
+           point.y >= mOrigin.y && point.y < mOrigin.y + span;
+} // contains()
+
+// Marks the cell containing point as blocked or free. point must lie on
+// the grid.
+void DStarLite::setBlocked( const LocalPoint& point, bool blocked )
+{
+    setCellBlocked( cellIndex( point ), blocked );
+} // setBlocked()
+
+// Blocks every cell whose center is within inflation of an occupied
+// costmap cell and frees the others, except that the start and goal are
+// always free. Returns the number of cells that changed.
+int DStarLite::updateObstacles( const Costmap& costmap, double inflation, double now,
+                                const NavConfig::Costmap& config )
+{
+    int changed = 0;
+    for( int cell = 0; cell < mSize * mSize; ++cell )
+    {
+        const LocalPoint center = cellCenter( cell );
+        const bool blocked = cell != mStart && cell != mGoal &&
+                             !costmap.isCorridorClear( center, center, inflation, now, config );
+        if( blocked != bool( mBlocked[ cell ] ) )
+        {
+            setCellBlocked( cell, blocked );
+            ++changed;
+        }
+    }
+    return changed;
+} // updateObstacles()
+
+// Moves the start of the path to the cell containing start, which must
+// lie on the grid.
+void DStarLite::updateStart( const LocalPoint& start )
+{
+    const int cell = cellIndex( start );
+    if( cell == mStart )
+    {
+        return;
+    }
+    mStart = cell;
+    mKeyModifier += heuristic( mLastStart, mStart );
+    mLastStart = mStart;
+    if( mBlocked[ mStart ] )
+    {
+        setCellBlocked( mStart, false );
+    }
+} // updateStart()
+
+// Repairs the plan after the start moved or cells changed. Returns true
+// if there is a path from the start to the goal.
+bool DStarLite::plan()
+{
+    mExpansions = 0;
+    const int maxExpansions = 8 * mSize * mSize;
+    Key top;
+    while( topKey( top ) &&
+           ( top < calculateKey( mStart ) || mLookahead[ mStart ] != mCostToGoal[ mStart ] ) &&
+           mExpansions < maxExpansions )
+    {
+        ++mExpansions;
+        const int cell = mQueue.front().cell;
+        pop_heap( mQueue.begin(), mQueue.end(), greater<QueueEntry>() );
+        mQueue.pop_back();
+        mQueued[ cell ] = 0;
+
+        const Key key = calculateKey( cell );
+        if( top < key )
+        {
+            push( cell, key );
+        }
+        else if( mCostToGoal[ cell ] > mLookahead[ cell ] )
+        {
+            mCostToGoal[ cell ] = mLookahead[ cell ];
+            forEachNeighbor( cell, [this]( int neighbor ) { updateVertex( neighbor ); } );
+        }
+        else
+        {
+            mCostToGoal[ cell ] = INFINITE_COST;
+            updateVertex( cell );
+            forEachNeighbor( cell, [this]( int neighbor ) { updateVertex( neighbor ); } );
+        }
+    }
+    return mCostToGoal[ mStart ] < INFINITE_COST;
+} // plan()
+
+// Writes the centers of the cells on the planned path, from the start
+// to the goal, to points. points is empty if there is no path.
+void DStarLite::path( vector<LocalPoint>& points ) const
+{
+    points.clear();
+    int cell = mStart;
+    if( mCostToGoal[ cell ] == INFINITE_COST )
+    {
+        return;
+    }
+    for( int step = 0; step < mSize * mSize; ++step )
+    {
+        points.push_back( cellCenter( cell ) );
+        if( cell == mGoal )
+        {
+            return;
+        }
+        int next = -1;
+        float nextCost = INFINITE_COST;
+        forEachNeighbor( cell, [&]( int neighbor )
+        {
+            const float neighborCost = cost( cell, neighbor ) + mCostToGoal[ neighbor ];
+            if( neighborCost < nextCost )
+            {
+                next = neighbor;
+                nextCost = neighborCost;
+            }
+        } );
+        if( next < 0 )
+        {
+            return;
+        }
+        cell = next;
+    }
+} // path()
+
+// Gets the length in meters of the planned path, which is infinite if
+// there is none.
+double DStarLite::pathLength() const
+{
+    return mCostToGoal[ mStart ];
+} // pathLength()
+
+// Gets the planned distance in meters from the cell containing point,
+// which must lie on the grid, to the goal.
+double DStarLite::costToGoal( const LocalPoint& point ) const
+{
+    return mCostToGoal[ cellIndex( point ) ];
+} // costToGoal()
+
+// Gets the goal the path leads to, after it was moved onto the grid.
+const LocalPoint& DStarLite::goal() const
+{
+    return mGoalPoint;
+} // goal()
+
+// Gets the number of cells expanded by the last call to plan.
+int DStarLite::expansions() const
+{
+    return mExpansions;
+} // expansions()
+
+// Gets the index of the cell containing point, clamped to the grid.
+int DStarLite::cellIndex( const LocalPoint& point ) const
+{
+    const int x = min( mSize - 1, max( 0, int( floor( ( point.x - mOrigin.x ) / mResolution ) ) ) );
+    const int y = min( mSize - 1, max( 0, int( floor( ( point.y - mOrigin.y ) / mResolution ) ) ) );
+    return y * mSize + x;
+} // cellIndex()
+
+// Gets the center of a cell on the local plane.
+LocalPoint DStarLite::cellCenter( int cell ) const
+{
+    return { mOrigin.x + ( cell % mSize + 0.5 ) * mResolution,
+             mOrigin.y + ( cell / mSize + 0.5 ) * mResolution };
+} // cellCenter()
+
+// Gets the length of the shortest unobstructed 8-connected path between
+// two cells, which never overestimates the planned distance.
+float DStarLite::heuristic( int from, int to ) const
+{
+    const int dx = abs( from % mSize - to % mSize );
+    const int dy = abs( from / mSize - to / mSize );
+    return float( mResolution ) * ( max( dx, dy ) + ( SQRT_2 - 1 ) * min( dx, dy ) );
+} // heuristic()
+
+// Gets the cost of moving between two neighboring cells. Moves into or
+// out of a blocked cell, and diagonal moves that cut the corner of a
+// blocked cell, are infinitely expensive.
+float DStarLite::cost( int from, int to ) const
+{
+    if( mBlocked[ from ] || mBlocked[ to ] )
+    {
+        return INFINITE_COST;
+    }
+    const int dx = to % mSize - from % mSize;
+    const int dy = to / mSize - from / mSize;
+    if( dx == 0 || dy == 0 )
+    {
+        return float( mResolution );
+    }
+    if( mBlocked[ from + dx ] || mBlocked[ from + dy * mSize ] )
+    {
+        return INFINITE_COST;
+    }
+    return float( mResolution ) * SQRT_2;
+} // cost()
+
+// Gets the priority of a cell in the queue.
+DStarLite::Key DStarLite::calculateKey( int cell ) const
+{
+    const float best = min( mCostToGoal[ cell ], mLookahead[ cell ] );
+    return { best + heuristic( mStart, cell ) + mKeyModifier, best };
+} // calculateKey()
+
+// Recomputes the one-step lookahead of a cell from its neighbors and
+// queues the cell if it is inconsistent.
+void DStarLite::updateVertex( int cell )
+{
+    if( cell != mGoal )
+    {
+        float lookahead = INFINITE_COST;
+        forEachNeighbor( cell, [&]( int neighbor )
+        {
+            lookahead = min( lookahead, cost( cell, neighbor ) + mCostToGoal[ neighbor ] );
+        } );
+        mLookahead[ cell ] = lookahead;
+    }
+    mQueued[ cell ] = 0;
+    if( mCostToGoal[ cell ] != mLookahead[ cell ] )
+    {
+        push( cell, calculateKey( cell ) );
+    }
+} // updateVertex()
+
+// Blocks or frees a cell and updates the cells whose edges changed.
+void DStarLite::setCellBlocked( int cell, bool blocked )
+{
+    mBlocked[ cell ] = blocked;
+    updateVertex( cell );
+    forEachNeighbor( cell, [this]( int neighbor ) { updateVertex( neighbor ); } );
+} // setCellBlocked()
+
+// Queues a cell with the given key. Entries left behind by earlier keys
+// are dropped when the queue reaches its reserved capacity, so the
+// queue never allocates.
+void DStarLite::push( int cell, const Key& key )
+{
+    if( mQueue.size() == mQueue.capacity() )
+    {
+        mQueue.clear();
+        for( int queued = 0; queued < mSize * mSize; ++queued )
+        {
+            if( mQueued[ queued ] )
+            {
+                mQueue.push_back( { mKeys[ queued ], queued } );
+            }
+        }
+        make_heap( mQueue.begin(), mQueue.end(), greater<QueueEntry>() );
+    }
+    mQueued[ cell ] = 1;
+    mKeys[ cell ] = key;
+    mQueue.push_back( { key, cell } );
+    push_heap( mQueue.begin(), mQueue.end(), greater<QueueEntry>() );
+} // push()
+
+// Gets the smallest key in the queue, discarding stale entries. Returns
+// false if the queue is empty.
+bool DStarLite::topKey( Key& key )
+{
+    while( !mQueue.empty() )
+    {
+        const QueueEntry& top = mQueue.front();
+        if( mQueued[ top.cell ] &&
+            !( top.key < mKeys[ top.cell ] ) && !( mKeys[ top.cell ] < top.key ) )
+        {
+            key = top.key;
+            return true;
+        }
+        pop_heap( mQueue.begin(), mQueue.end(), greater<QueueEntry>() );
+        mQueue.pop_back();
+    }
+    return false;
+} // topKey()
+
+// Calls func with each of the up to eight cells next to cell.
+template <typename Function>
+void DStarLite::forEachNeighbor( int cell, Function func ) const
+{
+    const int x = cell % mSize;
+    const int y = cell / mSize;
+    for( int dy = -1; dy <= 1; ++dy )
+    {
+        if( y + dy < 0 || y + dy >= mSize )
+        {
+            continue;
+        }
+        for( int dx = -1; dx <= 1; ++dx )
+        {
+            if( ( dx == 0 && dy == 0 ) || x + dx < 0 || x + dx >= mSize )
+            {
+                continue;
+            }
+            func( cell + dy * mSize + dx );
+        }
+    }
+} // forEachNeighbor()
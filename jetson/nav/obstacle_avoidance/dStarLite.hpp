@@ -0,0 +1,132 @@
+#ifndef D_STAR_LITE_HPP
+#define D_STAR_LITE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "costmap.hpp"
+#include "localProjection.hpp"
+
+using namespace std;
+
+// This class plans the shortest 8-connected path across a square grid
+// on the local plane with D* Lite (Koenig and Likhachev, 2002). The
+// search runs backwards from the goal, so when the rover moves or cells
+// become blocked or free only the part of the search they affect is
+// repaired instead of planning again from scratch. All storage is
+// allocated when the planner is constructed.
+class DStarLite
+{
+public:
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    DStarLite( double resolution, int size );
+
+    void initialize( const LocalPoint& start, const LocalPoint& goal );
+
+    bool contains( const LocalPoint& point ) const;
+
+    void setBlocked( const LocalPoint& point, bool blocked );
+
+    int updateObstacles( const Costmap& costmap, double inflation, double now,
+                         const NavConfig::Costmap& config );
+
+    void updateStart( const LocalPoint& start );
+
+    bool plan();
+
+    void path( vector<LocalPoint>& points ) const;
+
+    double pathLength() const;
+
+    double costToGoal( const LocalPoint& point ) const;
+
+    const LocalPoint& goal() const;
+
+    int expansions() const;
+
+private:
+    /*************************************************************************/
+    /* Private Types */
+    /*************************************************************************/
+    struct Key
+    {
+        float primary;
+        float secondary;
+
+        bool operator<( const Key& other ) const;
+    };
+
+    struct QueueEntry
+    {
+        Key key;
+        int cell;
+
+        bool operator>( const QueueEntry& other ) const;
+    };
+
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    int cellIndex( const LocalPoint& point ) const;
+
+    LocalPoint cellCenter( int cell ) const;
+
+    float heuristic( int from, int to ) const;
+
+    float cost( int from, int to ) const;
+
+    Key calculateKey( int cell ) const;
+
+    void updateVertex( int cell );
+
+    void setCellBlocked( int cell, bool blocked );
+
+    void push( int cell, const Key& key );
+
+    bool topKey( Key& key );
+
+    template <typename Function>
+    void forEachNeighbor( int cell, Function func ) const;
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // Side of a cell in meters and cells per side of the grid.
+    double mResolution;
+    int mSize;
+
+    // Lower left corner of the grid on the local plane.
+    LocalPoint mOrigin;
+
+    // Cells the path starts from and leads to, and the goal the caller
+    // asked for, which may lie outside the grid.
+    int mStart;
+    int mGoal;
+    LocalPoint mGoalPoint;
+
+    // Start cell when the key modifier was last updated, and the key
+    // modifier, which keeps old keys valid as the start moves.
+    int mLastStart;
+    float mKeyModifier;
+
+    // Cost-to-goal estimate and one-step lookahead of every cell.
+    vector<float> mCostToGoal;
+    vector<float> mLookahead;
+
+    // Whether each cell is blocked by an obstacle.
+    vector<uint8_t> mBlocked;
+
+    // Whether each cell is in the priority queue and its current key.
+    // Queue entries whose key no longer matches are skipped.
+    vector<uint8_t> mQueued;
+    vector<Key> mKeys;
+
+    // Binary min-heap of queue entries.
+    vector<QueueEntry> mQueue;
+
+    // Cells expanded by the last call to plan.
+    int mExpansions;
+};
+
+#endif // D_STAR_LITE_HPP
@@ -0,0 +1,165 @@
+#include "dStarLiteAvoidance.hpp"
+
+#include "stateMachine.hpp"
+#include "utilities.hpp"
+
+#include <cmath>
+
+// Constructs a DStarLiteAvoidance object with the input roverStateMachine.
+// The planning grid is sized from roverConfig and allocated up front.
+DStarLiteAvoidance::DStarLiteAvoidance( StateMachine* roverStateMachine, const NavConfig& roverConfig )
+    : ObstacleAvoidanceStateMachine( roverStateMachine )
+    , mPlanner( roverConfig.obstacleAvoidance.planningResolution,
+                roverConfig.obstacleAvoidance.planningSize )
+    , mPlanning( false )
+    , mSteeringPoint( { 0, 0 } )
+    , mHasSteeringPoint( false )
+{
+    mPath.reserve( roverConfig.obstacleAvoidance.planningSize * roverConfig.obstacleAvoidance.planningSize );
+} // DStarLiteAvoidance()
+
+// Destructs the DStarLiteAvoidance object.
+DStarLiteAvoidance::~DStarLiteAvoidance() {}
+
+// Plans a path to the destination when a new obstacle is detected and
+// turns towards it. If there is no path yet, turns towards the clear
+// bearing reported by perception until the costmap opens one up.
+// If in search state and target is both detected and reachable, return NavState TurnToTarget.
+NavState DStarLiteAvoidance::executeTurnAroundObs( Rover* phoebe, const NavConfig& roverConfig )
+{
+    if( isTargetDetected( phoebe ) && isTargetReachable( phoebe, roverConfig ) )
+    {
+        return NavState::TurnToTarget;
+    }
+    if( mNewDestination || !mPlanning )
+    {
+        mPlanner.initialize( phoebe->position(), mDestination );
+        mNewDestination = false;
+        mPlanning = true;
+        mHasSteeringPoint = false;
+    }
+    if( !replan( phoebe, roverConfig ) )
+    {
+        if( !mPlanner.contains( phoebe->position() ) )
+        {
+            return finishAvoidance( phoebe );
+        }
+        phoebe->turn( phoebe->roverStatus().odometry().bearing_deg + phoebe->roverStatus().obstacle().bearing );
+        return phoebe->roverStatus().currentState();
+    }
+    if( mPlanner.pathLength() < roverConfig.navThresholds.waypointDistance )
+    {
+        return finishAvoidance( phoebe );
+    }
+
+    const double bearing = planarBearing( phoebe->position(), mSteeringPoint );
+    double bearingDifference = mod( bearing - phoebe->roverStatus().odometry().bearing_deg, 360 );
+    bearingDifference = min( bearingDifference, 360 - bearingDifference );
+    if( bearingDifference <= roverConfig.navThresholds.turningBearing )
+    {
+        if( phoebe->roverStatus().currentState() == NavState::TurnAroundObs )
+        {
+            return NavState::DriveAroundObs;
+        }
+        return NavState::SearchDriveAroundObs;
+    }
+    phoebe->turn( bearing );
+    return phoebe->roverStatus().currentState();
+} // executeTurnAroundObs()
+
+// Drives along the planned path, repairing it every iteration. Once the
+// rover reaches the end of the path it resumes driving to its
+// destination. If it falls off course it turns back towards the path.
+NavState DStarLiteAvoidance::executeDriveAroundObs( Rover* phoebe, const NavConfig& roverConfig )
+{
+    const bool searching = phoebe->roverStatus().currentState() == NavState::SearchDriveAroundObs;
+    if( !mPlanning || !replan( phoebe, roverConfig ) )
+    {
+        return searching ? NavState::SearchTurnAroundObs : NavState::TurnAroundObs;
+    }
+
+    DriveStatus driveStatus = phoebe->drive( mPlanner.pathLength(),
+                                             planarBearing( phoebe->position(), mSteeringPoint ) );
+    if( driveStatus == DriveStatus::Arrived )
+    {
+        return finishAvoidance( phoebe );
+    }
+    if( driveStatus == DriveStatus::OnCourse )
+    {
+        return phoebe->roverStatus().currentState();
+    }
+    return searching ? NavState::SearchTurnAroundObs : NavState::TurnAroundObs;
+} // executeDriveAroundObs()
+
+// Gets the point the rover is currently steering towards.
+Odometry DStarLiteAvoidance::createAvoidancePoint( Rover* phoebe, const double distance )
+{
+    return phoebe->projection().toOdometry( mSteeringPoint );
+} // createAvoidancePoint()
+
+// Moves the plan's start to the rover, updates the blocked cells from
+// the costmap and repairs the plan. Picks the farthest point along the
+// path within the lookahead distance that the rover can drive to in a
+// straight line. Returns false if the rover has left the planning grid
+// or there is no path.
+bool DStarLiteAvoidance::replan( Rover* phoebe, const NavConfig& roverConfig )
+{
+    const LocalPoint& position = phoebe->position();
+    if( !mPlanner.contains( position ) )
+    {
+        return false;
+    }
+    const double halfWidth = roverConfig.roverMeasurements.width / 2;
+    const double inflation = halfWidth + roverConfig.obstacleAvoidance.clearance;
+    const double now = phoebe->clock().now();
+    mPlanner.updateStart( position );
+    mPlanner.updateObstacles( phoebe->costmap(), inflation, now, roverConfig.costmap );
+    if( !mPlanner.plan() )
+    {
+        return false;
+    }
+
+    mPlanner.path( mPath );
+    LocalPoint steeringPoint = mPath.size() > 1 ? mPath[ 1 ] : mPath.front();
+    for( size_t i = 2; i < mPath.size(); ++i )
+    {
+        if( planarDistance( position, mPath[ i ] ) > roverConfig.obstacleAvoidance.lookahead ||
+            !phoebe->costmap().isCorridorClear( position, mPath[ i ], halfWidth, now, roverConfig.costmap ) )
+        {
+            break;
+        }
+        steeringPoint = mPath[ i ];
+    }
+
+    // Position noise moves the start between cells, which can flip the
+    // plan between equally long ways around an obstacle. Keep steering to
+    // the previous point while it is ahead, in view and about as good.
+    if( mHasSteeringPoint &&
+        planarDistance( position, mSteeringPoint ) > roverConfig.obstacleAvoidance.lookahead / 2 &&
+        mPlanner.contains( mSteeringPoint ) &&
+        phoebe->costmap().isCorridorClear( position, mSteeringPoint, halfWidth, now, roverConfig.costmap ) )
+    {
+        const double previousCost = planarDistance( position, mSteeringPoint ) + mPlanner.costToGoal( mSteeringPoint );
+        const double newCost = planarDistance( position, steeringPoint ) + mPlanner.costToGoal( steeringPoint );
+        if( previousCost <= newCost + roverConfig.obstacleAvoidance.switchMargin )
+        {
+            return true;
+        }
+    }
+    mSteeringPoint = steeringPoint;
+    mHasSteeringPoint = true;
+    return true;
+} // replan()
+
+// Forgets the plan and returns the state that resumes driving to the
+// destination.
+NavState DStarLiteAvoidance::finishAvoidance( Rover* phoebe )
+{
+    mPlanning = false;
+    if( phoebe->roverStatus().currentState() == NavState::TurnAroundObs ||
+        phoebe->roverStatus().currentState() == NavState::DriveAroundObs )
+    {
+        return NavState::Turn;
+    }
+    return NavState::SearchTurn;
+} // finishAvoidance()
@@ -0,0 +1,47 @@
+#ifndef D_STAR_LITE_AVOIDANCE_HPP
+#define D_STAR_LITE_AVOIDANCE_HPP
+
+#include <vector>
+#include "obstacleAvoidanceStateMachine.hpp"
+#include "dStarLite.hpp"
+
+// This class implements obstacle avoidance by planning a path around the
+// obstacles in the rover's costmap to the point the rover was driving
+// to. The plan is repaired every iteration as the rover moves and the
+// costmap changes, and the rover steers towards the farthest point along
+// the path that it can reach in a straight line.
+class DStarLiteAvoidance : public ObstacleAvoidanceStateMachine
+{
+public:
+    DStarLiteAvoidance( StateMachine* roverStateMachine, const NavConfig& roverConfig );
+
+    ~DStarLiteAvoidance();
+
+    NavState executeTurnAroundObs( Rover* phoebe, const NavConfig& roverConfig );
+
+    NavState executeDriveAroundObs( Rover* phoebe, const NavConfig& roverConfig );
+
+    Odometry createAvoidancePoint( Rover* phoebe, const double distance );
+
+private:
+    bool replan( Rover* phoebe, const NavConfig& roverConfig );
+
+    NavState finishAvoidance( Rover* phoebe );
+
+    // Planner over the area around the rover and its destination.
+    DStarLite mPlanner;
+
+    // Whether mPlanner holds the plan for the current obstacle.
+    bool mPlanning;
+
+    // Cells of the current plan, reserved so that replanning does not
+    // allocate.
+    vector<LocalPoint> mPath;
+
+    // Point on the path the rover is steering towards, and whether it
+    // was picked for the current plan.
+    LocalPoint mSteeringPoint;
+    bool mHasSteeringPoint;
+};
+
+#endif //D_STAR_LITE_AVOIDANCE_HPP
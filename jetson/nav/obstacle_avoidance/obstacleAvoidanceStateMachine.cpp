@@ -3,13 +3,16 @@
 #include "utilities.hpp"
 #include "stateMachine.hpp"
 #include "simpleAvoidance.hpp"
+#include "dStarLiteAvoidance.hpp"
 #include <cmath>
 #include <iostream>
 
 // Constructs an ObstacleAvoidanceStateMachine object with roverStateMachine
 ObstacleAvoidanceStateMachine::ObstacleAvoidanceStateMachine( StateMachine* stateMachine_)
     : roverStateMachine( stateMachine_ ),
-      mJustDetectedObstacle( false ) {}
+      mJustDetectedObstacle( false ),
+      mDestination( { 0, 0 } ),
+      mNewDestination( false ) {}
 
 // Allows outside objects to set the original obstacle angle
 // This will allow the variable to be set before the rover turns
@@ -33,10 +36,19 @@ void ObstacleAvoidanceStateMachine::updateObstacleElements( double bearing, doub
     updateObstacleDistance( distance );
 }
 
+// Allows outside objects to set the point the rover was driving to
+// when it detected the obstacle, which algorithms that plan a path
+// around the obstacle lead the rover back to.
+void ObstacleAvoidanceStateMachine::updateDestination( const LocalPoint& destination )
+{
+    mDestination = destination;
+    mNewDestination = true;
+}
+
 // Runs the avoidance state machine through one iteration. This will be called by StateMachine
 // when NavState is in an obstacle avoidance state. This will call the corresponding function based
 // on the current state and return the next NavState
-NavState ObstacleAvoidanceStateMachine::run( Rover* phoebe, const rapidjson::Document& roverConfig )
+NavState ObstacleAvoidanceStateMachine::run( Rover* phoebe, const NavConfig& roverConfig )
 {
     switch ( phoebe->roverStatus().currentState() )
     {
@@ -49,7 +61,7 @@ NavState ObstacleAvoidanceStateMachine::run( Rover* phoebe, const rapidjson::Doc
         case NavState::DriveAroundObs:
         case NavState::SearchDriveAroundObs:
         {
-            return executeDriveAroundObs( phoebe );
+            return executeDriveAroundObs( phoebe, roverConfig );
         }
 
         default:
@@ -70,7 +82,8 @@ bool ObstacleAvoidanceStateMachine::isTargetDetected ( Rover* phoebe )
 // The obstacle avoidance factory allows for the creation of obstacle avoidance objects and
 // an ease of transition between obstacle avoidance algorithms
 ObstacleAvoidanceStateMachine* ObstacleAvoiderFactory ( StateMachine* roverStateMachine,
-                                                        ObstacleAvoidanceAlgorithm algorithm )
+                                                        ObstacleAvoidanceAlgorithm algorithm,
+                                                        const NavConfig& roverConfig )
 {
     ObstacleAvoidanceStateMachine* avoid = nullptr;
     switch ( algorithm )
@@ -79,6 +92,10 @@ ObstacleAvoidanceStateMachine* ObstacleAvoiderFactory ( StateMachine* roverState
             avoid = new SimpleAvoidance( roverStateMachine );
             break;
 
+        case ObstacleAvoidanceAlgorithm::DStarLite:
+            avoid = new DStarLiteAvoidance( roverStateMachine, roverConfig );
+            break;
+
         default:
             std::cerr << "Unkown Search Type. Defaulting to original\n";
             avoid = new SimpleAvoidance( roverStateMachine );
@@ -9,7 +9,8 @@ class StateMachine;
 // obstacle avoidance algorithms
 enum class ObstacleAvoidanceAlgorithm
 {
-    SimpleAvoidance
+    SimpleAvoidance = 0,
+    DStarLite = 1
 };
 
 // This class is the base class for the logic of the obstacle avoidance state machine
@@ -29,15 +30,17 @@ public:
 
     void updateObstacleElements( double bearing, double distance );  
 
-    NavState run( Rover* phoebe, const rapidjson::Document& roverConfig );
+    void updateDestination( const LocalPoint& destination );
+
+    NavState run( Rover* phoebe, const NavConfig& roverConfig );
 
     bool isTargetDetected( Rover* phoebe );
 
     virtual Odometry createAvoidancePoint( Rover* phoebe, const double distance ) = 0;
 
-    virtual NavState executeTurnAroundObs( Rover* phoebe, const rapidjson::Document& roverConfig ) = 0;
+    virtual NavState executeTurnAroundObs( Rover* phoebe, const NavConfig& roverConfig ) = 0;
 
-    virtual NavState executeDriveAroundObs( Rover* phoebe ) = 0;
+    virtual NavState executeDriveAroundObs( Rover* phoebe, const NavConfig& roverConfig ) = 0;
 
 protected:
     /*************************************************************************/
@@ -61,12 +64,19 @@ protected:
 
     // Last obstacle angle for consecutive angles
     double mLastObstacleAngle;
+
+    // Point the rover was driving to when the obstacle was detected.
+    LocalPoint mDestination;
+
+    // Whether mDestination was set since the algorithm last read it.
+    bool mNewDestination;
 };
 
 // Creates an ObstacleAvoidanceStateMachine object based on the inputted obstacle 
 // avoidance algorithm. This allows for an an ease of transition between obstacle 
 // avoidance algorithms
 ObstacleAvoidanceStateMachine* ObstacleAvoiderFactory( StateMachine* roverStateMachine,
-                                                       ObstacleAvoidanceAlgorithm algorithm );
+                                                       ObstacleAvoidanceAlgorithm algorithm,
+                                                       const NavConfig& roverConfig );
 
 #endif //OBSTACLE_AVOIDANCE_STATE_MACHINE_HPP
@@ -20,7 +20,7 @@ SimpleAvoidance::~SimpleAvoidance() {}
 // If in search state and target is both detected and reachable, return NavState TurnToTarget.
 // ASSUMPTION: There is no rock that is more than 8 meters (pathWidth * 2) in diameter
 NavState SimpleAvoidance::executeTurnAroundObs( Rover* phoebe,
-                                                const rapidjson::Document& roverConfig )
+                                                const NavConfig& roverConfig )
 {
     if( isTargetDetected ( phoebe ) && isTargetReachable( phoebe, roverConfig ) )
     {
@@ -54,9 +54,13 @@ NavState SimpleAvoidance::executeTurnAroundObs( Rover* phoebe,
 
 // Drives to dummy waypoint. Once arrived, rover will drive to original waypoint
 // ( original waypoint is the waypoint before obstacle avoidance was triggered )
-NavState SimpleAvoidance::executeDriveAroundObs( Rover* phoebe )
+// A detection only sends the rover back to turning if the costmap confirms
+// an obstacle between the rover and the dummy waypoint, so a flickering
+// detection or an obstacle past the dummy waypoint does not stop the rover.
+NavState SimpleAvoidance::executeDriveAroundObs( Rover* phoebe, const NavConfig& roverConfig )
 {
-    if( isObstacleDetected( phoebe ) )
+    if( isObstacleDetected( phoebe ) &&
+        !phoebe->isCorridorClear( phoebe->projection().toLocal( mObstacleAvoidancePoint ) ) )
     {
         if( phoebe->roverStatus().currentState() == NavState::DriveAroundObs )
         {
@@ -88,16 +92,8 @@ NavState SimpleAvoidance::executeDriveAroundObs( Rover* phoebe )
 // Create the odometry point used to drive around an obstacle
 Odometry SimpleAvoidance::createAvoidancePoint( Rover* phoebe, const double distance )
 {
-    Odometry avoidancePoint = phoebe->roverStatus().odometry();
-    double totalLatitudeMinutes = avoidancePoint.latitude_min +
-        cos( degreeToRadian( avoidancePoint.bearing_deg ) ) * distance * LAT_METER_IN_MINUTES;
-    double totalLongitudeMinutes = avoidancePoint.longitude_min +
-        sin( degreeToRadian( avoidancePoint.bearing_deg ) ) * distance * phoebe->longMeterInMinutes();
-    avoidancePoint.latitude_deg += totalLatitudeMinutes / 60;
-    avoidancePoint.latitude_min = ( totalLatitudeMinutes - ( ( (int) totalLatitudeMinutes) / 60 ) * 60 );
-    avoidancePoint.longitude_deg += totalLongitudeMinutes / 60;
-    avoidancePoint.longitude_min = ( totalLongitudeMinutes - ( ( (int) totalLongitudeMinutes) / 60 ) * 60 );
-
-    return avoidancePoint;
-
+    return createOdom( phoebe->roverStatus().odometry(),
+                       phoebe->roverStatus().odometry().bearing_deg,
+                       distance,
+                       phoebe );
 } // createAvoidancePoint()
@@ -13,9 +13,9 @@ public:
 
     ~SimpleAvoidance();
 
-    NavState executeTurnAroundObs( Rover* phoebe, const rapidjson::Document& roverConfig );
+    NavState executeTurnAroundObs( Rover* phoebe, const NavConfig& roverConfig );
 
-    NavState executeDriveAroundObs( Rover* phoebe );
+    NavState executeDriveAroundObs( Rover* phoebe, const NavConfig& roverConfig );
 
     Odometry createAvoidancePoint( Rover* phoebe, const double distance );
 };
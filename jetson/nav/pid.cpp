@@ -1,38 +1,87 @@
 #include "pid.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 PidLoop::PidLoop(double Kp, double Ki, double Kd) :
     Kp_(Kp),
     Ki_(Ki),
     Kd_(Kd),
+    filter_time_constant_(0.0),
+    period_(0.0),
     first_(true),
-    accumulated_error_(0.0),
-    last_error_(0.0)
+    integral_(0.0),
+    last_measurement_(0.0),
+    derivative_(0.0)
 {
 }
 
-double PidLoop::update(double current, double desired) {
-    double err = this->error(current, desired);
-    accumulated_error_ += err;
-    double effort = Kp_*err + Ki_*accumulated_error_;
-    if (!first_) {
-        effort += Kd_*(err - last_error_);
+// Gets the effort to drive current to desired, dt seconds after the
+// last update. feedForward is added to the effort before it is
+// saturated to [-1, 1].
+double PidLoop::update(double current, double desired, double dt, double feedForward) {
+    double err = error(current, desired);
+    if (!first_ && dt > 0) {
+        // Differentiating the measurement instead of the error keeps a
+        // change of the setpoint from kicking the output.
+        double rate = -wrap(current - last_measurement_) / dt;
+        double alpha = dt / (filter_time_constant_ + dt);
+        derivative_ += alpha * (rate - derivative_);
     }
-    last_error_ = err;
+    last_measurement_ = current;
     first_ = false;
 
-    if (effort < sat_min_out_) effort = sat_min_out_;
-    if (effort > sat_max_out_) effort = sat_max_out_;
+    double proportional = Kp_*err + Kd_*derivative_ + feedForward;
+    if (dt > 0) {
+        // Only integrate while the output is not saturated, or when the
+        // error pulls it back out of saturation.
+        double integral = integral_ + Ki_*err*dt;
+        double effort = proportional + integral;
+        if ((effort < sat_max_out_ || err < 0) && (effort > sat_min_out_ || err > 0)) {
+            integral_ = std::min(std::max(integral, sat_min_out_), sat_max_out_);
+        }
+    }
 
-    return effort;
+    return std::min(std::max(proportional + integral_, sat_min_out_), sat_max_out_);
 }
 
 void PidLoop::reset() {
     first_ = true;
-    accumulated_error_ = 0.0;
-    last_error_ = 0.0;
+    integral_ = 0.0;
+    last_measurement_ = 0.0;
+    derivative_ = 0.0;
+}
+
+void PidLoop::setGains(double Kp, double Ki, double Kd) {
+    Kp_ = Kp;
+    Ki_ = Ki;
+    Kd_ = Kd;
+}
+
+// Sets the time constant of the derivative's low-pass filter in
+// seconds. Zero does not filter the derivative.
+void PidLoop::setDerivativeFilter(double timeConstant) {
+    filter_time_constant_ = std::max(timeConstant, 0.0);
 }
 
-double PidLoop::error(double current, double desired) {
-    // TODO add support for modular PID here
-    return desired - current;
+// Sets the period the measurement wraps around at, e.g. 360 for a
+// bearing in degrees. Zero does not wrap.
+void PidLoop::setPeriod(double period) {
+    period_ = std::max(period, 0.0);
+}
+
+double PidLoop::error(double current, double desired) const {
+    return wrap(desired - current);
+}
+
+// Wraps a difference of measurements into [-period / 2, period / 2).
+double PidLoop::wrap(double difference) const {
+    if (period_ <= 0) {
+        return difference;
+    }
+    double wrapped = std::fmod(difference + period_ / 2, period_);
+    if (wrapped < 0) {
+        wrapped += period_;
+    }
+    return wrapped - period_ / 2;
 }
@@ -1,23 +1,41 @@
 #pragma once
 
+// A pid loop for a measured timestep. Gains are per second: the
+// integral accumulates error * dt and the derivative is the rate of
+// change of the measurement, low-pass filtered. The integral stops
+// accumulating while the output is saturated in the direction of the
+// error so that it does not wind up. For angles, setPeriod wraps the
+// error so the loop always takes the short way around.
 class PidLoop {
     public:
         PidLoop(double Kp, double Ki, double Kd);
 
-        double update(double current, double desired);
+        double update(double current, double desired, double dt, double feedForward = 0.0);
         void reset();
+        void setGains(double Kp, double Ki, double Kd);
+        void setDerivativeFilter(double timeConstant);
+        void setPeriod(double period);
 
     private:
-        double error(double current, double desired);
+        double error(double current, double desired) const;
+        double wrap(double difference) const;
 
         double Kp_;
         double Ki_;
         double Kd_;
 
+        // Time constant of the derivative's low-pass filter in seconds.
+        double filter_time_constant_;
+
+        // Period of the measurement, or 0 if it does not wrap.
+        double period_;
+
         const double sat_min_out_ = -1.0;
         const double sat_max_out_ = +1.0;
 
         bool first_;
-        double accumulated_error_;
-        double last_error_;
+        // Integral term, in units of the output.
+        double integral_;
+        double last_measurement_;
+        double derivative_;
 };
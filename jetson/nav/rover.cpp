@@ -1,16 +1,43 @@
 #include "rover.hpp"
 
 #include "utilities.hpp"
-#include "rover_msgs/Joystick.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+
+namespace
+{
+    // Weight of the latest interval between target lists in the
+    // running mean of the frame period.
+    const double FRAME_PERIOD_GAIN = 0.1;
+
+    // Frame periods without a target list after which perception is
+    // taken to have stopped publishing.
+    const double FRAME_PERIOD_TIMEOUT = 3;
+} // namespace
 
 // Constructs a rover status object and initializes the navigation
-// state to off.
+// state to off. Until the messages are received nothing is seen: the
+// obstacle and targets are at distance -1, and the signal is too
+// strong to ever drop a repeater.
 Rover::RoverStatus::RoverStatus()
     : mCurrentState( NavState::Off )
+    , mAutonState()
+    , mCourse()
+    , mObstacle()
+    , mOdometry()
+    , mTarget1()
+    , mTarget2()
+    , mSignal()
+    , mPathTargets( 0 )
+    , mDirtyFlags( 0 )
 {
     mAutonState.is_auton = false;
+    mObstacle.distance = -1;
+    mTarget1.distance = -1;
+    mTarget2.distance = -1;
+    mSignal.signal_strength = numeric_limits<float>::max();
 } // RoverStatus()
 
 // Gets a reference to the rover's current navigation state.
@@ -68,48 +95,72 @@ unsigned Rover::RoverStatus::getPathTargets()
   return mPathTargets;
 } // getPathTargets()
 
-// Assignment operator for the rover status object. Does a "deep" copy
-// where necessary.
-Rover::RoverStatus& Rover::RoverStatus::operator=( Rover::RoverStatus& newRoverStatus )
+// Marks the given DirtyFlags as written.
+void Rover::RoverStatus::markDirty( unsigned flags )
 {
-    mAutonState = newRoverStatus.autonState();
-    mCourse = newRoverStatus.course();
-    mPathTargets = 0;
+    mDirtyFlags |= flags;
+} // markDirty()
 
-    while( !mPath.empty() )
-    {
-        mPath.pop_front();
-    }
-    for( int courseIndex = 0; courseIndex < mCourse.num_waypoints; ++courseIndex )
-    {
-        auto &wp = mCourse.waypoints[ courseIndex ];
-        mPath.push_back( wp );
-        if (wp.search) {
-            ++mPathTargets;
-        }
-    }
-    mObstacle = newRoverStatus.obstacle();
-    mOdometry = newRoverStatus.odometry();
-    mTarget1 = newRoverStatus.target();
-    mTarget2 = newRoverStatus.target2();
-    mSignal = newRoverStatus.radio();
+// Gets the DirtyFlags of the fields written since the last update.
+unsigned Rover::RoverStatus::dirtyFlags() const
+{
+    return mDirtyFlags;
+} // dirtyFlags()
+
+// Marks all fields as consumed.
+void Rover::RoverStatus::clearDirty()
+{
+    mDirtyFlags = 0;
+} // clearDirty()
+
+// Assignment operator for the rover status object. Does a "deep" copy
+// where necessary and rebuilds the path from the course. Only used
+// when the rover is turned on.
+Rover::RoverStatus& Rover::RoverStatus::operator=( const Rover::RoverStatus& newRoverStatus )
+{
+    mAutonState = newRoverStatus.mAutonState;
+    mCourse = newRoverStatus.mCourse;
+
+    auto courseEnd = mCourse.waypoints.begin() + mCourse.num_waypoints;
+    mPath.assign( mCourse.waypoints.begin(), courseEnd );
+    mPathTargets = count_if( mCourse.waypoints.begin(), courseEnd,
+                             []( const Waypoint& waypoint ) { return waypoint.search; } );
+
+    mObstacle = newRoverStatus.mObstacle;
+    mOdometry = newRoverStatus.mOdometry;
+    mTarget1 = newRoverStatus.mTarget1;
+    mTarget2 = newRoverStatus.mTarget2;
+    mSignal = newRoverStatus.mSignal;
     return *this;
 } // operator=
 
 // Constructs a rover object with the given configuration file and lcm
 // object with which to use for communications.
-Rover::Rover( const rapidjson::Document& config, lcm::LCM& lcmObject )
+Rover::Rover( const NavConfig& config, lcm::LCM& lcmObject, const Clock& clock )
     : mRoverConfig( config )
     , mLcmObject( lcmObject )
-    , mDistancePid( config[ "distancePid" ][ "kP" ].GetDouble(),
-                    config[ "distancePid" ][ "kI" ].GetDouble(),
-                    config[ "distancePid" ][ "kD" ].GetDouble() )
-    , mBearingPid( config[ "bearingPid" ][ "kP" ].GetDouble(),
-                   config[ "bearingPid" ][ "kI" ].GetDouble(),
-                   config[ "bearingPid" ][ "kD" ].GetDouble() )
+    , mClock( clock )
+    , mDistancePid( config.distancePid.kP,
+                    config.distancePid.kI,
+                    config.distancePid.kD )
+    , mBearingPid( config.bearingPid.kP,
+                   config.bearingPid.kI,
+                   config.bearingPid.kD )
+    , mDistancePidTime( 0 )
+    , mBearingPidTime( 0 )
     , mTimeToDropRepeater( false )
-    , mLongMeterInMinutes( -1 )
+    , mRepeaterTimerStarted( false )
+    , mRepeaterTimerStart( 0 )
+    , mPosition( { 0, 0 } )
+    , mCostmap( config.costmap.resolution, config.costmap.size )
+    , mLastTargetsTime( -1 )
+    , mFramePeriod( 0 )
+    , mJoystick()
+    , mJoystickBuffer( mJoystick.getEncodedSize() )
 {
+    mDistancePid.setDerivativeFilter( config.distancePid.derivativeFilter );
+    mBearingPid.setDerivativeFilter( config.bearingPid.derivativeFilter );
+    mBearingPid.setPeriod( 360 );
 } // Rover()
 
 // Sends a joystick command to drive forward from the current odometry
@@ -119,8 +170,16 @@ Rover::Rover( const rapidjson::Document& config, lcm::LCM& lcmObject )
 // on-course or off-course.
 DriveStatus Rover::drive( const Odometry& destination )
 {
-    double distance = estimateNoneuclid( mRoverStatus.odometry(), destination );
-    double bearing = calcBearing( mRoverStatus.odometry(), destination );
+    return drive( mProjection.toLocal( destination ) );
+} // drive()
+
+// Sends a joystick command to drive forward from the current position
+// to the destination point on the local plane. Otherwise the same as
+// drive( Odometry ).
+DriveStatus Rover::drive( const LocalPoint& destination )
+{
+    double distance = planarDistance( mPosition, destination );
+    double bearing = planarBearing( mPosition, destination );
     return drive( distance, bearing, false );
 } // drive()
 
@@ -134,23 +193,20 @@ DriveStatus Rover::drive( const Odometry& destination )
 // on-course or off-course.
 DriveStatus Rover::drive( const double distance, const double bearing, const bool target )
 {
-    if( (!target && distance < mRoverConfig[ "navThresholds" ][ "waypointDistance" ].GetDouble()) ||
-        (target && distance < mRoverConfig[ "navThresholds" ][ "targetDistance" ].GetDouble()) )
+    if( (!target && distance < mRoverConfig.navThresholds.waypointDistance) ||
+        (target && distance < mRoverConfig.navThresholds.targetDistance) )
     {
         return DriveStatus::Arrived;
     }
 
-    double destinationBearing = mod( bearing, 360 );
-    throughZero( destinationBearing, mRoverStatus.odometry().bearing_deg ); // will go off course if inside if because through zero not calculated
-
-    if( fabs( destinationBearing - mRoverStatus.odometry().bearing_deg ) < mRoverConfig[ "navThresholds" ][ "drivingBearing" ].GetDouble() )
+    if( fabs( bearingError( bearing ) ) < mRoverConfig.navThresholds.drivingBearing )
     {
-        double distanceEffort = mDistancePid.update( -1 * distance, 0 );
-        double turningEffort = mBearingPid.update( mRoverStatus.odometry().bearing_deg, destinationBearing );
+        double distanceEffort = mDistancePid.update( -1 * distance, 0, pidTimestep( mDistancePidTime ) );
+        double turningEffort = mBearingPid.update( mRoverStatus.odometry().bearing_deg, bearing,
+                                                   pidTimestep( mBearingPidTime ) );
         publishJoystick( distanceEffort, turningEffort, false );
         return DriveStatus::OnCourse;
     }
-    cerr << "offcourse\n";
     return DriveStatus::OffCourse;
 } // drive()
 
@@ -161,20 +217,71 @@ DriveStatus Rover::drive( const double distance, const double bearing, const boo
 // The input bearing is an absolute bearing.
 void Rover::drive(const int direction, const double bearing)
 {
-    double destinationBearing = mod(bearing, 360);
-    throughZero(destinationBearing, mRoverStatus.odometry().bearing_deg);
-    const double distanceEffort = mDistancePid.update(-1 * direction, 0);
-    const double turningEffort = mBearingPid.update(mRoverStatus.odometry().bearing_deg, destinationBearing);
+    const double distanceEffort = mDistancePid.update(-1 * direction, 0, pidTimestep(mDistancePidTime));
+    const double turningEffort = mBearingPid.update(mRoverStatus.odometry().bearing_deg, bearing,
+                                                    pidTimestep(mBearingPidTime));
     publishJoystick(distanceEffort, turningEffort, false);
 } // drive()
 
+// Sends a joystick command to follow the path with pure pursuit. The
+// rover steers along an arc towards the point the lookahead distance
+// ahead of it along the path, so it rounds the corners at waypoints it
+// does not have to stop at instead of stopping to turn in place. It
+// slows down for tight arcs and as it nears the first waypoint it has
+// to stop at: one it searches or looks for a gate at, or the last one.
+// The return value indicates if the rover has arrived at the front of
+// the path. The rover is never off course.
+DriveStatus Rover::followPath( const deque<Waypoint>& path )
+{
+    LocalPoint previous = mPosition;
+    LocalPoint current = mProjection.toLocal( path.front().odom );
+    if( planarDistance( previous, current ) < mRoverConfig.navThresholds.waypointDistance )
+    {
+        return DriveStatus::Arrived;
+    }
+
+    // Walk the lookahead distance along the path and the rest of the way
+    // to the first waypoint to stop at. If the rover has cut the corner
+    // so far that the waypoint is behind it, steer back to the waypoint.
+    double lookaheadLeft = fabs( bearingError( planarBearing( mPosition, current ) ) ) < 90 ? mRoverConfig.pathFollowing.lookahead : 0;
+    LocalPoint lookaheadPoint = current;
+    double distance = 0;
+    for( auto waypoint = path.begin(); ; )
+    {
+        const double length = planarDistance( previous, current );
+        if( lookaheadLeft > 0 )
+        {
+            const double fraction = length > 0 ? min( 1.0, lookaheadLeft / length ) : 1;
+            lookaheadPoint = { previous.x + fraction * ( current.x - previous.x ),
+                               previous.y + fraction * ( current.y - previous.y ) };
+            lookaheadLeft -= length;
+        }
+        distance += length;
+        if( waypoint->search || waypoint->gate || ++waypoint == path.end() )
+        {
+            break;
+        }
+        previous = current;
+        current = mProjection.toLocal( waypoint->odom );
+    }
+    pursue( lookaheadPoint, distance );
+    return DriveStatus::OnCourse;
+} // followPath()
+
 // Sends a joystick command to turn the rover toward the destination
 // odometry. Returns true if the rover has finished turning, false
 // otherwise.
-bool Rover::turn( Odometry& destination )
+bool Rover::turn( const Odometry& destination )
+{
+    return turn( mProjection.toLocal( destination ) );
+} // turn()
+
+// Sends a joystick command to turn the rover toward the destination
+// point on the local plane. Returns true if the rover has finished
+// turning, false otherwise.
+bool Rover::turn( const LocalPoint& destination )
 {
-    double bearing = calcBearing( mRoverStatus.odometry(), destination );
-    return turn( bearing );
+    return turn( planarBearing( mPosition, destination ) );
 } // turn()
 
 // Sends a joystick command to turn the rover. The bearing is the
@@ -182,8 +289,6 @@ bool Rover::turn( Odometry& destination )
 // otherwise.
 bool Rover::turn( double bearing )
 {
-    bearing = mod(bearing, 360);
-    throughZero( bearing, mRoverStatus.odometry().bearing_deg );
     double turningBearingThreshold;
     if( isTurningAroundObstacle( mRoverStatus.currentState() ) )
     {
@@ -191,14 +296,15 @@ bool Rover::turn( double bearing )
     }
     else
     {
-        turningBearingThreshold = mRoverConfig[ "navThresholds" ][ "turningBearing" ].GetDouble();
+        turningBearingThreshold = mRoverConfig.navThresholds.turningBearing;
     }
-    if( fabs( bearing - mRoverStatus.odometry().bearing_deg ) <= turningBearingThreshold )
+    if( fabs( bearingError( bearing ) ) <= turningBearingThreshold )
     {
         return true;
     }
-    double turningEffort = mBearingPid.update( mRoverStatus.odometry().bearing_deg, bearing );
-    double minTurningEffort = mRoverConfig[ "navThresholds" ][ "minTurningEffort" ].GetDouble() * (turningEffort < 0 ? -1 : 1);
+    double turningEffort = mBearingPid.update( mRoverStatus.odometry().bearing_deg, bearing,
+                                               pidTimestep( mBearingPidTime ) );
+    double minTurningEffort = mRoverConfig.navThresholds.minTurningEffort * (turningEffort < 0 ? -1 : 1);
     if( isTurningAroundObstacle( mRoverStatus.currentState() ) && fabs(turningEffort) < minTurningEffort )
     {
         turningEffort = minTurningEffort;
@@ -207,19 +313,30 @@ bool Rover::turn( double bearing )
     return false;
 } // turn()
 
+// Sends a joystick command to turn the rover in place at rate degrees
+// per second, clockwise if positive.
+void Rover::spin( double rate )
+{
+    const double maxTurnRate = mRoverConfig.roverMeasurements.maxTurnRate;
+    publishJoystick( 0, max( -1.0, min( 1.0, rate / maxTurnRate ) ), false );
+} // spin()
+
 // Sends a joystick command to stop the rover.
 void Rover::stop()
 {
     publishJoystick( 0, 0, false );
 } // stop()
 
-// Checks if the rover should be updated based on what information in
-// the rover's status has changed. Returns true if the rover was
-// updated, false otherwise.
-// TODO: unconditionally update everygthing. When abstracting search class
-// we got rid of NavStates TurnToTarget and DriveToTarget (oops) fix this soon :P
-bool Rover::updateRover( RoverStatus newRoverStatus )
+// Checks if the rover should be updated based on which fields of
+// newRoverStatus (the buffer written by the lcm handlers) are dirty,
+// and copies only those fields. The copied fields are fixed size so
+// this does not allocate while the rover is on. Returns true if the
+// rover was updated, false otherwise.
+bool Rover::updateRover( RoverStatus& newRoverStatus )
 {
+    const unsigned dirtyFlags = newRoverStatus.dirtyFlags();
+    newRoverStatus.clearDirty();
+
     // Rover currently on.
     if( mRoverStatus.autonState().is_auton )
     {
@@ -230,21 +347,56 @@ bool Rover::updateRover( RoverStatus newRoverStatus )
             return true;
         }
 
-        // If any data has changed, update all data
-        if( !isEqual( mRoverStatus.obstacle(), newRoverStatus.obstacle() ) ||
-            !isEqual( mRoverStatus.odometry(), newRoverStatus.odometry() ) ||
-            !isEqual( mRoverStatus.target(), newRoverStatus.target()) ||
-            !isEqual( mRoverStatus.target2(), newRoverStatus.target2()) )
+        if( !dirtyFlags )
+        {
+            return false;
+        }
+        if( dirtyFlags & RoverStatus::ObstacleDirty )
         {
             mRoverStatus.obstacle() = newRoverStatus.obstacle();
+        }
+        if( dirtyFlags & RoverStatus::OdometryDirty )
+        {
             mRoverStatus.odometry() = newRoverStatus.odometry();
+            mPosition = mProjection.toLocal( mRoverStatus.odometry() );
+            mCostmap.recenter( mPosition );
+        }
+        if( dirtyFlags & RoverStatus::ObstacleDirty )
+        {
+            mCostmap.addObservation( mPosition, mRoverStatus.odometry().bearing_deg,
+                                     mRoverStatus.obstacle(), mRoverConfig.roverMeasurements.width,
+                                     mClock.now(), mRoverConfig.costmap );
+        }
+        if( dirtyFlags & RoverStatus::TargetsDirty )
+        {
             mRoverStatus.target() = newRoverStatus.target();
+            mRoverStatus.target2() = newRoverStatus.target2();
+            mTargetTracker.update( mPosition, mRoverStatus.odometry().bearing_deg, mRoverStatus.target(),
+                                   mClock.now(), mRoverConfig.targetTracker );
+            mTargetTracker.update( mPosition, mRoverStatus.odometry().bearing_deg, mRoverStatus.target2(),
+                                   mClock.now(), mRoverConfig.targetTracker );
+            if( mLastTargetsTime >= 0 )
+            {
+                const double interval = mClock.now() - mLastTargetsTime;
+                // A gap in the target lists is not a frame period, so the
+                // mean starts over from the next interval.
+                if( mFramePeriod > 0 && interval > FRAME_PERIOD_TIMEOUT * mFramePeriod )
+                {
+                    mFramePeriod = 0;
+                }
+                else
+                {
+                    mFramePeriod = mFramePeriod > 0 ? mFramePeriod + FRAME_PERIOD_GAIN * ( interval - mFramePeriod ) : interval;
+                }
+            }
+            mLastTargetsTime = mClock.now();
+        }
+        if( dirtyFlags & RoverStatus::RadioDirty )
+        {
             mRoverStatus.radio() = newRoverStatus.radio();
-            updateRepeater(mRoverStatus.radio());
-            return true;
         }
-
-        return false;
+        updateRepeater( mRoverStatus.radio() );
+        return true;
     }
 
     // Rover currently off.
@@ -254,21 +406,96 @@ bool Rover::updateRover( RoverStatus newRoverStatus )
         if( newRoverStatus.autonState().is_auton )
         {
             mRoverStatus = newRoverStatus;
-            // Calculate longitude minutes/meter conversion.
-            mLongMeterInMinutes = 60 / ( EARTH_CIRCUM * cos( degreeToRadian(
-                mRoverStatus.odometry().latitude_deg, mRoverStatus.odometry().latitude_min ) ) / 360 );
+            // Anchor the local plane at the rover's current position.
+            mProjection = LocalProjection( mRoverStatus.odometry() );
+            mPosition = mProjection.toLocal( mRoverStatus.odometry() );
+            // Obstacles and targets from a previous run are on another
+            // plane.
+            mCostmap.clear();
+            mCostmap.recenter( mPosition );
+            mTargetTracker.clear();
+            mLastTargetsTime = -1;
             return true;
         }
         return false;
     }
 } // updateRover()
 
-// Calculates the conversion from minutes to meters based on the
-// rover's current latitude.
-const double Rover::longMeterInMinutes() const
+// Gets the projection onto the local plane, which is anchored where
+// the rover was turned on.
+const LocalProjection& Rover::projection() const
 {
-    return mLongMeterInMinutes;
-}
+    return mProjection;
+} // projection()
+
+// Gets the rover's current position on the local plane.
+const LocalPoint& Rover::position() const
+{
+    return mPosition;
+} // position()
+
+// Calculates the distance in meters from the rover to destination.
+double Rover::distanceTo( const Odometry& destination ) const
+{
+    return planarDistance( mPosition, mProjection.toLocal( destination ) );
+} // distanceTo()
+
+// Gets the map of obstacles seen around the rover.
+const Costmap& Rover::costmap() const
+{
+    return mCostmap;
+} // costmap()
+
+// Gets the tracks of the targets seen around the rover.
+const TargetTracker& Rover::targetTracker() const
+{
+    return mTargetTracker;
+} // targetTracker()
+
+// Gets where the target with the given id is estimated to be relative
+// to the rover, even while it is not detected. The distance is -1 if
+// the target has not been seen within the tracker's coast time.
+Target Rover::trackedTarget( int id )
+{
+    return mTargetTracker.predict( mPosition, mRoverStatus.odometry().bearing_deg, id,
+                                   mClock.now(), mRoverConfig.targetTracker );
+} // trackedTarget()
+
+// Gets the mean seconds between the target lists perception publishes,
+// or 0 if fewer than two have arrived since the rover was first turned
+// on. Perception detects targets in one frame at a time, so this is
+// both its frame period and how long a detection takes to arrive.
+double Rover::framePeriod() const
+{
+    return mFramePeriod;
+} // framePeriod()
+
+// Gets the rate in degrees per second at which a spin in place keeps
+// every bearing in view for search.framesPerBearing frames, with one
+// more frame period for the last of them to be detected before the
+// bearing leaves the view. The rate is capped at the rover's maximum
+// turn rate, and is 0 if the frame period is not known yet or no target
+// list has arrived for FRAME_PERIOD_TIMEOUT frame periods, so that
+// spins fall back to stopping and waiting.
+double Rover::spinRate() const
+{
+    if( mFramePeriod <= 0 || mLastTargetsTime < 0 ||
+        mClock.now() - mLastTargetsTime > FRAME_PERIOD_TIMEOUT * mFramePeriod )
+    {
+        return 0;
+    }
+    const double rate = mRoverConfig.computerVision.fieldOfViewAngle /
+                        ( ( mRoverConfig.search.framesPerBearing + 1 ) * mFramePeriod );
+    return min( rate, mRoverConfig.roverMeasurements.maxTurnRate );
+} // spinRate()
+
+// Returns true if the costmap has no obstacle within half the rover's
+// width of the straight line from the rover to destination.
+bool Rover::isCorridorClear( const LocalPoint& destination ) const
+{
+    return mCostmap.isCorridorClear( mPosition, destination, mRoverConfig.roverMeasurements.width / 2,
+                                     mClock.now(), mRoverConfig.costmap );
+} // isCorridorClear()
 
 // Executes the logic starting the clock to time how long it's been
 // since the rover has gotten a strong radio signal. If the signal drops
@@ -276,24 +503,21 @@ const double Rover::longMeterInMinutes() const
 // Otherwise, the signal is good so the timer should be stopped.
 void Rover::updateRepeater(RadioSignalStrength& radioSignal)
 {
-    static bool started = false;
-    static time_t startTime;
-
     // If we haven't already dropped a repeater, the time hasn't already started
     // and our signal is below the threshold, start the timer
     if( !mTimeToDropRepeater &&
-        !started &&
+        !mRepeaterTimerStarted &&
         radioSignal.signal_strength <=
-        mRoverConfig[ "radioRepeaterThresholds" ][ "signalStrengthCutOff" ].GetDouble())
+        mRoverConfig.radioRepeaterThresholds.signalStrengthCutOff)
     {
-        startTime = time( nullptr );
-        started = true;
+        mRepeaterTimerStart = mClock.now();
+        mRepeaterTimerStarted = true;
     }
 
-    double waitTime = mRoverConfig[ "radioRepeaterThresholds" ][ "lowSignalWaitTime" ].GetDouble();
-    if( started && difftime( time( nullptr ), startTime ) > waitTime )
+    double waitTime = mRoverConfig.radioRepeaterThresholds.lowSignalWaitTime;
+    if( mRepeaterTimerStarted && mClock.now() - mRepeaterTimerStart > waitTime )
     {
-        started = false;
+        mRepeaterTimerStarted = false;
         mTimeToDropRepeater = true;
     }
 }
@@ -322,60 +546,88 @@ PidLoop& Rover::bearingPid()
     return mBearingPid;
 } // bearingPid()
 
+// Gets the last joystick command sent to the drive system.
+const Joystick& Rover::lastJoystick() const
+{
+    return mJoystick;
+} // lastJoystick()
+
+// Gets the clock the rover times its waits with.
+const Clock& Rover::clock() const
+{
+    return mClock;
+} // clock()
+
 // Publishes a joystick command with the given forwardBack and
 // leftRight efforts.
 void Rover::publishJoystick( const double forwardBack, const double leftRight, const bool kill )
 {
-    Joystick joystick;
     // power limit (0 = 50%, 1 = 0%, -1 = 100% power)
-    joystick.dampen = mRoverConfig[ "joystick" ][ "dampen" ].GetDouble();
-    double drivingPower = mRoverConfig[ "joystick" ][ "drivingPower" ].GetDouble();
-    joystick.forward_back = drivingPower * forwardBack;
-    double bearingPower = mRoverConfig[ "joystick" ][ "bearingPower" ].GetDouble();
-    joystick.left_right = bearingPower * leftRight;
-    joystick.kill = kill;
-    string joystickChannel = mRoverConfig[ "lcmChannels" ][ "joystickChannel" ].GetString();
-    mLcmObject.publish( joystickChannel, &joystick );
+    mJoystick.dampen = mRoverConfig.joystick.dampen;
+    double drivingPower = mRoverConfig.joystick.drivingPower;
+    mJoystick.forward_back = drivingPower * forwardBack;
+    double bearingPower = mRoverConfig.joystick.bearingPower;
+    mJoystick.left_right = bearingPower * leftRight;
+    mJoystick.kill = kill;
+    const int size = mJoystick.encode( mJoystickBuffer.data(), 0, mJoystickBuffer.size() );
+    if( size < 0 )
+    {
+        cerr << "Could not encode the joystick command.\n";
+        return;
+    }
+    mLcmObject.publish( mRoverConfig.lcmChannels.joystickChannel, mJoystickBuffer.data(), size );
 } // publishJoystick()
 
-// Returns true if the two obstacle messages are equal, false
-// otherwise.
-bool Rover::isEqual( const Obstacle& obstacle1, const Obstacle& obstacle2 ) const
+// Sends a joystick command to drive along the arc through the
+// lookahead point that the rover is tangent to. The speed is set by the
+// distance left to drive and capped so that the arc can be turned at
+// the rover's maximum turn rate. If the lookahead point is behind the
+// rover it turns in place.
+void Rover::pursue( const LocalPoint& lookaheadPoint, double distance )
 {
-    if( obstacle1.distance == obstacle2.distance &&
-        obstacle1.bearing == obstacle2.bearing )
+    const double lookaheadBearing = bearingError( planarBearing( mPosition, lookaheadPoint ) );
+    const double maxTurnRate = degreeToRadian( mRoverConfig.roverMeasurements.maxTurnRate );
+    const double maxSpeed = mRoverConfig.roverMeasurements.maxSpeed;
+    double speed = maxSpeed * mDistancePid.update( -1 * distance, 0, pidTimestep( mDistancePidTime ) );
+    double turnRate = lookaheadBearing < 0 ? -maxTurnRate : maxTurnRate;
+    if( fabs( lookaheadBearing ) < 90 )
     {
-        return true;
+        // Curvature of the arc, in 1/m.
+        const double curvature = 2 * sin( degreeToRadian( lookaheadBearing ) ) /
+                                 max( planarDistance( mPosition, lookaheadPoint ), 1e-3 );
+        speed = min( speed, maxTurnRate / max( fabs( curvature ), 1e-6 ) );
+        turnRate = speed * curvature;
     }
-    return false;
-} // isEqual( Obstacle )
-
-// Returns true if the two odometry messages are equal, false
-// otherwise.
-bool Rover::isEqual( const Odometry& odometry1, const Odometry& odometry2 ) const
-{
-    if( odometry1.latitude_deg == odometry2.latitude_deg &&
-        odometry1.latitude_min == odometry2.latitude_min &&
-        odometry1.longitude_deg == odometry2.longitude_deg &&
-        odometry1.longitude_min == odometry2.longitude_min &&
-        odometry1.bearing_deg == odometry2.bearing_deg )
+    else
     {
-        return true;
+        speed = 0;
     }
-    return false;
-} // isEqual( Odometry )
+    publishJoystick( speed / maxSpeed, turnRate / maxTurnRate, false );
+} // pursue()
 
-// Returns true if the two target messages are equal, false
-// otherwise.
-bool Rover::isEqual( const Target& target1, const Target& target2 ) const
+// Gets the angle in degrees in [-180, 180) the rover has to turn
+// through to face the absolute bearing.
+double Rover::bearingError( double bearing )
+{
+    return mod( bearing - mRoverStatus.odometry().bearing_deg + 180, 360 ) - 180;
+} // bearingError()
+
+// Gets the seconds since a pid loop was last updated at lastUpdate and
+// sets lastUpdate to now. If the loop sat idle for several iterations
+// of the control loop the gap says nothing about this update, so the
+// period of one iteration is used instead.
+double Rover::pidTimestep( double& lastUpdate )
 {
-    if( target1.distance == target2.distance &&
-        target1.bearing == target2.bearing )
+    const double now = mClock.now();
+    const double nominal = 1 / mRoverConfig.controlLoop.rate;
+    double timestep = now - lastUpdate;
+    lastUpdate = now;
+    if( timestep <= 0 || timestep > 5 * nominal )
     {
-        return true;
+        timestep = nominal;
     }
-    return false;
-} // isEqual( Target )
+    return timestep;
+} // pidTimestep()
 
 // Return true if the current state is TurnAroundObs or SearchTurnAroundObs,
 // false otherwise.
@@ -3,10 +3,12 @@
 
 #include <lcm/lcm-cpp.hpp>
 #include <queue>
+#include <vector>
 
 #include "rover_msgs/AutonState.hpp"
 #include "rover_msgs/Bearing.hpp"
 #include "rover_msgs/Course.hpp"
+#include "rover_msgs/Joystick.hpp"
 #include "rover_msgs/Obstacle.hpp"
 #include "rover_msgs/Odometry.hpp"
 #include "rover_msgs/RepeaterDropInit.hpp"
@@ -14,8 +16,12 @@
 #include "rover_msgs/RadioSignalStrength.hpp"
 #include "rover_msgs/TargetList.hpp"
 #include "rover_msgs/Waypoint.hpp"
-#include "rapidjson/document.h"
+#include "navConfig.hpp"
+#include "clock.hpp"
+#include "costmap.hpp"
+#include "localProjection.hpp"
 #include "pid.hpp"
+#include "targetTracker.hpp"
 
 using namespace rover_msgs;
 using namespace std;
@@ -88,6 +94,16 @@ public:
     class RoverStatus
     {
     public:
+        // Flags marking fields that have been written since they were
+        // last consumed by Rover::updateRover.
+        enum DirtyFlag : unsigned
+        {
+            ObstacleDirty = 1 << 0,
+            OdometryDirty = 1 << 1,
+            TargetsDirty = 1 << 2,
+            RadioDirty = 1 << 3
+        };
+
         RoverStatus();
 
         RoverStatus(
@@ -122,7 +138,13 @@ public:
 
         unsigned getPathTargets();
 
-        RoverStatus& operator=( RoverStatus& newRoverStatus );
+        void markDirty( unsigned flags );
+
+        unsigned dirtyFlags() const;
+
+        void clearDirty();
+
+        RoverStatus& operator=( const RoverStatus& newRoverStatus );
 
     private:
         // The rover's current navigation state.
@@ -157,23 +179,34 @@ public:
 
         // Total targets to seach for in the course
         unsigned mPathTargets;
+
+        // DirtyFlags of the fields written since the last update.
+        unsigned mDirtyFlags;
     };
 
-    Rover( const rapidjson::Document& config, lcm::LCM& lcm_in );
+    Rover( const NavConfig& config, lcm::LCM& lcm_in, const Clock& clock );
 
     DriveStatus drive( const Odometry& destination );
 
+    DriveStatus drive( const LocalPoint& destination );
+
     DriveStatus drive( const double distance, const double bearing, const bool target = false );
 
     void drive(const int direction, const double bearing);
 
-    bool turn( Odometry& destination );
+    DriveStatus followPath( const deque<Waypoint>& path );
+
+    bool turn( const Odometry& destination );
+
+    bool turn( const LocalPoint& destination );
 
     bool turn( double bearing );
 
+    void spin( double rate );
+
     void stop();
 
-    bool updateRover( RoverStatus newRoverStatus );
+    bool updateRover( RoverStatus& newRoverStatus );
 
     RoverStatus& roverStatus();
 
@@ -181,7 +214,27 @@ public:
 
     PidLoop& bearingPid();
 
-    const double longMeterInMinutes() const;
+    const Joystick& lastJoystick() const;
+
+    const Clock& clock() const;
+
+    const LocalProjection& projection() const;
+
+    const LocalPoint& position() const;
+
+    double distanceTo( const Odometry& destination ) const;
+
+    const Costmap& costmap() const;
+
+    bool isCorridorClear( const LocalPoint& destination ) const;
+
+    const TargetTracker& targetTracker() const;
+
+    Target trackedTarget( int id );
+
+    double framePeriod() const;
+
+    double spinRate() const;
 
     void updateRepeater( RadioSignalStrength& signal);
 
@@ -193,11 +246,11 @@ private:
     /*************************************************************************/
     void publishJoystick( const double forwardBack, const double leftRight, const bool kill );
 
-    bool isEqual( const Obstacle& obstacle1, const Obstacle& obstacle2 ) const;
+    void pursue( const LocalPoint& lookaheadPoint, double distance );
 
-    bool isEqual( const Odometry& odometry1, const Odometry& odometry2 ) const;
+    double bearingError( double bearing );
 
-    bool isEqual( const Target& target1, const Target& target2 ) const;
+    double pidTimestep( double& lastUpdate );
 
     bool isTurningAroundObstacle( const NavState currentState ) const;
 
@@ -208,25 +261,60 @@ private:
     // The rover's current status.
     RoverStatus mRoverStatus;
 
-    // A reference to the configuration file.
-    const rapidjson::Document& mRoverConfig;
+    // A reference to the rover configuration.
+    const NavConfig& mRoverConfig;
 
     // A reference to the lcm object that will be used for
     // communicating with the actual rover and the base station.
     lcm::LCM& mLcmObject;
 
+    // A reference to the clock the rover times its waits with.
+    const Clock& mClock;
+
     // The pid loop for driving.
     PidLoop mDistancePid;
 
     // The pid loop for turning.
     PidLoop mBearingPid;
 
+    // Clock times at which the pid loops were last updated.
+    double mDistancePidTime;
+    double mBearingPidTime;
+
     // If it is time to drop a radio repeater
     bool mTimeToDropRepeater;
 
-    // The conversion factor from arcminutes to meters. This is based
-    // on the rover's current latitude.
-    double mLongMeterInMinutes;
+    // Whether the radio signal has been weak since mRepeaterTimerStart.
+    bool mRepeaterTimerStarted;
+
+    // Clock time at which the radio signal became weak.
+    double mRepeaterTimerStart;
+
+    // Projection onto the local plane, anchored where the rover was
+    // turned on.
+    LocalProjection mProjection;
+
+    // The rover's current odometry projected onto the local plane.
+    LocalPoint mPosition;
+
+    // Obstacles seen around the rover on the local plane. The grid's
+    // resolution and size are fixed when the rover is constructed.
+    Costmap mCostmap;
+
+    // Where on the local plane the AR tags seen since the rover was
+    // turned on are.
+    TargetTracker mTargetTracker;
+
+    // Clock time the last target list arrived at, or -1 if none has
+    // since the rover was turned on, and the running mean of the
+    // seconds between target lists, or 0 if it is not known yet.
+    double mLastTargetsTime;
+    double mFramePeriod;
+
+    // The last joystick command sent, and the buffer it is encoded
+    // into, reused so that sending does not allocate.
+    Joystick mJoystick;
+    vector<uint8_t> mJoystickBuffer;
 };
 
 #endif // ROVER_HPP
@@ -7,11 +7,12 @@
 
 LawnMower::~LawnMower() {}
 
-void LawnMower::initializeSearch( Rover* phoebe, const rapidjson::Document& roverConfig, const double visionDistance )
+void LawnMower::initializeSearch( Rover* phoebe, const NavConfig& roverConfig, const double visionDistance )
 {
-    const double searchBailThresh = roverConfig[ "search" ][ "bailThresh" ].GetDouble();
+    const double searchBailThresh = roverConfig.search.bailThresh;
 
-    mSearchPoints.clear();
+    const LocalPoint center = phoebe->position();
+    mSearchCorners.clear();
 
     mSearchPointMultipliers.clear();
     // mSearchPointMultipliers.push_back( pair<short, short> (  0, 0 ) );
@@ -25,21 +26,10 @@ void LawnMower::initializeSearch( Rover* phoebe, const rapidjson::Document& rove
     {
         for( auto& mSearchPointMultiplier : mSearchPointMultipliers )
         {
-            Odometry nextSearchPoint = phoebe->roverStatus().odometry();
-
-            double totalLatitudeMinutes = nextSearchPoint.latitude_min +
-                ( mSearchPointMultiplier.first * visionDistance  * LAT_METER_IN_MINUTES );
-            double totalLongitudeMinutes = nextSearchPoint.longitude_min +
-                ( mSearchPointMultiplier.second * (2 * searchBailThresh) * phoebe->longMeterInMinutes() );
-
-            nextSearchPoint.latitude_deg += totalLatitudeMinutes / 60;
-            nextSearchPoint.latitude_min = ( totalLatitudeMinutes - ( ( (int) totalLatitudeMinutes ) / 60 ) * 60 );
-            nextSearchPoint.longitude_deg += totalLongitudeMinutes / 60;
-            nextSearchPoint.longitude_min = ( totalLongitudeMinutes - ( ( (int) totalLongitudeMinutes) / 60 ) * 60 );
-
+            mSearchCorners.push_back( { center.x + mSearchPointMultiplier.second * ( 2 * searchBailThresh ),
+                                        center.y + mSearchPointMultiplier.first * visionDistance } );
             mSearchPointMultiplier.first -= 2;
-            mSearchPoints.push_back( nextSearchPoint );
         }
     }
-    insertIntermediatePoints( phoebe, roverConfig );
+    densifySearchPoints( roverConfig );
 } // initializeSearch()
@@ -0,0 +1,157 @@
+#include "probabilityMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utilities.hpp"
+
+// Constructs an empty map. Nothing is left to find until it is reset.
+ProbabilityMap::ProbabilityMap()
+    : mCenter( { 0, 0 } )
+    , mRadius( 0 )
+    , mResolution( 1 )
+    , mSize( 0 )
+    , mOrigin( { 0, 0 } )
+    , mRemaining( 0 )
+{
+} // ProbabilityMap()
+
+// Starts a search for a target within radius meters of center, most
+// likely near center with a standard deviation of spread meters, on a
+// grid of cells resolution meters on a side. The weights sum to 1. The
+// grid only allocates when it grows.
+void ProbabilityMap::reset( const LocalPoint& center, double radius, double spread, double resolution )
+{
+    mCenter = center;
+    mRadius = radius;
+    mResolution = resolution;
+    mSize = max( 1, static_cast<int>( ceil( 2 * radius / resolution ) ) );
+    mOrigin = { center.x - mSize * resolution / 2, center.y - mSize * resolution / 2 };
+    mWeights.assign( mSize * mSize, 0 );
+
+    double sum = 0;
+    for( int row = 0; row < mSize; ++row )
+    {
+        const double dy = mOrigin.y + ( row + 0.5 ) * resolution - center.y;
+        for( int column = 0; column < mSize; ++column )
+        {
+            const double dx = mOrigin.x + ( column + 0.5 ) * resolution - center.x;
+            const double distanceSquared = dx * dx + dy * dy;
+            if( distanceSquared <= radius * radius )
+            {
+                const double weight = exp( -distanceSquared / ( 2 * spread * spread ) );
+                mWeights[ row * mSize + column ] = weight;
+                sum += weight;
+            }
+        }
+    }
+    for( double& weight : mWeights )
+    {
+        weight /= sum;
+    }
+    mRemaining = 1;
+} // reset()
+
+// Records that perception looked from position towards the absolute
+// bearing without detecting the target. Cells within range meters and
+// fieldOfView degrees of the bearing are scaled by missProbability, the
+// probability that perception misses a target in view. Only the cells
+// in the square around the view are visited.
+void ProbabilityMap::observe( const LocalPoint& position, double bearing, double range, double fieldOfView,
+                              double missProbability )
+{
+    const int minColumn = max( 0, cellCoordinate( position.x - range, mOrigin.x ) );
+    const int maxColumn = min( mSize - 1, cellCoordinate( position.x + range, mOrigin.x ) );
+    const int minRow = max( 0, cellCoordinate( position.y - range, mOrigin.y ) );
+    const int maxRow = min( mSize - 1, cellCoordinate( position.y + range, mOrigin.y ) );
+
+    // A cell is in view if the cosine of its angle off the bearing is at
+    // least that of half the field of view.
+    const double headingX = sin( degreeToRadian( bearing ) );
+    const double headingY = cos( degreeToRadian( bearing ) );
+    const double minCosine = fieldOfView >= 360 ? -1 : cos( degreeToRadian( fieldOfView / 2 ) );
+    const double rangeSquared = range * range;
+    double removed = 0;
+    for( int row = minRow; row <= maxRow; ++row )
+    {
+        const double dy = mOrigin.y + ( row + 0.5 ) * mResolution - position.y;
+        double* weights = &mWeights[ row * mSize ];
+        for( int column = minColumn; column <= maxColumn; ++column )
+        {
+            const double dx = mOrigin.x + ( column + 0.5 ) * mResolution - position.x;
+            const double distanceSquared = dx * dx + dy * dy;
+            if( distanceSquared <= rangeSquared &&
+                dx * headingX + dy * headingY >= minCosine * sqrt( distanceSquared ) )
+            {
+                removed += weights[ column ] * ( 1 - missProbability );
+                weights[ column ] *= missProbability;
+            }
+        }
+    }
+    mRemaining = max( 0.0, mRemaining - removed );
+} // observe()
+
+// Gets the probability that a spin at viewpoint finds the target,
+// assuming every cell within range meters is detected if the target is
+// there.
+double ProbabilityMap::spinGain( const LocalPoint& viewpoint, double range ) const
+{
+    const int minColumn = max( 0, cellCoordinate( viewpoint.x - range, mOrigin.x ) );
+    const int maxColumn = min( mSize - 1, cellCoordinate( viewpoint.x + range, mOrigin.x ) );
+    const int minRow = max( 0, cellCoordinate( viewpoint.y - range, mOrigin.y ) );
+    const int maxRow = min( mSize - 1, cellCoordinate( viewpoint.y + range, mOrigin.y ) );
+    const double rangeSquared = range * range;
+    double gain = 0;
+    for( int row = minRow; row <= maxRow; ++row )
+    {
+        const double dy = mOrigin.y + ( row + 0.5 ) * mResolution - viewpoint.y;
+        const double* weights = &mWeights[ row * mSize ];
+        for( int column = minColumn; column <= maxColumn; ++column )
+        {
+            const double dx = mOrigin.x + ( column + 0.5 ) * mResolution - viewpoint.x;
+            if( dx * dx + dy * dy <= rangeSquared )
+            {
+                gain += weights[ column ];
+            }
+        }
+    }
+    return gain;
+} // spinGain()
+
+// Gets the weight of the cell point is in, or 0 if it is off the grid.
+double ProbabilityMap::weight( const LocalPoint& point ) const
+{
+    const int column = cellCoordinate( point.x, mOrigin.x );
+    const int row = cellCoordinate( point.y, mOrigin.y );
+    if( column < 0 || column >= mSize || row < 0 || row >= mSize )
+    {
+        return 0;
+    }
+    return mWeights[ row * mSize + column ];
+} // weight()
+
+// Gets the probability that the target is in the grid and has not been
+// detected yet.
+double ProbabilityMap::remaining() const
+{
+    return mRemaining;
+} // remaining()
+
+// Gets the search waypoint the map is centred on.
+const LocalPoint& ProbabilityMap::center() const
+{
+    return mCenter;
+} // center()
+
+// Gets the distance from the center the target can be.
+double ProbabilityMap::radius() const
+{
+    return mRadius;
+} // radius()
+
+// Gets the cell coordinate of meters along an axis of the grid that
+// starts at origin.
+int ProbabilityMap::cellCoordinate( double meters, double origin ) const
+{
+    return static_cast<int>( floor( ( meters - origin ) / mResolution ) );
+} // cellCoordinate()
@@ -0,0 +1,67 @@
+#ifndef PROBABILITY_MAP_HPP
+#define PROBABILITY_MAP_HPP
+
+#include <vector>
+#include "localProjection.hpp"
+
+using namespace std;
+
+// This class is a grid on the local plane of how likely the target of a
+// search is to be in each cell. It starts from a gaussian prior around
+// the search waypoint, cut off at the search radius, and every time
+// perception looks at part of the grid without detecting the target the
+// cells in view are scaled by the probability that it would have missed
+// a target there. The weights are not renormalized: their sum is the
+// probability that the target is in the grid and still undetected, and
+// the weight a view covers is the probability that it finds the target.
+class ProbabilityMap
+{
+public:
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    ProbabilityMap();
+
+    void reset( const LocalPoint& center, double radius, double spread, double resolution );
+
+    void observe( const LocalPoint& position, double bearing, double range, double fieldOfView,
+                  double missProbability );
+
+    double spinGain( const LocalPoint& viewpoint, double range ) const;
+
+    double weight( const LocalPoint& point ) const;
+
+    double remaining() const;
+
+    const LocalPoint& center() const;
+
+    double radius() const;
+
+private:
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    int cellCoordinate( double meters, double origin ) const;
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+
+    // The search waypoint and the distance from it the target can be.
+    LocalPoint mCenter;
+    double mRadius;
+
+    // Side of a cell in meters, cells per side of the grid and the
+    // lower left corner of the grid.
+    double mResolution;
+    int mSize;
+    LocalPoint mOrigin;
+
+    // Sum of the weights.
+    double mRemaining;
+
+    // The weights, row major.
+    vector<double> mWeights;
+};
+
+#endif // PROBABILITY_MAP_HPP
@@ -0,0 +1,136 @@
+#include "probabilityMapSearch.hpp"
+#include "utilities.hpp"
+#include "stateMachine.hpp"
+
+#include <cmath>
+
+namespace
+{
+    // Spacing in cells of the points considered for the next viewpoint.
+    const int CANDIDATE_STRIDE = 2;
+} // namespace
+
+// Constructs a probability map search with nothing left to find until
+// it is initialized.
+ProbabilityMapSearch::ProbabilityMapSearch( StateMachine* stateMachine_ )
+    : SearchStateMachine( stateMachine_ )
+    , mVisionDistance( 0 )
+    , mLastObserved( 0 ) {}
+
+ProbabilityMapSearch::~ProbabilityMapSearch() {}
+
+// Starts the map around the search waypoint and plans the first
+// viewpoint. A search starts where the rover has just finished a spin,
+// so the map starts with that spin seen.
+void ProbabilityMapSearch::initializeSearch( Rover* phoebe, const NavConfig& roverConfig, const double visionDistance )
+{
+    const NavConfig::ProbabilityMap& config = roverConfig.probabilityMap;
+    const LocalPoint center = phoebe->projection().toLocal( phoebe->roverStatus().path().front().odom );
+    mMap.reset( center, roverConfig.search.bailThresh, config.spread, config.resolution );
+    mVisionDistance = visionDistance;
+    mMap.observe( phoebe->position(), 0, visionDistance, 360,
+                  pow( 1 - config.detectionProbability, roverConfig.search.framesPerBearing ) );
+    mLastObserved = phoebe->clock().now();
+
+    mSearchCorners.clear();
+    mSearchPoints.clear();
+    mSearchPointIndex = 0;
+    LocalPoint viewpoint;
+    if( planViewpoint( phoebe, roverConfig, viewpoint ) )
+    {
+        mSearchPoints.push_back( viewpoint );
+    }
+} // initializeSearch()
+
+// Gets where the target may still be.
+const ProbabilityMap& ProbabilityMapSearch::probabilityMap() const
+{
+    return mMap;
+} // probabilityMap()
+
+// Updates the map with the frames perception has looked at since the
+// last iteration without detecting the target, and once the rover is
+// done spinning at the last viewpoint, plans the next one. Nothing is
+// planned once the target is unlikely to be left in the map, which
+// ends the search.
+void ProbabilityMapSearch::updateSearch( Rover* phoebe, const NavConfig& roverConfig )
+{
+    const NavConfig::ProbabilityMap& config = roverConfig.probabilityMap;
+    const double now = phoebe->clock().now();
+    if( phoebe->roverStatus().target().distance < 0 && now > mLastObserved )
+    {
+        const double framePeriod = phoebe->framePeriod();
+        const double frames = framePeriod > 0 ? ( now - mLastObserved ) / framePeriod : 1;
+        mMap.observe( phoebe->position(), phoebe->roverStatus().odometry().bearing_deg, mVisionDistance,
+                      roverConfig.computerVision.fieldOfViewAngle,
+                      pow( 1 - config.detectionProbability, frames ) );
+    }
+    mLastObserved = now;
+
+    if( phoebe->roverStatus().currentState() == NavState::SearchTurn &&
+        mSearchPointIndex >= mSearchPoints.size() && mMap.remaining() > config.giveUp )
+    {
+        LocalPoint viewpoint;
+        if( planViewpoint( phoebe, roverConfig, viewpoint ) )
+        {
+            mSearchPoints.clear();
+            mSearchPoints.push_back( viewpoint );
+            mSearchPointIndex = 0;
+        }
+    }
+} // updateSearch()
+
+// Finds the point within the search radius where a spin finds the most
+// of the remaining probability per second it takes to turn to the point,
+// drive there and spin. Points the costmap knows to be occupied are
+// skipped. Returns false if no point has anything left to find.
+bool ProbabilityMapSearch::planViewpoint( Rover* phoebe, const NavConfig& roverConfig, LocalPoint& viewpoint ) const
+{
+    const double now = phoebe->clock().now();
+    const LocalPoint& position = phoebe->position();
+    const double heading = phoebe->roverStatus().odometry().bearing_deg;
+    const double spin = spinTime( phoebe, roverConfig );
+    const double step = CANDIDATE_STRIDE * roverConfig.probabilityMap.resolution;
+    const LocalPoint& center = mMap.center();
+    const int steps = static_cast<int>( mMap.radius() / step );
+
+    double bestScore = 0;
+    for( int i = -steps; i <= steps; ++i )
+    {
+        for( int j = -steps; j <= steps; ++j )
+        {
+            if( i * i + j * j > steps * steps )
+            {
+                continue;
+            }
+            const LocalPoint candidate = { center.x + i * step, center.y + j * step };
+            const double gain = mMap.spinGain( candidate, mVisionDistance );
+            const double distance = planarDistance( position, candidate );
+            const double turn = distance > roverConfig.navThresholds.waypointDistance ?
+                fabs( mod( planarBearing( position, candidate ) - heading + 180, 360 ) - 180 ) : 0;
+            const double time = distance / roverConfig.roverMeasurements.maxSpeed +
+                                turn / roverConfig.roverMeasurements.maxTurnRate + spin;
+            const double score = gain / time;
+            if( score > bestScore &&
+                !phoebe->costmap().isOccupied( candidate, now, roverConfig.costmap ) )
+            {
+                bestScore = score;
+                viewpoint = candidate;
+            }
+        }
+    }
+    return bestScore > 0;
+} // planViewpoint()
+
+// Gets the seconds a spin takes: a full turn at the spin rate, or at
+// the rover's maximum turn rate with a wait at every step.
+double ProbabilityMapSearch::spinTime( Rover* phoebe, const NavConfig& roverConfig ) const
+{
+    const double rate = phoebe->spinRate();
+    if( roverConfig.search.continuousSpin && rate > 0 )
+    {
+        return 360 / rate;
+    }
+    return 360 / roverConfig.roverMeasurements.maxTurnRate +
+           360 / roverConfig.search.searchWaitStepSize * roverConfig.search.searchWaitTime;
+} // spinTime()
@@ -0,0 +1,44 @@
+#ifndef PROBABILITY_MAP_SEARCH_HPP
+#define PROBABILITY_MAP_SEARCH_HPP
+
+#include "searchStateMachine.hpp"
+#include "probabilityMap.hpp"
+
+/*************************************************************************/
+/* Probability Map Search */
+/*************************************************************************/
+// Searches by keeping a probability map of where the target is around
+// the search waypoint, updated with what the camera sees every
+// iteration, and greedily picking the next point to spin at as the one
+// that finds the most of the remaining probability per second spent
+// driving, turning and spinning there.
+class ProbabilityMapSearch : public SearchStateMachine
+{
+public:
+    ProbabilityMapSearch( StateMachine* stateMachine_ );
+
+    ~ProbabilityMapSearch();
+
+    void initializeSearch( Rover* phoebe, const NavConfig& roverConfig, const double visionDistance );
+
+    const ProbabilityMap& probabilityMap() const;
+
+protected:
+    void updateSearch( Rover* phoebe, const NavConfig& roverConfig );
+
+private:
+    bool planViewpoint( Rover* phoebe, const NavConfig& roverConfig, LocalPoint& viewpoint ) const;
+
+    double spinTime( Rover* phoebe, const NavConfig& roverConfig ) const;
+
+    // Where the target may still be.
+    ProbabilityMap mMap;
+
+    // Distance in meters the camera is trusted to see targets at.
+    double mVisionDistance;
+
+    // Clock time the map was last updated with what the camera saw.
+    double mLastObserved;
+};
+
+#endif //PROBABILITY_MAP_SEARCH_HPP
@@ -0,0 +1,254 @@
+#include "searchPlanner.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <pthread.h>
+
+namespace
+{
+    // Plans, built searches and retired searches each queue can hold.
+    const size_t QUEUE_CAPACITY = 16;
+
+    // Milliseconds the planning thread waits for work before checking
+    // whether it should stop.
+    const int WAIT_TIMEOUT = 100;
+
+    // Returns true if a and b are the same pattern.
+    bool samePlan( const SearchPlan& a, const SearchPlan& b )
+    {
+        return a.type == b.type && a.center.x == b.center.x && a.center.y == b.center.y &&
+               a.visionDistance == b.visionDistance && a.searchFails == b.searchFails;
+    } // samePlan()
+} // namespace
+
+// Constructs a SearchPlanner creating searches for stateMachine and
+// starts the planning thread.
+SearchPlanner::SearchPlanner( StateMachine* stateMachine )
+    : mStateMachine( stateMachine )
+    , mRequests( QUEUE_CAPACITY )
+    , mPrepared( QUEUE_CAPACITY )
+    , mRetired( QUEUE_CAPACITY )
+    , mTaken( -1 )
+    , mGeneration( 0 )
+    , mPending( false )
+    , mRunning( true )
+{
+    mReady.reserve( QUEUE_CAPACITY );
+
+    // Signals sent to nav, such as the SIGUSR1 asking for a flight
+    // recorder dump, must not be delivered to the planning thread.
+    // Faults it raises itself still reach the crash handler.
+    sigset_t signals;
+    sigset_t callerSignals;
+    sigfillset( &signals );
+    for( int fault : { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL } )
+    {
+        sigdelset( &signals, fault );
+    }
+    pthread_sigmask( SIG_BLOCK, &signals, &callerSignals );
+    mThread = thread( &SearchPlanner::plan, this );
+    pthread_sigmask( SIG_SETMASK, &callerSignals, nullptr );
+} // SearchPlanner()
+
+// Destructs the SearchPlanner object. Stops the planning thread and
+// deletes the searches that were never taken.
+SearchPlanner::~SearchPlanner()
+{
+    mRunning = false;
+    wake();
+    mThread.join();
+
+    Prepared prepared;
+    while( mPrepared.try_pop( prepared ) )
+    {
+        mReady.push_back( prepared );
+    }
+    for( const Prepared& ready : mReady )
+    {
+        delete ready.search;
+    }
+    SearchStateMachine* search;
+    while( mRetired.try_pop( search ) )
+    {
+        delete search;
+    }
+} // ~SearchPlanner()
+
+// Asks the planning thread to build the search for plan with config.
+// Config is copied once per generation, so it must not change without
+// a call to cancel. The plan is dropped if too many are waiting; the
+// search is then built when it is taken. Must only be called from the
+// control thread.
+void SearchPlanner::prepare( const SearchPlan& plan, const NavConfig& config )
+{
+    collect();
+    if( !mConfig )
+    {
+        mConfig = make_shared<const NavConfig>( config );
+    }
+    if( mRequests.try_push( { plan, mConfig, mGeneration } ) )
+    {
+        wake();
+    }
+} // prepare()
+
+// Hands over the search built for plan, or returns nullptr if none has
+// been built. Planned is set to whether its search points are laid
+// out; if not, initializeSearch must still be called. Searches built
+// for plans starting before this one are discarded. Must only be
+// called from the control thread.
+SearchStateMachine* SearchPlanner::take( const SearchPlan& plan, bool& planned )
+{
+    mTaken = plan.searchFails;
+    collect();
+    for( auto ready = mReady.begin(); ready != mReady.end(); ++ready )
+    {
+        if( samePlan( ready->plan, plan ) )
+        {
+            SearchStateMachine* search = ready->search;
+            planned = ready->planned;
+            mReady.erase( ready );
+            return search;
+        }
+    }
+    planned = false;
+    return nullptr;
+} // take()
+
+// Hands search to the planning thread to delete, or deletes it if the
+// planning thread is behind. Must only be called from the control
+// thread.
+void SearchPlanner::retire( SearchStateMachine* search )
+{
+    if( mRetired.try_push( search ) )
+    {
+        wake();
+    }
+    else
+    {
+        delete search;
+    }
+} // retire()
+
+// Discards the searches built or being built so far, such as when the
+// config or the course changes. Must only be called from the control
+// thread.
+void SearchPlanner::cancel()
+{
+    ++mGeneration;
+    mConfig.reset();
+    collect();
+} // cancel()
+
+// Gets the search started after searchFails searches have failed.
+SearchType SearchPlanner::searchType( const NavConfig& config, int searchFails )
+{
+    switch( config.search.order[ searchFails % config.search.numSearches ] )
+    {
+        case 1:
+            return SearchType::LAWNMOWER;
+
+        case 2:
+            return SearchType::SPIRALIN;
+
+        case 3:
+            return SearchType::PROBABILITY_MAP;
+
+        default:
+            return SearchType::SPIRALOUT;
+    }
+} // searchType()
+
+// Gets the vision distance of the search started after the one started
+// when searchFails searches had failed with visionDistance. It is
+// halved after every second search, down to half a meter.
+double SearchPlanner::nextVisionDistance( int searchFails, double visionDistance )
+{
+    if( searchFails % 2 == 1 && visionDistance > 0.5 )
+    {
+        return visionDistance * 0.5;
+    }
+    return visionDistance;
+} // nextVisionDistance()
+
+// Takes the built searches off mPrepared and discards the ones that
+// will never be taken: those built before a cancel, and those for plans
+// starting before the last plan taken. This keeps mReady from filling
+// up with searches that are not asked for, such as the ones prepared
+// for a search waypoint the target was found at. Must only be called
+// from the control thread.
+void SearchPlanner::collect()
+{
+    Prepared prepared;
+    while( mPrepared.try_pop( prepared ) )
+    {
+        if( prepared.generation == mGeneration && prepared.plan.searchFails >= mTaken &&
+            mReady.size() < mReady.capacity() )
+        {
+            mReady.push_back( prepared );
+        }
+        else
+        {
+            retire( prepared.search );
+        }
+    }
+    for( auto ready = mReady.begin(); ready != mReady.end(); )
+    {
+        if( ready->generation == mGeneration && ready->plan.searchFails >= mTaken )
+        {
+            ++ready;
+        }
+        else
+        {
+            retire( ready->search );
+            ready = mReady.erase( ready );
+        }
+    }
+} // collect()
+
+// Builds the requested searches and deletes the retired ones until the
+// planner is destroyed. Runs on the planning thread.
+void SearchPlanner::plan()
+{
+    Request request;
+    SearchStateMachine* retired;
+    while( mRunning )
+    {
+        bool worked = false;
+        while( mRetired.try_pop( retired ) )
+        {
+            delete retired;
+            worked = true;
+        }
+        if( mRequests.try_pop( request ) )
+        {
+            SearchStateMachine* search = SearchFactory( mStateMachine, request.plan.type );
+            const bool planned = search->planSearch( request.plan.center, *request.config,
+                                                     request.plan.visionDistance );
+            request.config.reset();
+            if( !mPrepared.try_push( { request.plan, search, planned, request.generation } ) )
+            {
+                delete search;
+            }
+            worked = true;
+        }
+        if( worked )
+        {
+            continue;
+        }
+
+        unique_lock<mutex> lock( mMutex );
+        mWork.wait_for( lock, chrono::milliseconds( WAIT_TIMEOUT ), [this]() { return mPending || !mRunning; } );
+        mPending = false;
+    }
+} // plan()
+
+// Wakes the planning thread.
+void SearchPlanner::wake()
+{
+    {
+        lock_guard<mutex> lock( mMutex );
+        mPending = true;
+    }
+    mWork.notify_one();
+} // wake()
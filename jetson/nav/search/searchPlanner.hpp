@@ -0,0 +1,127 @@
+#ifndef SEARCH_PLANNER_HPP
+#define SEARCH_PLANNER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "localProjection.hpp"
+#include "navConfig.hpp"
+#include "searchStateMachine.hpp"
+#include "thor.hpp"
+
+using namespace std;
+
+// A search pattern to start: the search, the search waypoint on the
+// local plane, the vision distance the pattern is spaced by and the
+// number of searches that will have failed when it starts.
+struct SearchPlan
+{
+    SearchType type;
+    LocalPoint center;
+    double visionDistance;
+    int searchFails;
+};
+
+// This class builds the search patterns for a search waypoint on a
+// thread of its own while the rover drives there. The control thread
+// asks for the patterns once the waypoint is the head of the path and
+// takes them when the search changes patterns, so neither creating the
+// search nor laying out its points happens in a tick. Patterns that
+// start from where the rover is when they start are only created
+// ahead, and laid out when they are taken. Plans and patterns pass
+// between the threads through lock-free queues.
+class SearchPlanner
+{
+public:
+    SearchPlanner( StateMachine* stateMachine );
+
+    ~SearchPlanner();
+
+    void prepare( const SearchPlan& plan, const NavConfig& config );
+
+    SearchStateMachine* take( const SearchPlan& plan, bool& planned );
+
+    void retire( SearchStateMachine* search );
+
+    void cancel();
+
+    static SearchType searchType( const NavConfig& config, int searchFails );
+
+    static double nextVisionDistance( int searchFails, double visionDistance );
+
+private:
+    /*************************************************************************/
+    /* Private Types */
+    /*************************************************************************/
+    // A plan handed to the planning thread with the config to build it
+    // with, which is shared rather than copied.
+    struct Request
+    {
+        SearchPlan plan;
+        shared_ptr<const NavConfig> config;
+        long generation;
+    };
+
+    // A search built for a plan, and whether its points are laid out.
+    struct Prepared
+    {
+        SearchPlan plan;
+        SearchStateMachine* search;
+        bool planned;
+        long generation;
+    };
+
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    void collect();
+
+    void plan();
+
+    void wake();
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // State machine the searches are created for.
+    StateMachine* mStateMachine;
+
+    // Plans to build, built searches and searches to delete.
+    Thor::SpscQueue<Request> mRequests;
+    Thor::SpscQueue<Prepared> mPrepared;
+    Thor::SpscQueue<SearchStateMachine*> mRetired;
+
+    // Built searches the control thread has taken off mPrepared but not
+    // used yet.
+    vector<Prepared> mReady;
+
+    // Search fails of the last plan taken. Searches built for plans
+    // that start earlier will never be asked for.
+    int mTaken;
+
+    // Counts calls to cancel. Searches built before the last call are
+    // not handed out.
+    long mGeneration;
+
+    // Snapshot of the config the plans of this generation are built
+    // with. It is taken by the first plan after a cancel and never
+    // changed, so the planning thread can read it while the control
+    // thread runs.
+    shared_ptr<const NavConfig> mConfig;
+
+    // Wakes the planning thread when there is work.
+    mutex mMutex;
+    condition_variable mWork;
+    bool mPending;
+
+    // Whether the planning thread should keep running.
+    atomic<bool> mRunning;
+
+    // Thread building the searches.
+    thread mThread;
+};
+
+#endif // SEARCH_PLANNER_HPP
@@ -5,20 +5,45 @@
 #include "spiralOutSearch.hpp"
 #include "spiralInSearch.hpp"
 #include "lawnMowerSearch.hpp"
+#include "probabilityMapSearch.hpp"
 
 #include <iostream>
-#include <time.h>
 #include <cmath>
 
+namespace
+{
+    // Gets the number of points that must be added between start and
+    // end so that no two consecutive points are more than maxDifference
+    // meters apart.
+    int numIntermediatePoints( const LocalPoint& start, const LocalPoint& end, const double maxDifference )
+    {
+        const double distance = planarDistance( start, end );
+        if( distance <= maxDifference )
+        {
+            return 0;
+        }
+        return int( ceil( distance / maxDifference ) - 1 );
+    } // numIntermediatePoints()
+} // namespace
+
 // Constructs an SearchStateMachine object with roverStateMachine
 SearchStateMachine::SearchStateMachine(StateMachine* roverStateMachine )
-    : roverStateMachine( roverStateMachine ) {}
+    : mTargetAngle( 0 )
+    , mTurnToTargetRoverAngle( 0 )
+    , mTargetId( -1 )
+    , mNextStop( 0 )
+    , mOriginalSpinAngle( 0 )
+    , mWaitStarted( false )
+    , mWaitStartTime( 0 )
+    , roverStateMachine( roverStateMachine )
+    , mSearchPointIndex( 0 ) {}
 
 // Runs the search state machine through one iteration. This will be called by
 // StateMachine  when NavState is in a search state. This will call the corresponding
 // function based on the current state and return the next NavState
-NavState SearchStateMachine::run( Rover* phoebe, const rapidjson::Document& roverConfig )
+NavState SearchStateMachine::run( Rover* phoebe, const NavConfig& roverConfig )
 {
+    updateSearch( phoebe, roverConfig );
     switch ( phoebe->roverStatus().currentState() )
     {
         case NavState::SearchSpin:
@@ -44,7 +69,7 @@ NavState SearchStateMachine::run( Rover* phoebe, const rapidjson::Document& rove
 
         case NavState::TurnToTarget:
         {
-            return executeTurnToTarget( phoebe );
+            return executeTurnToTarget( phoebe, roverConfig );
         }
 
         case NavState::DriveToTarget:
@@ -60,38 +85,50 @@ NavState SearchStateMachine::run( Rover* phoebe, const rapidjson::Document& rove
     } // switch
 } // run()
 
-// Executes the logic for a search spin. If at a multiple of
-// waitStepSize, the rover will go to SearchSpinWait. If the rover
-// detects the target, it proceeds to the target. If finished with a 360,
-// the rover moves on to the next phase of the search. Else continues
-// to search spin.
-NavState SearchStateMachine::executeSearchSpin( Rover* phoebe, const rapidjson::Document& roverConfig )
+// Executes the logic for a search spin. If the rover detects the
+// target, it proceeds to the target. If spinning continuously, the
+// rover turns at the rate perception keeps up with. Else if at a
+// multiple of waitStepSize, the rover will go to SearchSpinWait. If
+// finished with a 360, the rover moves on to the next phase of the
+// search. Else continues to search spin.
+NavState SearchStateMachine::executeSearchSpin( Rover* phoebe, const NavConfig& roverConfig )
 {
     // degrees to turn to before performing a search wait.
-    double waitStepSize = roverConfig[ "search" ][ "searchWaitStepSize" ].GetDouble();
-    static double nextStop = 0; // to force the rover to wait initially
-    static double mOriginalSpinAngle = 0; //initialize, is corrected on first call
+    double waitStepSize = roverConfig.search.searchWaitStepSize;
 
     if( phoebe->roverStatus().target().distance >= 0 )
     {
-        updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
-                                           phoebe->roverStatus().odometry().bearing_deg );
-        return NavState::TurnToTarget;
+        return turnToDetectedTarget( phoebe );
     }
-    if ( nextStop == 0 )
+    const double bearing = phoebe->roverStatus().odometry().bearing_deg;
+    if ( mNextStop == 0 )
     {
         //get current angle and set as origAngle
-        mOriginalSpinAngle = phoebe->roverStatus().odometry().bearing_deg; //doublecheck
-        nextStop = mOriginalSpinAngle;
+        mOriginalSpinAngle = bearing; //doublecheck
+        mNextStop = mOriginalSpinAngle;
+    }
+    const double spinRate = phoebe->spinRate();
+    if( roverConfig.search.continuousSpin && spinRate > 0 )
+    {
+        // Follow the bearing unwrapped so the spin ends after a full
+        // turn.
+        mNextStop += mod( bearing - mNextStop + 180, 360 ) - 180;
+        if( mNextStop - mOriginalSpinAngle >= 360 )
+        {
+            mNextStop = 0;
+            return NavState::SearchTurn;
+        }
+        phoebe->spin( spinRate );
+        return NavState::SearchSpin;
     }
-    if( phoebe->turn( nextStop ) )
+    if( phoebe->turn( mNextStop ) )
     {
-        if( nextStop - mOriginalSpinAngle >= 360 )
+        if( mNextStop - mOriginalSpinAngle >= 360 )
         {
-            nextStop = 0;
+            mNextStop = 0;
             return NavState::SearchTurn;
         }
-        nextStop += waitStepSize;
+        mNextStop += waitStepSize;
         return NavState::SearchSpinWait;
     }
     return NavState::SearchSpin;
@@ -102,27 +139,22 @@ NavState SearchStateMachine::executeSearchSpin( Rover* phoebe, const rapidjson::
 // look for the target. If the rover detects the target, it proceeds
 // to the target. If the rover is done waiting, it continues the search
 // spin. Else the rover keeps waiting.
-NavState SearchStateMachine::executeRoverWait( Rover* phoebe, const rapidjson::Document& roverConfig )
+NavState SearchStateMachine::executeRoverWait( Rover* phoebe, const NavConfig& roverConfig )
 {
-    static bool started = false;
-    static time_t startTime;
-
     if( phoebe->roverStatus().target().distance >= 0 )
     {
-        updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
-                                       phoebe->roverStatus().odometry().bearing_deg );
-        return NavState::TurnToTarget;
+        return turnToDetectedTarget( phoebe );
     }
-    if( !started )
+    if( !mWaitStarted )
     {
         phoebe->stop();
-        startTime = time( nullptr );
-        started = true;
+        mWaitStartTime = phoebe->clock().now();
+        mWaitStarted = true;
     }
-    double waitTime = roverConfig[ "search" ][ "searchWaitTime" ].GetDouble();
-    if( difftime( time( nullptr ), startTime ) > waitTime )
+    double waitTime = roverConfig.search.searchWaitTime;
+    if( phoebe->clock().now() - mWaitStartTime > waitTime )
     {
-        started = false;
+        mWaitStarted = false;
         if ( phoebe->roverStatus().currentState() == NavState::SearchSpinWait )
         {
             return NavState::SearchSpin;
@@ -140,23 +172,28 @@ NavState SearchStateMachine::executeRoverWait( Rover* phoebe, const rapidjson::D
 }
 
 // Executes the logic for turning while searching.
+// Search points the costmap knows to be occupied are skipped.
 // If no remaining search points, it proceeds to change search algorithms.
 // If the rover detects the target, it proceeds to the target.
 // If the rover finishes turning, it proceeds to driving while searching.
 // Else the rover keeps turning to the next Waypoint.
-NavState SearchStateMachine::executeSearchTurn( Rover* phoebe, const rapidjson::Document& roverConfig )
+NavState SearchStateMachine::executeSearchTurn( Rover* phoebe, const NavConfig& roverConfig )
 {
-    if( mSearchPoints.empty() )
+    const double now = phoebe->clock().now();
+    while( mSearchPointIndex < mSearchPoints.size() &&
+           phoebe->costmap().isOccupied( mSearchPoints[ mSearchPointIndex ], now, roverConfig.costmap ) )
+    {
+        ++mSearchPointIndex;
+    }
+    if( mSearchPointIndex >= mSearchPoints.size() )
     {
         return NavState::ChangeSearchAlg;
     }
     if( phoebe->roverStatus().target().distance >= 0 )
     {
-        updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
-                                       phoebe->roverStatus().odometry().bearing_deg );
-        return NavState::TurnToTarget;
+        return turnToDetectedTarget( phoebe );
     }
-    Odometry& nextSearchPoint = mSearchPoints.front();
+    const LocalPoint& nextSearchPoint = mSearchPoints[ mSearchPointIndex ];
     if( phoebe->turn( nextSearchPoint ) )
     {
         return NavState::SearchDrive;
@@ -174,22 +211,21 @@ NavState SearchStateMachine::executeSearchDrive( Rover* phoebe )
 {
     if( phoebe->roverStatus().target().distance >= 0 )
     {
-        updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
-                                           phoebe->roverStatus().odometry().bearing_deg );
-        return NavState::TurnToTarget;
+        return turnToDetectedTarget( phoebe );
     }
     if( isObstacleDetected( phoebe ) )
     {
         roverStateMachine->updateObstacleAngle( phoebe->roverStatus().obstacle().bearing );
         roverStateMachine->updateObstacleDistance( phoebe->roverStatus().obstacle().distance );
+        roverStateMachine->updateObstacleDestination( mSearchPoints[ mSearchPointIndex ] );
         return NavState::SearchTurnAroundObs;
     }
-    const Odometry& nextSearchPoint = mSearchPoints.front();
+    const LocalPoint& nextSearchPoint = mSearchPoints[ mSearchPointIndex ];
     DriveStatus driveStatus = phoebe->drive( nextSearchPoint );
 
     if( driveStatus == DriveStatus::Arrived )
     {
-        mSearchPoints.pop_front();
+        ++mSearchPointIndex;
         return NavState::SearchSpin;
     }
     if( driveStatus == DriveStatus::OnCourse )
@@ -204,9 +240,10 @@ NavState SearchStateMachine::executeSearchDrive( Rover* phoebe )
 // If the rover finishes turning to the target, it goes into waiting state to
 // give CV time to relocate the target
 // Else the rover continues to turn to to the target.
-NavState SearchStateMachine::executeTurnToTarget( Rover* phoebe )
+NavState SearchStateMachine::executeTurnToTarget( Rover* phoebe, const NavConfig& roverConfig )
 {
-    if( phoebe->roverStatus().target().distance < 0 )
+    const Target target = currentTarget( phoebe, roverConfig );
+    if( target.distance < 0 )
     {
         cerr << "Lost the target. Continuing to turn to last known angle\n";
         if( phoebe->turn( mTargetAngle + mTurnToTargetRoverAngle ) )
@@ -215,13 +252,11 @@ NavState SearchStateMachine::executeTurnToTarget( Rover* phoebe )
         }
         return NavState::TurnToTarget;
     }
-    if( phoebe->turn( phoebe->roverStatus().target().bearing +
-                      phoebe->roverStatus().odometry().bearing_deg ) )
+    if( phoebe->turn( target.bearing + phoebe->roverStatus().odometry().bearing_deg ) )
     {
         return NavState::DriveToTarget;
     }
-    updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
-                                       phoebe->roverStatus().odometry().bearing_deg );
+    updateTargetDetectionElements( target.bearing, phoebe->roverStatus().odometry().bearing_deg );
     return NavState::TurnToTarget;
 } // executeTurnToTarget()
 
@@ -232,39 +267,44 @@ NavState SearchStateMachine::executeTurnToTarget( Rover* phoebe )
 // If the rover finishes driving to the target, it moves on to the next Waypoint.
 // If the rover is on course, it keeps driving to the target.
 // Else, it turns back to face the target.
-NavState SearchStateMachine::executeDriveToTarget( Rover* phoebe, const rapidjson::Document& roverConfig )
+NavState SearchStateMachine::executeDriveToTarget( Rover* phoebe, const NavConfig& roverConfig )
 {
-    if( phoebe->roverStatus().target().distance < 0 )
+    const Target target = currentTarget( phoebe, roverConfig );
+    if( target.distance < 0 )
     {
         cerr << "Lost the target\n";
         return NavState::SearchTurn; //NavState::SearchSpin
     }
     if( isObstacleDetected( phoebe ) &&
-        !isTargetReachable( phoebe, roverConfig ) )
+        !isLocationReachable( phoebe, roverConfig, target.distance, roverConfig.navThresholds.targetDistance ) )
     {
         roverStateMachine->updateObstacleAngle( phoebe->roverStatus().obstacle().bearing );
         roverStateMachine->updateObstacleDistance( phoebe->roverStatus().obstacle().distance );
+        roverStateMachine->updateObstacleDestination(
+            offsetPoint( phoebe->position(),
+                         phoebe->roverStatus().odometry().bearing_deg + target.bearing,
+                         target.distance ) );
         return NavState::SearchTurnAroundObs;
     }
 
-    DriveStatus driveStatus = phoebe->drive( phoebe->roverStatus().target().distance,
-                                             phoebe->roverStatus().target().bearing +
-                                             phoebe->roverStatus().odometry().bearing_deg,
+    DriveStatus driveStatus = phoebe->drive( target.distance,
+                                             target.bearing + phoebe->roverStatus().odometry().bearing_deg,
                                              true );
     if( driveStatus == DriveStatus::Arrived )
     {
         mSearchPoints.clear();
+        mSearchPointIndex = 0;
         if( phoebe->roverStatus().path().front().gate )
         {
             roverStateMachine->mGateStateMachine->mGateSearchPoints.clear();
             const double absAngle = mod(phoebe->roverStatus().odometry().bearing_deg +
-                                        phoebe->roverStatus().target().bearing,
+                                        target.bearing,
                                         360);
             roverStateMachine->mGateStateMachine->lastKnownPost1.odom = createOdom( phoebe->roverStatus().odometry(),
                                                                                     absAngle,
-                                                                                    phoebe->roverStatus().target().distance,
+                                                                                    target.distance,
                                                                                     phoebe );
-            roverStateMachine->mGateStateMachine->lastKnownPost1.id = phoebe->roverStatus().target().id;
+            roverStateMachine->mGateStateMachine->lastKnownPost1.id = target.id;
             return NavState::GateSpin;
         }
         phoebe->roverStatus().path().pop_front();
@@ -301,34 +341,68 @@ void SearchStateMachine::updateTargetDetectionElements( double target_bearing, d
     updateTurnToTargetRoverAngle( rover_bearing );
 } // updateTargetDetectionElements
 
-// add intermediate points between the existing search points in a path generated by a search algorithm.
-// The maximum separation between any points in the search point list is determined by the rover's sight distance.
-void SearchStateMachine::insertIntermediatePoints( Rover * phoebe, const rapidjson::Document& roverConfig )
+// Remembers which target was detected and the angles it was detected
+// at, ends the spin if the rover was spinning, and turns to it.
+NavState SearchStateMachine::turnToDetectedTarget( Rover* phoebe )
+{
+    mNextStop = 0;
+    mTargetId = phoebe->roverStatus().target().id;
+    updateTargetDetectionElements( phoebe->roverStatus().target().bearing,
+                                   phoebe->roverStatus().odometry().bearing_deg );
+    return NavState::TurnToTarget;
+} // turnToDetectedTarget()
+
+// Gets the target the rover is heading to. With the target tracker
+// enabled this is where the tracker estimates the target is, which
+// lasts through detection dropouts; otherwise it is the latest
+// detection. The distance is negative if the target is lost.
+Target SearchStateMachine::currentTarget( Rover* phoebe, const NavConfig& roverConfig )
+{
+    if( !roverConfig.targetTracker.enabled )
+    {
+        return phoebe->roverStatus().target();
+    }
+    return phoebe->trackedTarget( mTargetId );
+} // currentTarget()
+
+// Fills mSearchPoints with the corners in mSearchCorners and evenly
+// spaced points along each side between them. The maximum separation
+// between any two consecutive points is determined by the rover's sight
+// distance. The points are counted before they are written so the
+// buffer is sized once and every point is written exactly once.
+void SearchStateMachine::densifySearchPoints( const NavConfig& roverConfig )
 {
-    double visionDistance = roverConfig[ "computerVision" ][ "visionDistance" ].GetDouble();
-    const double maxDifference = 2 * visionDistance;
+    const double maxDifference = 2 * roverConfig.computerVision.visionDistance;
 
-    for( int i = 0; i < int( mSearchPoints.size() ) - 1; ++i )
+    mSearchPoints.clear();
+    mSearchPointIndex = 0;
+    if( mSearchCorners.empty() )
     {
-        Odometry point1 = mSearchPoints.at( i );
-        Odometry point2 = mSearchPoints.at( i + 1 );
-        double distance = estimateNoneuclid( point1, point2 );
-        if ( distance > maxDifference )
+        return;
+    }
+
+    size_t numPoints = mSearchCorners.size();
+    for( size_t i = 1; i < mSearchCorners.size(); ++i )
+    {
+        numPoints += numIntermediatePoints( mSearchCorners[ i - 1 ], mSearchCorners[ i ], maxDifference );
+    }
+    mSearchPoints.reserve( numPoints );
+
+    mSearchPoints.push_back( mSearchCorners.front() );
+    for( size_t i = 1; i < mSearchCorners.size(); ++i )
+    {
+        const LocalPoint& start = mSearchCorners[ i - 1 ];
+        const LocalPoint& end = mSearchCorners[ i ];
+        const int numPointsOnSide = numIntermediatePoints( start, end, maxDifference );
+        for( int j = 1; j <= numPointsOnSide; ++j )
         {
-            int numPoints = int( ceil( distance / maxDifference ) - 1 );
-            double newDifference = distance / ( numPoints + 1 );
-            double bearing = calcBearing( point1, point2 );
-            for ( int j = 0; j < numPoints; ++j )
-            {
-                Odometry startPoint = mSearchPoints.at( i );
-                Odometry newOdom = createOdom( startPoint, bearing, newDifference, phoebe );
-                auto insertPosition = mSearchPoints.begin() + i + 1;
-                mSearchPoints.insert( insertPosition, newOdom );
-                ++i;
-            }
+            const double fraction = double( j ) / ( numPointsOnSide + 1 );
+            mSearchPoints.push_back( { start.x + fraction * ( end.x - start.x ),
+                                       start.y + fraction * ( end.y - start.y ) } );
         }
+        mSearchPoints.push_back( end );
     }
-} // insertIntermediatePoints()
+} // densifySearchPoints()
 
 // The search factory allows for the creation of search objects and
 // an ease of transition between search algorithms
@@ -349,6 +423,10 @@ SearchStateMachine* SearchFactory( StateMachine* stateMachine, SearchType type )
             search = new SpiralIn( stateMachine );
             break;
 
+        case SearchType::PROBABILITY_MAP:
+            search = new ProbabilityMapSearch( stateMachine );
+            break;
+
         default:
             std::cerr << "Unkown Search Type. Defaulting to Spiral\n";
             search = new SpiralOut( stateMachine );
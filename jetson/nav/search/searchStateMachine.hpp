@@ -12,7 +12,8 @@ enum class SearchType
 {
     SPIRALOUT,
     LAWNMOWER,
-    SPIRALIN
+    SPIRALIN,
+    PROBABILITY_MAP
 };
 
 class SearchStateMachine {
@@ -24,27 +25,33 @@ public:
 
     virtual ~SearchStateMachine() {}
 
-    NavState run( Rover * phoebe, const rapidjson::Document& roverConfig );
+    NavState run( Rover * phoebe, const NavConfig& roverConfig );
 
     bool targetReachable( Rover* phoebe, double distance, double bearing );
 
-    virtual void initializeSearch( Rover* phoebe, const rapidjson::Document& roverConfig, double pathWidth ) = 0; // TODO
+    virtual void initializeSearch( Rover* phoebe, const NavConfig& roverConfig, double pathWidth ) = 0; // TODO
+
+    // Lays out the search points around center without the rover, so
+    // it may be called off the control thread. Returns false for
+    // searches that start from where the rover is, which are only laid
+    // out by initializeSearch.
+    virtual bool planSearch( const LocalPoint& center, const NavConfig& roverConfig, double pathWidth ) { return false; }
 
 private:
     /*************************************************************************/
     /* Private Member Functions */
     /*************************************************************************/
-    NavState executeSearchSpin( Rover* phoebe, const rapidjson::Document& roverConfig );
+    NavState executeSearchSpin( Rover* phoebe, const NavConfig& roverConfig );
 
-    NavState executeRoverWait( Rover* phoebe, const rapidjson::Document& roverConfig );
+    NavState executeRoverWait( Rover* phoebe, const NavConfig& roverConfig );
 
-    NavState executeSearchTurn( Rover* phoebe, const rapidjson::Document& roverConfig );
+    NavState executeSearchTurn( Rover* phoebe, const NavConfig& roverConfig );
 
     NavState executeSearchDrive( Rover* phoebe );
 
-    NavState executeTurnToTarget( Rover* phoebe );
+    NavState executeTurnToTarget( Rover* phoebe, const NavConfig& roverConfig );
 
-    NavState executeDriveToTarget( Rover* phoebe, const rapidjson::Document& roverConfig );
+    NavState executeDriveToTarget( Rover* phoebe, const NavConfig& roverConfig );
 
     void updateTargetAngle( double bearing );
 
@@ -52,6 +59,10 @@ private:
 
     void updateTargetDetectionElements( double target_bearing, double rover_bearing );
 
+    NavState turnToDetectedTarget( Rover* phoebe );
+
+    Target currentTarget( Rover* phoebe, const NavConfig& roverConfig );
+
     /*************************************************************************/
     /* Private Member Variables */
     /*************************************************************************/
@@ -62,12 +73,32 @@ private:
     // Last known angle of rover from turn to target.
     double mTurnToTargetRoverAngle;
 
+    // Id of the target the rover is heading to.
+    int mTargetId;
+
+    // Bearing the search spin turns to next, or during a continuous
+    // spin the bearing turned to so far, unwrapped. Zero until the spin
+    // starts, which forces the rover to wait initially.
+    double mNextStop;
+
+    // Bearing the rover had when the search spin started.
+    double mOriginalSpinAngle;
+
+    // Whether the rover is waiting for CV and since when.
+    bool mWaitStarted;
+    double mWaitStartTime;
+
 protected:
     /*************************************************************************/
     /* Protected Member Functions */
     /*************************************************************************/
 
-    void insertIntermediatePoints( Rover * phoebe, const rapidjson::Document& roverConfig );
+    void densifySearchPoints( const NavConfig& roverConfig );
+
+    // Called at the start of every iteration of run, before the state
+    // is executed. Searches that adapt to what the rover has seen
+    // update their search points here.
+    virtual void updateSearch( Rover* phoebe, const NavConfig& roverConfig ) {}
 
     /*************************************************************************/
     /* Protected Member Variables */
@@ -79,8 +110,15 @@ protected:
     // Vector of search point multipliers used as a base for the search points.
     vector< pair<short, short> > mSearchPointMultipliers;
 
-    // Queue of search points.
-    deque<Odometry> mSearchPoints;
+    // Corners of the search pattern on the local plane, in the order
+    // they are visited.
+    vector<LocalPoint> mSearchCorners;
+
+    // Search points on the local plane, in the order they are visited.
+    vector<LocalPoint> mSearchPoints;
+
+    // Index in mSearchPoints of the point the rover is heading to.
+    size_t mSearchPointIndex;
 
 };
 
@@ -9,9 +9,16 @@ SpiralIn::~SpiralIn() {}
 
 // Initializes the search ponit multipliers to be the intermost loop
 // of the search.
-void SpiralIn::initializeSearch( Rover* phoebe, const rapidjson::Document& roverConfig, const double visionDistance )
+void SpiralIn::initializeSearch( Rover* phoebe, const NavConfig& roverConfig, const double visionDistance )
 {
-    mSearchPoints.clear();
+    planSearch( phoebe->projection().toLocal( phoebe->roverStatus().path().front().odom ), roverConfig,
+                visionDistance );
+} // initializeSearch()
+
+// Lays out the spiral around the search waypoint at center.
+bool SpiralIn::planSearch( const LocalPoint& center, const NavConfig& roverConfig, const double visionDistance )
+{
+    mSearchCorners.clear();
 
     mSearchPointMultipliers.clear();
     mSearchPointMultipliers.push_back( pair<short, short> ( -1,  0 ) );
@@ -19,25 +26,17 @@ void SpiralIn::initializeSearch( Rover* phoebe, const rapidjson::Document& rover
     mSearchPointMultipliers.push_back( pair<short, short> (  1,  1 ) );
     mSearchPointMultipliers.push_back( pair<short, short> (  1, -1 ) );
 
-    while( mSearchPointMultipliers[ 0 ].second * visionDistance < roverConfig[ "search" ][ "bailThresh" ].GetDouble() ) {
+    while( mSearchPointMultipliers[ 0 ].second * visionDistance < roverConfig.search.bailThresh ) {
         for( auto& mSearchPointMultiplier : mSearchPointMultipliers )
         {
-            Odometry nextSearchPoint = phoebe->roverStatus().path().front().odom;
-            double totalLatitudeMinutes = nextSearchPoint.latitude_min +
-                ( mSearchPointMultiplier.first * visionDistance  * LAT_METER_IN_MINUTES );
-            double totalLongitudeMinutes = nextSearchPoint.longitude_min +
-                ( mSearchPointMultiplier.second * visionDistance * phoebe->longMeterInMinutes() );
-            nextSearchPoint.latitude_deg += totalLatitudeMinutes / 60;
-            nextSearchPoint.latitude_min = ( totalLatitudeMinutes - ( ( (int) totalLatitudeMinutes ) / 60 ) * 60 );
-            nextSearchPoint.longitude_deg += totalLongitudeMinutes / 60;
-            nextSearchPoint.longitude_min = ( totalLongitudeMinutes - ( ( (int) totalLongitudeMinutes) / 60 ) * 60 );
-
-            mSearchPoints.push_back( nextSearchPoint );
+            mSearchCorners.push_back( { center.x + mSearchPointMultiplier.second * visionDistance,
+                                        center.y + mSearchPointMultiplier.first * visionDistance } );
 
             mSearchPointMultiplier.first < 0 ? --mSearchPointMultiplier.first : ++mSearchPointMultiplier.first;
             mSearchPointMultiplier.second < 0 ? --mSearchPointMultiplier.second : ++mSearchPointMultiplier.second;
         }
     }
-    insertIntermediatePoints( phoebe, roverConfig );
+    densifySearchPoints( roverConfig );
     //TODO Reverse Deque. Not using this search though...
-} // initializeSearch()
\ No newline at end of file
+    return true;
+} // planSearch()
\ No newline at end of file
@@ -13,7 +13,9 @@ public:
 
     // Initializes the search ponit multipliers to be the intermost loop
     // of the search.
-    void initializeSearch( Rover* phoebe, const rapidjson::Document& roverConfig, const double pathWidth );
+    void initializeSearch( Rover* phoebe, const NavConfig& roverConfig, const double pathWidth );
+
+    bool planSearch( const LocalPoint& center, const NavConfig& roverConfig, double pathWidth );
 };
 
 #endif //SPIRAL_OUT_SEARCH_HPP
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+#include "navConfigWatcher.hpp"
+#include "scenario.hpp"
+#include "simulation.hpp"
+
+using namespace std;
+
+// Runs the nav state machine through a scenario faster than real time
+// and prints how the mission went. Uses the default nav config unless a
+// config file is given, and records the mission's lcm traffic to an
+// event log if asked to. Returns 0 if the mission was completed.
+int main( int argc, char** argv )
+{
+    string configPath;
+    string logPath;
+    bool valid = argc >= 2;
+    for( int i = 2; i < argc && valid; ++i )
+    {
+        if( string( argv[ i ] ) == "--record" && i + 1 < argc )
+        {
+            logPath = argv[ ++i ];
+        }
+        else if( configPath.empty() )
+        {
+            configPath = argv[ i ];
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+    if( !valid )
+    {
+        cerr << "Usage: " << argv[ 0 ] << " <scenario.json> [config_nav/config.json] [--record log.lcmlog]\n";
+        return 1;
+    }
+
+    Scenario scenario;
+    string error;
+    if( !loadScenario( argv[ 1 ], scenario, error ) )
+    {
+        cerr << "Error: invalid scenario: " << error << "\n";
+        return 1;
+    }
+
+    NavConfig config;
+    if( !configPath.empty() )
+    {
+        NavConfigWatcher configLoader( configPath );
+        if( !configLoader.load( config, error ) )
+        {
+            cerr << "Error: invalid nav config " << configPath << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    Simulation simulation( config, scenario );
+    if( !logPath.empty() && !simulation.record( logPath ) )
+    {
+        cerr << "Error: cannot write " << logPath << "\n";
+        return 1;
+    }
+    const SimulationResult& result = simulation.run();
+    auto elapsed = chrono::duration<double, milli>( chrono::steady_clock::now() - start );
+
+    cout << ( result.completed ? "Completed" : "Did not complete" ) << " the course: "
+         << result.completedWaypoints << "/" << scenario.waypoints.size() << " waypoints in "
+         << result.time << " s (" << result.ticks << " ticks, " << elapsed.count() << " ms), "
+         << result.distance << " m driven, " << result.collisions << " collisions, ended in "
+         << simulation.navState() << "\n";
+    return result.completed ? 0 : 1;
+} // main()
@@ -0,0 +1,105 @@
+#include "replay.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    // Longest line an output is written to, with room for any state
+    // name.
+    const int LINE_LENGTH = 160;
+} // namespace
+
+// Constructs a Replay with a nav state machine running config.
+Replay::Replay( const NavConfig& config )
+    : mJoystickChannel( config.lcmChannels.joystickChannel )
+    , mNavStatusChannel( config.lcmChannels.navStatusChannel )
+    , mTimeStep( 1.0 / config.controlLoop.rate )
+    , mClock()
+    , mLcmObject( "memq://" )
+    , mStateMachine( mLcmObject, config, mClock )
+    , mLcmHandlers( &mStateMachine )
+{
+    mLcmHandlers.subscribe( mLcmObject );
+    mLcmObject.subscribe( mJoystickChannel, &Replay::joystick, this );
+    mLcmObject.subscribe( mNavStatusChannel, &Replay::navStatus, this );
+} // Replay()
+
+// Replays the event log at path. A tick runs once every event recorded
+// up to its time has been fed to nav, and a last tick runs after the
+// last event. Returns false with an error if the log cannot be read.
+bool Replay::run( const string& path, string& error )
+{
+    lcm::LogFile log( path, "r" );
+    const lcm::LogEvent* event = log.good() ? log.readNextEvent() : nullptr;
+    if( !event )
+    {
+        error = "cannot read events from " + path;
+        return false;
+    }
+    const int64_t start = event->timestamp;
+    int64_t end = start;
+    for( ; event; event = log.readNextEvent() )
+    {
+        end = event->timestamp;
+        while( end - start > llround( mResult.ticks * mTimeStep * 1e6 ) )
+        {
+            tick();
+        }
+        if( event->channel == mJoystickChannel || event->channel == mNavStatusChannel )
+        {
+            continue;
+        }
+        mLcmObject.publish( event->channel, event->data, event->datalen );
+        ++mResult.events;
+    }
+    tick();
+    mResult.duration = ( end - start ) / 1e6;
+    return true;
+} // run()
+
+// Gets what nav did during the replay.
+const ReplayResult& Replay::result() const
+{
+    return mResult;
+} // result()
+
+// Feeds nav the events waiting for it, runs the state machine once and
+// collects what it published.
+void Replay::tick()
+{
+    drainLcm();
+    auto start = chrono::steady_clock::now();
+    mStateMachine.run();
+    mResult.tickSeconds.push_back( chrono::duration<double>( chrono::steady_clock::now() - start ).count() );
+    drainLcm();
+    mClock.advance( mTimeStep );
+    ++mResult.ticks;
+} // tick()
+
+// Handles every lcm message that is waiting.
+void Replay::drainLcm()
+{
+    while( mLcmObject.handleTimeout( 0 ) > 0 ) {}
+} // drainLcm()
+
+// Collects a joystick command nav published.
+void Replay::joystick( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                       const Joystick* joystick )
+{
+    char line[ LINE_LENGTH ];
+    snprintf( line, sizeof( line ), "%.2f %s %.4f %.4f %.4f %d %d", mClock.now(), channel.c_str(),
+              joystick->forward_back, joystick->left_right, joystick->dampen, joystick->kill, joystick->restart );
+    mResult.outputs.push_back( line );
+} // joystick()
+
+// Collects a nav status nav published.
+void Replay::navStatus( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                        const NavStatus* navStatus )
+{
+    char line[ LINE_LENGTH ];
+    snprintf( line, sizeof( line ), "%.2f %s %s %d/%d", mClock.now(), channel.c_str(),
+              navStatus->nav_state_name.c_str(), navStatus->completed_wps, navStatus->total_wps );
+    mResult.outputs.push_back( line );
+} // navStatus()
@@ -0,0 +1,90 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <string>
+#include <vector>
+#include <lcm/lcm-cpp.hpp>
+#include "rover_msgs/Joystick.hpp"
+#include "rover_msgs/NavStatus.hpp"
+#include "clock.hpp"
+#include "lcmHandlers.hpp"
+#include "navConfig.hpp"
+#include "stateMachine.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// What nav did while replaying an event log.
+struct ReplayResult
+{
+    // Input events fed to nav and state machine ticks run.
+    long events = 0;
+    long ticks = 0;
+
+    // Seconds of the log replayed.
+    double duration = 0;
+
+    // Every joystick command and nav status nav published, one line
+    // each, stamped with the seconds since the start of the log.
+    vector<string> outputs;
+
+    // Wall clock seconds each tick of the state machine took.
+    vector<double> tickSeconds;
+};
+
+// This class replays an lcm event log, such as one lcm-logger recorded
+// on the rover or the simulator recorded, into a real nav state machine
+// as fast as it runs. The log's events are fed to nav over an
+// in-process lcm in the order they were recorded, and the state machine
+// ticks at the control loop rate on a virtual clock between them, so a
+// log replays the same way every time. Nav's own outputs in the log are
+// skipped; the ones the state machine publishes are collected instead.
+class Replay
+{
+public:
+    Replay( const NavConfig& config );
+
+    bool run( const string& path, string& error );
+
+    const ReplayResult& result() const;
+
+private:
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    void tick();
+
+    void drainLcm();
+
+    void joystick( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                   const Joystick* joystick );
+
+    void navStatus( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                    const NavStatus* navStatus );
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+    // Channels nav publishes on.
+    string mJoystickChannel;
+    string mNavStatusChannel;
+
+    // Seconds of virtual time per tick of the state machine.
+    double mTimeStep;
+
+    // The time nav reads, in seconds since the start of the log.
+    VirtualClock mClock;
+
+    // In-process lcm connecting the log and nav.
+    lcm::LCM mLcmObject;
+
+    // The nav state machine under test.
+    StateMachine mStateMachine;
+
+    // Forwards lcm messages to mStateMachine.
+    LcmHandlers mLcmHandlers;
+
+    ReplayResult mResult;
+};
+
+#endif // REPLAY_HPP
@@ -0,0 +1,275 @@
+#include "scenario.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    // Reads the number json[ key ] into out. If the value is missing,
+    // out is left untouched unless the value is required, in which case
+    // an error is recorded. Returns false on error.
+    bool readNumber( const rapidjson::Value& json, const char* key, double& out,
+                     bool required, string& error )
+    {
+        if( !json.HasMember( key ) )
+        {
+            if( required )
+            {
+                error = string( "missing value \"" ) + key + "\"";
+            }
+            return !required;
+        }
+        if( !json[ key ].IsNumber() )
+        {
+            error = string( "\"" ) + key + "\" is not a number";
+            return false;
+        }
+        out = json[ key ].GetDouble();
+        return true;
+    } // readNumber()
+
+    // Reads the boolean json[ key ] into out, defaulting to false.
+    bool readBool( const rapidjson::Value& json, const char* key, bool& out, string& error )
+    {
+        out = false;
+        if( !json.HasMember( key ) )
+        {
+            return true;
+        }
+        if( !json[ key ].IsBool() )
+        {
+            error = string( "\"" ) + key + "\" is not a boolean";
+            return false;
+        }
+        out = json[ key ].GetBool();
+        return true;
+    } // readBool()
+
+    // Reads the required local point { "x", "y" } in json.
+    bool readPoint( const rapidjson::Value& json, LocalPoint& out, string& error )
+    {
+        return readNumber( json, "x", out.x, true, error ) &&
+               readNumber( json, "y", out.y, true, error );
+    } // readPoint()
+
+    // Checks that json[ key ], if present, is an object. Returns nullptr
+    // if it is missing.
+    const rapidjson::Value* findObject( const rapidjson::Value& json, const char* key,
+                                        bool required, string& error, bool& valid )
+    {
+        valid = true;
+        if( !json.HasMember( key ) )
+        {
+            if( required )
+            {
+                error = string( "missing section \"" ) + key + "\"";
+                valid = false;
+            }
+            return nullptr;
+        }
+        if( !json[ key ].IsObject() )
+        {
+            error = string( "\"" ) + key + "\" is not an object";
+            valid = false;
+            return nullptr;
+        }
+        return &json[ key ];
+    } // findObject()
+
+    // Gets the array json[ key ] of objects. Returns nullptr if it is
+    // missing and not required.
+    const rapidjson::Value* findArray( const rapidjson::Value& json, const char* key,
+                                       bool required, string& error, bool& valid )
+    {
+        valid = true;
+        if( !json.HasMember( key ) )
+        {
+            if( required )
+            {
+                error = string( "missing array \"" ) + key + "\"";
+                valid = false;
+            }
+            return nullptr;
+        }
+        const rapidjson::Value& array = json[ key ];
+        if( !array.IsArray() )
+        {
+            error = string( "\"" ) + key + "\" is not an array";
+            valid = false;
+            return nullptr;
+        }
+        for( const rapidjson::Value& element : array.GetArray() )
+        {
+            if( !element.IsObject() )
+            {
+                error = string( "\"" ) + key + "\" contains a non-object";
+                valid = false;
+                return nullptr;
+            }
+        }
+        return &array;
+    } // findArray()
+
+    // Reads the origin, start and model sections of the scenario.
+    bool readSetup( const rapidjson::Value& json, Scenario& scenario, string& error )
+    {
+        bool valid;
+        const rapidjson::Value* origin = findObject( json, "origin", true, error, valid );
+        if( !valid )
+        {
+            return false;
+        }
+        double latitudeDeg;
+        double longitudeDeg;
+        if( !readNumber( *origin, "latitude_deg", latitudeDeg, true, error ) ||
+            !readNumber( *origin, "latitude_min", scenario.origin.latitude_min, true, error ) ||
+            !readNumber( *origin, "longitude_deg", longitudeDeg, true, error ) ||
+            !readNumber( *origin, "longitude_min", scenario.origin.longitude_min, true, error ) )
+        {
+            return false;
+        }
+        scenario.origin.latitude_deg = static_cast<int32_t>( latitudeDeg );
+        scenario.origin.longitude_deg = static_cast<int32_t>( longitudeDeg );
+
+        const rapidjson::Value* start = findObject( json, "start", true, error, valid );
+        if( !valid || !readPoint( *start, scenario.start, error ) ||
+            !readNumber( *start, "bearing", scenario.startBearing, false, error ) )
+        {
+            return false;
+        }
+
+        const rapidjson::Value* rover = findObject( json, "rover", false, error, valid );
+        if( !valid || ( rover &&
+            ( !readNumber( *rover, "driveSpeed", scenario.rover.driveSpeed, false, error ) ||
+              !readNumber( *rover, "turnSpeed", scenario.rover.turnSpeed, false, error ) ||
+              !readNumber( *rover, "width", scenario.rover.width, false, error ) ) ) )
+        {
+            return false;
+        }
+
+        const rapidjson::Value* perception = findObject( json, "perception", false, error, valid );
+        if( !valid || ( perception &&
+            ( !readNumber( *perception, "fieldOfViewAngle", scenario.perception.fieldOfViewAngle, false, error ) ||
+              !readNumber( *perception, "obstacleDepth", scenario.perception.obstacleDepth, false, error ) ||
+              !readNumber( *perception, "targetDepth", scenario.perception.targetDepth, false, error ) ||
+              !readNumber( *perception, "targetDropout", scenario.perception.targetDropout, false, error ) ||
+              !readNumber( *perception, "framePeriod", scenario.perception.framePeriod, false, error ) ) ) )
+        {
+            return false;
+        }
+        const rapidjson::Value* noise = findObject( json, "noise", false, error, valid );
+        if( !valid || ( noise &&
+            ( !readNumber( *noise, "position", scenario.noise.position, false, error ) ||
+              !readNumber( *noise, "bearing", scenario.noise.bearing, false, error ) ||
+              !readNumber( *noise, "obstacleDistance", scenario.noise.obstacleDistance, false, error ) ||
+              !readNumber( *noise, "targetDistance", scenario.noise.targetDistance, false, error ) ||
+              !readNumber( *noise, "targetBearing", scenario.noise.targetBearing, false, error ) ) ) )
+        {
+            return false;
+        }
+        return readNumber( json, "radioSignalStrength", scenario.radioSignalStrength, false, error ) &&
+               readNumber( json, "timeLimit", scenario.timeLimit, false, error );
+    } // readSetup()
+
+    // Reads the waypoints, obstacles and targets of the scenario.
+    bool readField( const rapidjson::Value& json, Scenario& scenario, string& error )
+    {
+        bool valid;
+        const rapidjson::Value* waypoints = findArray( json, "waypoints", true, error, valid );
+        if( !valid )
+        {
+            return false;
+        }
+        for( const rapidjson::Value& waypointJson : waypoints->GetArray() )
+        {
+            ScenarioWaypoint waypoint;
+            double id = -1;
+            waypoint.gateWidth = 0;
+            if( !readPoint( waypointJson, waypoint.position, error ) ||
+                !readBool( waypointJson, "search", waypoint.search, error ) ||
+                !readBool( waypointJson, "gate", waypoint.gate, error ) ||
+                !readNumber( waypointJson, "gateWidth", waypoint.gateWidth, false, error ) ||
+                !readNumber( waypointJson, "id", id, false, error ) )
+            {
+                return false;
+            }
+            waypoint.id = static_cast<int>( id );
+            scenario.waypoints.push_back( waypoint );
+        }
+
+        const rapidjson::Value* obstacles = findArray( json, "obstacles", false, error, valid );
+        if( !valid )
+        {
+            return false;
+        }
+        for( size_t i = 0; obstacles && i < obstacles->Size(); ++i )
+        {
+            ScenarioObstacle obstacle;
+            if( !readPoint( ( *obstacles )[ i ], obstacle.position, error ) ||
+                !readNumber( ( *obstacles )[ i ], "radius", obstacle.radius, true, error ) )
+            {
+                return false;
+            }
+            scenario.obstacles.push_back( obstacle );
+        }
+
+        const rapidjson::Value* targets = findArray( json, "targets", false, error, valid );
+        if( !valid )
+        {
+            return false;
+        }
+        for( size_t i = 0; targets && i < targets->Size(); ++i )
+        {
+            ScenarioTarget target;
+            double id;
+            if( !readPoint( ( *targets )[ i ], target.position, error ) ||
+                !readNumber( ( *targets )[ i ], "id", id, true, error ) )
+            {
+                return false;
+            }
+            target.id = static_cast<int>( id );
+            scenario.targets.push_back( target );
+        }
+        return true;
+    } // readField()
+} // namespace
+
+// Validates the json scenario and copies it into scenario. Returns
+// false and leaves scenario untouched if a value is missing or has the
+// wrong type, in which case error describes the problem.
+bool parseScenario( const rapidjson::Value& json, Scenario& scenario, string& error )
+{
+    if( !json.IsObject() )
+    {
+        error = "scenario is not an object";
+        return false;
+    }
+    Scenario parsed;
+    if( !readSetup( json, parsed, error ) || !readField( json, parsed, error ) )
+    {
+        return false;
+    }
+    scenario = parsed;
+    return true;
+} // parseScenario()
+
+// Reads and parses the scenario file at path.
+bool loadScenario( const string& path, Scenario& scenario, string& error )
+{
+    ifstream file( path );
+    if( !file )
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    stringstream contents;
+    contents << file.rdbuf();
+    rapidjson::Document json;
+    json.Parse( contents.str().c_str() );
+    if( json.HasParseError() )
+    {
+        error = "invalid json in " + path;
+        return false;
+    }
+    return parseScenario( json, scenario, error );
+} // loadScenario()
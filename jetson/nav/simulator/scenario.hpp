@@ -0,0 +1,103 @@
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include <string>
+#include <vector>
+#include "rapidjson/document.h"
+#include "rover_msgs/Odometry.hpp"
+#include "localProjection.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// A waypoint of the simulated course. Positions are in meters on the
+// local plane anchored at the scenario's origin.
+struct ScenarioWaypoint
+{
+    LocalPoint position;
+    bool search;
+    bool gate;
+    double gateWidth;
+    int id;
+};
+
+// A round obstacle in the simulated field.
+struct ScenarioObstacle
+{
+    LocalPoint position;
+    double radius;
+};
+
+// An AR tag (a search target or a gate post) in the simulated field.
+struct ScenarioTarget
+{
+    LocalPoint position;
+    int id;
+};
+
+// Description of a simulated mission: where the field is, where the
+// rover starts, the course it is sent and what is in the field.
+struct Scenario
+{
+    // The odometry the local plane is anchored at.
+    Odometry origin = Odometry();
+
+    // The rover's starting position and bearing in degrees.
+    LocalPoint start = { 0, 0 };
+    double startBearing = 0;
+
+    // The kinematic model of the rover. The speeds are reached at full
+    // joystick deflection.
+    struct Rover
+    {
+        double driveSpeed = 2;
+        double turnSpeed = 30;
+        double width = 1.5;
+    } rover;
+
+    // What the rover's perception can see, the probability that it
+    // misses a target in view in any one frame, and the seconds it
+    // takes to detect targets in a frame. Perception works on one frame
+    // at a time, so a frame's targets are published when the next frame
+    // is captured. A frame period of 0 publishes the targets in view
+    // every tick.
+    struct Perception
+    {
+        double fieldOfViewAngle = 110;
+        double obstacleDepth = 5;
+        double targetDepth = 10;
+        double targetDropout = 0;
+        double framePeriod = 0;
+    } perception;
+
+    // Standard deviations of the gaussian noise added to what the rover
+    // senses. Positions and distances are in meters, bearings in
+    // degrees.
+    struct Noise
+    {
+        double position = 0;
+        double bearing = 0;
+        double obstacleDistance = 0;
+        double targetDistance = 0;
+        double targetBearing = 0;
+    } noise;
+
+    // Strength of the radio signal to the base station. Below nav's
+    // signalStrengthCutOff the rover goes back to drop a repeater.
+    double radioSignalStrength = 100;
+
+    // Simulated seconds after which the mission counts as failed.
+    double timeLimit = 600;
+
+    vector<ScenarioWaypoint> waypoints;
+
+    vector<ScenarioObstacle> obstacles;
+
+    vector<ScenarioTarget> targets;
+};
+
+bool parseScenario( const rapidjson::Value& json, Scenario& scenario, string& error );
+
+bool loadScenario( const string& path, Scenario& scenario, string& error );
+
+#endif // SCENARIO_HPP
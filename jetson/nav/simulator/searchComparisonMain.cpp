@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "navConfigWatcher.hpp"
+#include "scenario.hpp"
+#include "simulation.hpp"
+#include "sweep.hpp"
+
+using namespace std;
+
+namespace
+{
+    // A search compared, as the value of search.order that selects it.
+    struct Search
+    {
+        const char* name;
+        int order;
+    };
+
+    const Search SEARCHES[] = { { "spiral out", 0 }, { "probability map", 3 } };
+    const size_t SEARCH_COUNT = sizeof( SEARCHES ) / sizeof( SEARCHES[ 0 ] );
+
+    // Runs a mission and gets the seconds from the first spin at the
+    // search waypoint until the rover turns to the target, or -1 if it
+    // never does.
+    double timeToFind( const NavConfig& config, const Scenario& scenario, unsigned seed )
+    {
+        Simulation simulation( config, scenario, seed );
+        double searchStart = -1;
+        while( !simulation.finished() )
+        {
+            simulation.step();
+            if( searchStart < 0 && simulation.navState() == "Search Spin" )
+            {
+                searchStart = simulation.result().time;
+            }
+            if( searchStart >= 0 && simulation.navState() == "Turn to Target" )
+            {
+                return simulation.result().time - searchStart;
+            }
+        }
+        return -1;
+    } // timeToFind()
+} // namespace
+
+// Compares how long the searches take to find a target hidden near the
+// first search waypoint of a scenario. Every mission hides the target
+// at a point drawn from the probability map's prior, a gaussian around
+// the waypoint cut off at the search's bail threshold, and runs each
+// search alone against it with the same sensor noise. Uses the default
+// nav config as the base unless a config file is given.
+int main( int argc, char** argv )
+{
+    if( argc < 2 || argc > 4 )
+    {
+        cerr << "Usage: " << argv[ 0 ] << " <scenario.json> [missions] [config_nav/config.json]\n";
+        return 1;
+    }
+
+    Scenario scenario;
+    string error;
+    if( !loadScenario( argv[ 1 ], scenario, error ) )
+    {
+        cerr << "Error: invalid scenario: " << error << "\n";
+        return 1;
+    }
+    auto searchWaypoint = find_if( scenario.waypoints.begin(), scenario.waypoints.end(),
+                                   []( const ScenarioWaypoint& waypoint ) { return waypoint.search; } );
+    if( searchWaypoint == scenario.waypoints.end() )
+    {
+        cerr << "Error: the scenario has no search waypoint\n";
+        return 1;
+    }
+    const int missions = argc > 2 ? atoi( argv[ 2 ] ) : 40;
+    if( missions <= 0 )
+    {
+        cerr << "Error: missions must be positive\n";
+        return 1;
+    }
+    NavConfig config;
+    if( argc == 4 )
+    {
+        NavConfigWatcher configLoader( argv[ 3 ] );
+        if( !configLoader.load( config, error ) )
+        {
+            cerr << "Error: invalid nav config " << argv[ 3 ] << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    // Nav's own logging would bury the summary.
+    streambuf* errorBuffer = cerr.rdbuf( nullptr );
+    vector<double> times[ SEARCH_COUNT ];
+    mt19937 generator( 1 );
+    normal_distribution<double> offset( 0, config.probabilityMap.spread );
+    for( int mission = 0; mission < missions; ++mission )
+    {
+        LocalPoint hidden;
+        do
+        {
+            hidden = { offset( generator ), offset( generator ) };
+        } while( hypot( hidden.x, hidden.y ) > config.search.bailThresh );
+        scenario.targets = { { { searchWaypoint->position.x + hidden.x, searchWaypoint->position.y + hidden.y },
+                               searchWaypoint->id } };
+
+        for( size_t i = 0; i < SEARCH_COUNT; ++i )
+        {
+            NavConfig searchConfig = config;
+            searchConfig.search.order = { SEARCHES[ i ].order };
+            searchConfig.search.numSearches = 1;
+            const double time = timeToFind( searchConfig, scenario, mission );
+            if( time >= 0 )
+            {
+                times[ i ].push_back( time );
+            }
+        }
+    }
+    cerr.rdbuf( errorBuffer );
+    cerr.clear();
+
+    printf( "%d targets within %g m of the search waypoint, spread %g m\n", missions,
+            config.search.bailThresh, config.probabilityMap.spread );
+    for( size_t i = 0; i < SEARCH_COUNT; ++i )
+    {
+        vector<double>& found = times[ i ];
+        sort( found.begin(), found.end() );
+        printf( "%s: found %zu/%d", SEARCHES[ i ].name, found.size(), missions );
+        if( !found.empty() )
+        {
+            double total = 0;
+            for( double time : found )
+            {
+                total += time;
+            }
+            printf( ", time to find mean %.1f s, median %.1f s, p90 %.1f s, worst %.1f s",
+                    total / found.size(), percentile( found, 0.5 ), percentile( found, 0.9 ), found.back() );
+        }
+        printf( "\n" );
+    }
+    return 0;
+} // main()
@@ -0,0 +1,385 @@
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "rover_msgs/AutonState.hpp"
+#include "rover_msgs/Course.hpp"
+#include "rover_msgs/RadioSignalStrength.hpp"
+#include "utilities.hpp"
+
+namespace
+{
+    // Clearance kept on each side of the rover when checking whether a
+    // heading is clear of obstacles, in meters.
+    const double OBSTACLE_PADDING = 0.25;
+
+    // Resolution of the search for a clear heading, in degrees.
+    const double CLEAR_PATH_STEP = 1;
+
+    // Gets the bearing of dest relative to a rover at start facing
+    // bearing, in degrees in [-180, 180).
+    double relativeBearing( const LocalPoint& start, double bearing, const LocalPoint& dest )
+    {
+        return mod( planarBearing( start, dest ) - bearing + 180, 360 ) - 180;
+    } // relativeBearing()
+} // namespace
+
+// Constructs a Simulation of scenario with a nav state machine running
+// config. seed seeds the sensor noise. The course is sent and the rover
+// turned on right away, so the first step starts the mission.
+Simulation::Simulation( const NavConfig& config, const Scenario& scenario, unsigned seed )
+    : mScenario( scenario )
+    , mTimeStep( 1.0 / config.controlLoop.rate )
+    , mClock()
+    , mLcmObject( "memq://" )
+    , mStateMachine( mLcmObject, config, mClock )
+    , mLcmHandlers( &mStateMachine )
+    , mProjection( scenario.origin )
+    , mPosition( scenario.start )
+    , mBearing( scenario.startBearing )
+    , mSpeed( 0 )
+    , mBlocked( false )
+    , mRandom( seed )
+    , mJoystick()
+    , mNextFrameTime( 0 )
+    , mFrameTargets()
+    , mFrameCaptured( false )
+{
+    mLcmHandlers.subscribe( mLcmObject );
+    mLcmObject.subscribe( config.lcmChannels.joystickChannel, &Simulation::joystick, this );
+    mLcmObject.subscribe( config.lcmChannels.navStatusChannel, &Simulation::navStatus, this );
+    publishMission();
+} // Simulation()
+
+// Steps the simulation until nav is done or the time limit is reached.
+const SimulationResult& Simulation::run()
+{
+    while( !finished() )
+    {
+        step();
+    }
+    return mResult;
+} // run()
+
+// Advances the simulation by one tick of the state machine.
+void Simulation::step()
+{
+    publishSensors();
+    drainLcm();
+    mStateMachine.run();
+    drainLcm();
+
+    move( mTimeStep );
+    mClock.advance( mTimeStep );
+    mResult.time += mTimeStep;
+    ++mResult.ticks;
+    mResult.completed = mNavState == "Done";
+} // step()
+
+// Returns true if nav is done or the time limit has been reached.
+bool Simulation::finished() const
+{
+    return mResult.completed || mResult.time >= mScenario.timeLimit;
+} // finished()
+
+// Gets the outcome of the mission so far.
+const SimulationResult& Simulation::result() const
+{
+    return mResult;
+} // result()
+
+// Gets the rover's position on the local plane.
+const LocalPoint& Simulation::position() const
+{
+    return mPosition;
+} // position()
+
+// Gets the rover's bearing in degrees.
+double Simulation::bearing() const
+{
+    return mBearing;
+} // bearing()
+
+// Gets the last nav state nav published.
+const string& Simulation::navState() const
+{
+    return mNavState;
+} // navState()
+
+// Records every lcm message of the simulation, nav's inputs and its
+// outputs, to an lcm event log at path, stamped with the simulated time
+// the way lcm-logger stamps them on the rover. Must be called before the
+// first step. Returns false if the log cannot be written.
+bool Simulation::record( const string& path )
+{
+    mLog.reset( new lcm::LogFile( path, "w" ) );
+    if( !mLog->good() )
+    {
+        mLog.reset();
+        return false;
+    }
+    mLcmObject.subscribe( ".*", &Simulation::logEvent, this );
+    return true;
+} // record()
+
+// Publishes the scenario's course and radio signal and turns the rover
+// on.
+void Simulation::publishMission()
+{
+    Course course;
+    course.num_waypoints = mScenario.waypoints.size();
+    course.hash = 1;
+    for( const ScenarioWaypoint& scenarioWaypoint : mScenario.waypoints )
+    {
+        Waypoint waypoint;
+        waypoint.search = scenarioWaypoint.search;
+        waypoint.gate = scenarioWaypoint.gate;
+        waypoint.gate_width = scenarioWaypoint.gateWidth;
+        waypoint.id = scenarioWaypoint.id;
+        waypoint.odom = mProjection.toOdometry( scenarioWaypoint.position );
+        course.waypoints.push_back( waypoint );
+    }
+    mLcmObject.publish( "/course", &course );
+
+    RadioSignalStrength radio;
+    radio.signal_strength = mScenario.radioSignalStrength;
+    mLcmObject.publish( "/radio", &radio );
+
+    AutonState autonState;
+    autonState.is_auton = true;
+    mLcmObject.publish( "/auton", &autonState );
+} // publishMission()
+
+// Publishes what the rover currently senses. With a frame period the
+// targets are published the way perception publishes them, a frame
+// period after their frame was captured.
+void Simulation::publishSensors()
+{
+    const LocalPoint sensedPosition = { mPosition.x + noise( mScenario.noise.position ),
+                                        mPosition.y + noise( mScenario.noise.position ) };
+    Odometry odometry = mProjection.toOdometry( sensedPosition );
+    odometry.bearing_deg = mod( mBearing + noise( mScenario.noise.bearing ), 360 );
+    odometry.speed = mSpeed;
+    mLcmObject.publish( "/odometry", &odometry );
+
+    Obstacle obstacle = senseObstacle();
+    mLcmObject.publish( "/obstacle", &obstacle );
+
+    if( mScenario.perception.framePeriod <= 0 )
+    {
+        TargetList targetList = senseTargets();
+        mLcmObject.publish( "/target_list", &targetList );
+    }
+    else if( mClock.now() >= mNextFrameTime )
+    {
+        if( mFrameCaptured )
+        {
+            mLcmObject.publish( "/target_list", &mFrameTargets );
+        }
+        mFrameTargets = senseTargets();
+        mFrameCaptured = true;
+        mNextFrameTime += mScenario.perception.framePeriod;
+    }
+} // publishSensors()
+
+// Computes the obstacle message the way perception does: if the path
+// ahead is clear the distance is -1. Otherwise it is the distance to the
+// closest visible obstacle and the bearing is the smallest turn, in
+// degrees relative to the rover, to a clear heading.
+Obstacle Simulation::senseObstacle()
+{
+    Obstacle obstacle;
+    obstacle.distance = -1;
+    obstacle.bearing = 0;
+    if( isPathClear( mBearing ) )
+    {
+        return obstacle;
+    }
+
+    const double halfFieldOfView = mScenario.perception.fieldOfViewAngle / 2;
+    double closest = mScenario.perception.obstacleDepth;
+    for( const ScenarioObstacle& scenarioObstacle : mScenario.obstacles )
+    {
+        double distance = planarDistance( mPosition, scenarioObstacle.position ) - scenarioObstacle.radius;
+        if( fabs( relativeBearing( mPosition, mBearing, scenarioObstacle.position ) ) <= halfFieldOfView )
+        {
+            closest = min( closest, max( 0.0, distance ) );
+        }
+    }
+    obstacle.distance = max( 0.0, closest + noise( mScenario.noise.obstacleDistance ) );
+
+    obstacle.bearing = halfFieldOfView;
+    for( double angle = CLEAR_PATH_STEP; angle <= halfFieldOfView; angle += CLEAR_PATH_STEP )
+    {
+        if( isPathClear( mBearing + angle ) )
+        {
+            obstacle.bearing = angle;
+            break;
+        }
+        if( isPathClear( mBearing - angle ) )
+        {
+            obstacle.bearing = -angle;
+            break;
+        }
+    }
+    return obstacle;
+} // senseObstacle()
+
+// Computes the target list: the two closest targets within the field of
+// view and the target depth that perception does not drop. Unused
+// entries have a distance of -1.
+TargetList Simulation::senseTargets()
+{
+    TargetList targetList;
+    for( Target& target : targetList.targetList )
+    {
+        target.distance = -1;
+        target.bearing = 0;
+        target.id = -1;
+    }
+
+    for( const ScenarioTarget& scenarioTarget : mScenario.targets )
+    {
+        double distance = planarDistance( mPosition, scenarioTarget.position );
+        double bearing = relativeBearing( mPosition, mBearing, scenarioTarget.position );
+        if( distance > mScenario.perception.targetDepth ||
+            fabs( bearing ) > mScenario.perception.fieldOfViewAngle / 2 ||
+            dropped( mScenario.perception.targetDropout ) )
+        {
+            continue;
+        }
+        distance = max( 0.0, distance + noise( mScenario.noise.targetDistance ) );
+        bearing += noise( mScenario.noise.targetBearing );
+        Target seen;
+        seen.distance = distance;
+        seen.bearing = bearing;
+        seen.id = scenarioTarget.id;
+        if( targetList.targetList[ 0 ].distance < 0 || distance < targetList.targetList[ 0 ].distance )
+        {
+            targetList.targetList[ 1 ] = targetList.targetList[ 0 ];
+            targetList.targetList[ 0 ] = seen;
+        }
+        else if( targetList.targetList[ 1 ].distance < 0 || distance < targetList.targetList[ 1 ].distance )
+        {
+            targetList.targetList[ 1 ] = seen;
+        }
+    }
+    return targetList;
+} // senseTargets()
+
+// Draws gaussian noise with the given standard deviation. Draws nothing
+// when the deviation is zero so noiseless scenarios do not pay for it.
+double Simulation::noise( double standardDeviation )
+{
+    if( standardDeviation <= 0 )
+    {
+        return 0;
+    }
+    return normal_distribution<double>( 0, standardDeviation )( mRandom );
+} // noise()
+
+// Returns true with the given probability. Draws nothing when the
+// probability is zero.
+bool Simulation::dropped( double probability )
+{
+    if( probability <= 0 )
+    {
+        return false;
+    }
+    return uniform_real_distribution<double>( 0, 1 )( mRandom ) < probability;
+} // dropped()
+
+// Returns true if a corridor as wide as the rover plus padding, starting
+// at the rover and extending the obstacle depth along bearing, does not
+// touch any obstacle.
+bool Simulation::isPathClear( double bearing ) const
+{
+    const double bearingRadians = degreeToRadian( bearing );
+    const double halfWidth = mScenario.rover.width / 2 + OBSTACLE_PADDING;
+    for( const ScenarioObstacle& obstacle : mScenario.obstacles )
+    {
+        const double dx = obstacle.position.x - mPosition.x;
+        const double dy = obstacle.position.y - mPosition.y;
+        const double along = dx * sin( bearingRadians ) + dy * cos( bearingRadians );
+        const double across = dx * cos( bearingRadians ) - dy * sin( bearingRadians );
+        if( along > -obstacle.radius &&
+            along - obstacle.radius < mScenario.perception.obstacleDepth &&
+            fabs( across ) < obstacle.radius + halfWidth )
+        {
+            return false;
+        }
+    }
+    return true;
+} // isPathClear()
+
+// Returns true if a rover at position overlaps an obstacle.
+bool Simulation::isColliding( const LocalPoint& position ) const
+{
+    for( const ScenarioObstacle& obstacle : mScenario.obstacles )
+    {
+        if( planarDistance( position, obstacle.position ) < obstacle.radius + mScenario.rover.width / 2 )
+        {
+            return true;
+        }
+    }
+    return false;
+} // isColliding()
+
+// Drives the rover model with the last joystick command for seconds. The
+// rover moves along the chord of the arc it turns through. A move that
+// would run into an obstacle is not made.
+void Simulation::move( double seconds )
+{
+    // dampen is -1 for full power and 1 for no power.
+    const double power = mJoystick.kill ? 0 : ( 1 - mJoystick.dampen ) / 2;
+    const double turn = mScenario.rover.turnSpeed * mJoystick.left_right * power * seconds;
+    mSpeed = mScenario.rover.driveSpeed * mJoystick.forward_back * power;
+
+    const double distance = mSpeed * seconds;
+    const LocalPoint next = offsetPoint( mPosition, mBearing + turn / 2, distance );
+    const bool blocked = distance != 0 && isColliding( next );
+    if( blocked )
+    {
+        mResult.collisions += !mBlocked;
+        mSpeed = 0;
+    }
+    else
+    {
+        mResult.distance += fabs( distance );
+        mPosition = next;
+    }
+    mBlocked = blocked;
+    mBearing = mod( mBearing + turn, 360 );
+} // move()
+
+// Handles every lcm message that is waiting.
+void Simulation::drainLcm()
+{
+    while( mLcmObject.handleTimeout( 0 ) > 0 ) {}
+} // drainLcm()
+
+// Records the joystick command nav published.
+void Simulation::joystick( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                           const Joystick* joystick )
+{
+    mJoystick = *joystick;
+} // joystick()
+
+// Records the nav state and progress nav published.
+void Simulation::navStatus( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                            const NavStatus* navStatus )
+{
+    mNavState = navStatus->nav_state_name;
+    mResult.completedWaypoints = navStatus->completed_wps;
+} // navStatus()
+
+// Writes an lcm message to the event log.
+void Simulation::logEvent( const lcm::ReceiveBuffer* receiveBuffer, const string& channel )
+{
+    lcm::LogEvent event;
+    event.timestamp = llround( mClock.now() * 1e6 );
+    event.channel = channel;
+    event.datalen = receiveBuffer->data_size;
+    event.data = receiveBuffer->data;
+    mLog->writeEvent( &event );
+} // logEvent()
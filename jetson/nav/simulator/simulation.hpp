@@ -0,0 +1,158 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <memory>
+#include <random>
+#include <string>
+#include <lcm/lcm-cpp.hpp>
+#include "rover_msgs/Joystick.hpp"
+#include "rover_msgs/NavStatus.hpp"
+#include "rover_msgs/Obstacle.hpp"
+#include "rover_msgs/TargetList.hpp"
+#include "clock.hpp"
+#include "lcmHandlers.hpp"
+#include "localProjection.hpp"
+#include "navConfig.hpp"
+#include "stateMachine.hpp"
+#include "scenario.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// The outcome of a simulated mission.
+struct SimulationResult
+{
+    // Whether nav reached the Done state within the time limit.
+    bool completed = false;
+
+    // Simulated seconds and state machine ticks until the mission ended.
+    double time = 0;
+    int ticks = 0;
+
+    // Number of waypoints nav reported as completed.
+    int completedWaypoints = 0;
+
+    // Meters the rover drove.
+    double distance = 0;
+
+    // Number of times the rover ran into an obstacle.
+    int collisions = 0;
+};
+
+// This class runs the real nav state machine against a kinematic model
+// of the rover. Each step publishes the odometry, obstacle and target
+// messages the rover would see over an in-process lcm, runs the state
+// machine once and drives the model with the joystick command it
+// published. Time is virtual and the sensor noise is drawn from a seeded
+// generator, so a mission runs as fast as the state machine does and is
+// reproducible.
+class Simulation
+{
+public:
+    Simulation( const NavConfig& config, const Scenario& scenario, unsigned seed = 0 );
+
+    const SimulationResult& run();
+
+    void step();
+
+    bool finished() const;
+
+    const SimulationResult& result() const;
+
+    const LocalPoint& position() const;
+
+    double bearing() const;
+
+    const string& navState() const;
+
+    bool record( const string& path );
+
+private:
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    void publishMission();
+
+    void publishSensors();
+
+    Obstacle senseObstacle();
+
+    TargetList senseTargets();
+
+    double noise( double standardDeviation );
+
+    bool dropped( double probability );
+
+    bool isPathClear( double bearing ) const;
+
+    bool isColliding( const LocalPoint& position ) const;
+
+    void move( double seconds );
+
+    void drainLcm();
+
+    void joystick( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                   const Joystick* joystick );
+
+    void navStatus( const lcm::ReceiveBuffer* receiveBuffer, const string& channel,
+                    const NavStatus* navStatus );
+
+    void logEvent( const lcm::ReceiveBuffer* receiveBuffer, const string& channel );
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+
+    // The simulated mission.
+    Scenario mScenario;
+
+    // Seconds of virtual time per tick of the state machine.
+    double mTimeStep;
+
+    // The time nav reads.
+    VirtualClock mClock;
+
+    // In-process lcm connecting the simulation and nav.
+    lcm::LCM mLcmObject;
+
+    // The nav state machine under test.
+    StateMachine mStateMachine;
+
+    // Forwards lcm messages to mStateMachine.
+    LcmHandlers mLcmHandlers;
+
+    // Converts between the scenario's local plane and odometry.
+    LocalProjection mProjection;
+
+    // The rover's position and bearing in degrees.
+    LocalPoint mPosition;
+    double mBearing;
+
+    // The rover's current forward speed in meters per second.
+    double mSpeed;
+
+    // Whether the rover was blocked by an obstacle on the last step.
+    bool mBlocked;
+
+    // Source of the sensor noise.
+    mt19937 mRandom;
+
+    // The last joystick command nav published.
+    Joystick mJoystick;
+
+    // The last nav state nav published.
+    string mNavState;
+
+    // Clock time the next frame is captured at, and the targets in the
+    // frame being processed, if there is one.
+    double mNextFrameTime;
+    TargetList mFrameTargets;
+    bool mFrameCaptured;
+
+    // Event log every lcm message is recorded to, or nullptr.
+    unique_ptr<lcm::LogFile> mLog;
+
+    SimulationResult mResult;
+};
+
+#endif // SIMULATION_HPP
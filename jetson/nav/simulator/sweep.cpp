@@ -0,0 +1,220 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    // Gets a reference to a value of a nav config by name.
+    struct ConfigValue
+    {
+        const char* name;
+        double& ( *get )( NavConfig& config );
+    };
+
+    // The nav config values a sweep can vary.
+    const ConfigValue CONFIG_VALUES[] =
+    {
+        { "bearingPid.kP", []( NavConfig& c ) -> double& { return c.bearingPid.kP; } },
+        { "bearingPid.kI", []( NavConfig& c ) -> double& { return c.bearingPid.kI; } },
+        { "bearingPid.kD", []( NavConfig& c ) -> double& { return c.bearingPid.kD; } },
+        { "bearingPid.derivativeFilter", []( NavConfig& c ) -> double& { return c.bearingPid.derivativeFilter; } },
+        { "distancePid.kP", []( NavConfig& c ) -> double& { return c.distancePid.kP; } },
+        { "distancePid.kI", []( NavConfig& c ) -> double& { return c.distancePid.kI; } },
+        { "distancePid.kD", []( NavConfig& c ) -> double& { return c.distancePid.kD; } },
+        { "distancePid.derivativeFilter", []( NavConfig& c ) -> double& { return c.distancePid.derivativeFilter; } },
+        { "navThresholds.turningBearing", []( NavConfig& c ) -> double& { return c.navThresholds.turningBearing; } },
+        { "navThresholds.drivingBearing", []( NavConfig& c ) -> double& { return c.navThresholds.drivingBearing; } },
+        { "navThresholds.waypointDistance", []( NavConfig& c ) -> double& { return c.navThresholds.waypointDistance; } },
+        { "navThresholds.targetDistance", []( NavConfig& c ) -> double& { return c.navThresholds.targetDistance; } },
+        { "navThresholds.minTurningEffort", []( NavConfig& c ) -> double& { return c.navThresholds.minTurningEffort; } },
+        { "navThresholds.gateCenteredAngleDiff", []( NavConfig& c ) -> double& { return c.navThresholds.gateCenteredAngleDiff; } },
+        { "pathFollowing.lookahead", []( NavConfig& c ) -> double& { return c.pathFollowing.lookahead; } },
+        { "computerVision.visionDistance", []( NavConfig& c ) -> double& { return c.computerVision.visionDistance; } },
+        { "search.bailThresh", []( NavConfig& c ) -> double& { return c.search.bailThresh; } },
+        { "search.searchWaitStepSize", []( NavConfig& c ) -> double& { return c.search.searchWaitStepSize; } },
+        { "search.searchWaitTime", []( NavConfig& c ) -> double& { return c.search.searchWaitTime; } },
+        { "search.framesPerBearing", []( NavConfig& c ) -> double& { return c.search.framesPerBearing; } },
+        { "costmap.decayTime", []( NavConfig& c ) -> double& { return c.costmap.decayTime; } },
+        { "costmap.hitIncrement", []( NavConfig& c ) -> double& { return c.costmap.hitIncrement; } },
+        { "costmap.missDecrement", []( NavConfig& c ) -> double& { return c.costmap.missDecrement; } },
+        { "costmap.occupiedThreshold", []( NavConfig& c ) -> double& { return c.costmap.occupiedThreshold; } },
+        { "costmap.clearDepth", []( NavConfig& c ) -> double& { return c.costmap.clearDepth; } },
+        { "targetTracker.processNoise", []( NavConfig& c ) -> double& { return c.targetTracker.processNoise; } },
+        { "targetTracker.gate", []( NavConfig& c ) -> double& { return c.targetTracker.gate; } },
+        { "targetTracker.coastTime", []( NavConfig& c ) -> double& { return c.targetTracker.coastTime; } },
+        { "probabilityMap.spread", []( NavConfig& c ) -> double& { return c.probabilityMap.spread; } },
+        { "probabilityMap.detectionProbability", []( NavConfig& c ) -> double& { return c.probabilityMap.detectionProbability; } },
+        { "probabilityMap.giveUp", []( NavConfig& c ) -> double& { return c.probabilityMap.giveUp; } }
+    };
+
+    // Finds the config value with the given name. Returns nullptr if
+    // there is none.
+    const ConfigValue* findConfigValue( const string& name )
+    {
+        for( const ConfigValue& value : CONFIG_VALUES )
+        {
+            if( name == value.name )
+            {
+                return &value;
+            }
+        }
+        return nullptr;
+    } // findConfigValue()
+
+    // Runs mission number index of the sweep. The mission's parameters
+    // and noise only depend on the sweep's seed and index, not on which
+    // thread runs it.
+    MissionResult runMission( const NavConfig& baseConfig, const Scenario& scenario,
+                              const SweepSpec& spec, int index )
+    {
+        seed_seq seeds = { spec.seed, static_cast<unsigned>( index ) };
+        mt19937 random( seeds );
+
+        NavConfig config = baseConfig;
+        MissionResult mission;
+        for( const SweepParameter& parameter : spec.parameters )
+        {
+            double value = uniform_real_distribution<double>( parameter.min, parameter.max )( random );
+            findConfigValue( parameter.name )->get( config ) = value;
+            mission.parameters.push_back( value );
+        }
+        mission.noiseSeed = random();
+
+        Simulation simulation( config, scenario, mission.noiseSeed );
+        mission.result = simulation.run();
+        return mission;
+    } // runMission()
+} // namespace
+
+// Validates the json sweep and copies it into spec. Returns false and
+// leaves spec untouched if a value is missing, has the wrong type or
+// names a config value that cannot be swept.
+bool parseSweepSpec( const rapidjson::Value& json, SweepSpec& spec, string& error )
+{
+    if( !json.IsObject() || !json.HasMember( "missions" ) || !json[ "missions" ].IsInt() ||
+        json[ "missions" ].GetInt() < 1 )
+    {
+        error = "\"missions\" must be a positive integer";
+        return false;
+    }
+    SweepSpec parsed;
+    parsed.missions = json[ "missions" ].GetInt();
+    if( json.HasMember( "seed" ) )
+    {
+        if( !json[ "seed" ].IsUint() )
+        {
+            error = "\"seed\" is not an unsigned integer";
+            return false;
+        }
+        parsed.seed = json[ "seed" ].GetUint();
+    }
+    if( json.HasMember( "threads" ) )
+    {
+        if( !json[ "threads" ].IsInt() || json[ "threads" ].GetInt() < 0 )
+        {
+            error = "\"threads\" is not a non-negative integer";
+            return false;
+        }
+        parsed.threads = json[ "threads" ].GetInt();
+    }
+    if( json.HasMember( "output" ) )
+    {
+        if( !json[ "output" ].IsString() )
+        {
+            error = "\"output\" is not a string";
+            return false;
+        }
+        parsed.output = json[ "output" ].GetString();
+    }
+
+    if( !json.HasMember( "parameters" ) || !json[ "parameters" ].IsObject() )
+    {
+        error = "missing section \"parameters\"";
+        return false;
+    }
+    for( const auto& member : json[ "parameters" ].GetObject() )
+    {
+        SweepParameter parameter;
+        parameter.name = member.name.GetString();
+        if( !findConfigValue( parameter.name ) )
+        {
+            error = "\"" + parameter.name + "\" cannot be swept";
+            return false;
+        }
+        const rapidjson::Value& range = member.value;
+        if( !range.IsArray() || range.Size() != 2 || !range[ 0 ].IsNumber() ||
+            !range[ 1 ].IsNumber() || range[ 0 ].GetDouble() > range[ 1 ].GetDouble() )
+        {
+            error = "\"" + parameter.name + "\" is not a [min, max] range";
+            return false;
+        }
+        parameter.min = range[ 0 ].GetDouble();
+        parameter.max = range[ 1 ].GetDouble();
+        parsed.parameters.push_back( parameter );
+    }
+    spec = parsed;
+    return true;
+} // parseSweepSpec()
+
+// Reads and parses the sweep file at path.
+bool loadSweepSpec( const string& path, SweepSpec& spec, string& error )
+{
+    ifstream file( path );
+    if( !file )
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    stringstream contents;
+    contents << file.rdbuf();
+    rapidjson::Document json;
+    json.Parse( contents.str().c_str() );
+    if( json.HasParseError() )
+    {
+        error = "invalid json in " + path;
+        return false;
+    }
+    return parseSweepSpec( json, spec, error );
+} // loadSweepSpec()
+
+// Runs every mission of the sweep on scenario, starting from baseConfig.
+// Each mission has its own state machine, so the missions are spread
+// over the worker threads. Returns the results in mission order.
+vector<MissionResult> runSweep( const NavConfig& baseConfig, const Scenario& scenario,
+                                const SweepSpec& spec )
+{
+    vector<MissionResult> missions( spec.missions );
+    atomic<int> nextMission( 0 );
+    auto worker = [&]()
+    {
+        for( int index = nextMission++; index < spec.missions; index = nextMission++ )
+        {
+            missions[ index ] = runMission( baseConfig, scenario, spec, index );
+        }
+    };
+
+    const int numThreads = spec.threads > 0 ? spec.threads
+                                            : max( 1, static_cast<int>( thread::hardware_concurrency() ) );
+    vector<thread> threads;
+    for( int i = 0; i < numThreads; ++i )
+    {
+        threads.emplace_back( worker );
+    }
+    for( thread& workerThread : threads )
+    {
+        workerThread.join();
+    }
+    return missions;
+} // runSweep()
+
+// Gets the value below which fraction of the sorted values lie. sorted
+// must not be empty.
+double percentile( const vector<double>& sorted, double fraction )
+{
+    return sorted[ static_cast<size_t>( fraction * ( sorted.size() - 1 ) ) ];
+} // percentile()
@@ -0,0 +1,63 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <string>
+#include <vector>
+#include "rapidjson/document.h"
+#include "navConfig.hpp"
+#include "scenario.hpp"
+#include "simulation.hpp"
+
+using namespace std;
+
+// A nav config value varied by a sweep. Every mission samples it
+// uniformly from [min, max].
+struct SweepParameter
+{
+    // Name of the value in config.json, e.g. "bearingPid.kP".
+    string name;
+    double min;
+    double max;
+};
+
+// Description of a batch of simulated missions.
+struct SweepSpec
+{
+    // Number of missions to run.
+    int missions = 100;
+
+    // Seeds the parameters and sensor noise of every mission, so a
+    // sweep can be reproduced.
+    unsigned seed = 1;
+
+    // Number of worker threads. Zero uses one per core.
+    int threads = 0;
+
+    vector<SweepParameter> parameters;
+
+    // Path of a csv file to write every mission to. Empty for none.
+    string output;
+};
+
+// The outcome of one mission of a sweep.
+struct MissionResult
+{
+    // Seed of the mission's sensor noise.
+    unsigned noiseSeed;
+
+    // Sampled values, in the order of SweepSpec::parameters.
+    vector<double> parameters;
+
+    SimulationResult result;
+};
+
+bool parseSweepSpec( const rapidjson::Value& json, SweepSpec& spec, string& error );
+
+bool loadSweepSpec( const string& path, SweepSpec& spec, string& error );
+
+vector<MissionResult> runSweep( const NavConfig& baseConfig, const Scenario& scenario,
+                                const SweepSpec& spec );
+
+double percentile( const vector<double>& sorted, double fraction );
+
+#endif // SWEEP_HPP
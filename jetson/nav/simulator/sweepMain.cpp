@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "navConfigWatcher.hpp"
+#include "scenario.hpp"
+#include "sweep.hpp"
+
+using namespace std;
+
+namespace
+{
+    // Writes every mission of the sweep to a csv file.
+    bool writeCsv( const string& path, const SweepSpec& spec, const vector<MissionResult>& missions )
+    {
+        ofstream csv( path );
+        if( !csv )
+        {
+            return false;
+        }
+        csv << "mission,noise_seed,completed,time,waypoints,distance,collisions";
+        for( const SweepParameter& parameter : spec.parameters )
+        {
+            csv << "," << parameter.name;
+        }
+        csv << "\n";
+        for( size_t i = 0; i < missions.size(); ++i )
+        {
+            const MissionResult& mission = missions[ i ];
+            csv << i << "," << mission.noiseSeed << "," << mission.result.completed << ","
+                << mission.result.time << "," << mission.result.completedWaypoints << ","
+                << mission.result.distance << "," << mission.result.collisions;
+            for( double value : mission.parameters )
+            {
+                csv << "," << value;
+            }
+            csv << "\n";
+        }
+        return true;
+    } // writeCsv()
+
+    // Prints the success rate, the distribution of completion times and
+    // the parameters of the fastest missions.
+    void printSummary( const SweepSpec& spec, const vector<MissionResult>& missions )
+    {
+        vector<const MissionResult*> completed;
+        int withCollisions = 0;
+        for( const MissionResult& mission : missions )
+        {
+            if( mission.result.completed )
+            {
+                completed.push_back( &mission );
+            }
+            withCollisions += mission.result.collisions > 0;
+        }
+        printf( "Completed %zu/%zu missions (%.1f%%), %d with collisions\n", completed.size(),
+                missions.size(), 100.0 * completed.size() / missions.size(), withCollisions );
+        if( completed.empty() )
+        {
+            return;
+        }
+
+        sort( completed.begin(), completed.end(), []( const MissionResult* a, const MissionResult* b )
+        {
+            return a->result.time < b->result.time;
+        } );
+        vector<double> times;
+        double total = 0;
+        for( const MissionResult* mission : completed )
+        {
+            times.push_back( mission->result.time );
+            total += mission->result.time;
+        }
+        printf( "Completion time: mean %.1f s, p10 %.1f s, median %.1f s, p90 %.1f s\n",
+                total / times.size(), percentile( times, 0.1 ), percentile( times, 0.5 ),
+                percentile( times, 0.9 ) );
+
+        printf( "Fastest missions:\n%8s", "time" );
+        for( const SweepParameter& parameter : spec.parameters )
+        {
+            printf( "  %s", parameter.name.c_str() );
+        }
+        printf( "\n" );
+        for( size_t i = 0; i < min<size_t>( 5, completed.size() ); ++i )
+        {
+            printf( "%8.1f", completed[ i ]->result.time );
+            for( size_t j = 0; j < spec.parameters.size(); ++j )
+            {
+                printf( "  %*.4g", static_cast<int>( spec.parameters[ j ].name.size() ),
+                        completed[ i ]->parameters[ j ] );
+            }
+            printf( "\n" );
+        }
+    } // printSummary()
+} // namespace
+
+// Runs a batch of simulated missions of a scenario with randomized nav
+// parameters and sensor noise across all cores and reports how they
+// went. Uses the default nav config as the base unless a config file is
+// given.
+int main( int argc, char** argv )
+{
+    if( argc < 3 || argc > 4 )
+    {
+        cerr << "Usage: " << argv[ 0 ] << " <scenario.json> <sweep.json> [config_nav/config.json]\n";
+        return 1;
+    }
+
+    Scenario scenario;
+    SweepSpec spec;
+    string error;
+    if( !loadScenario( argv[ 1 ], scenario, error ) )
+    {
+        cerr << "Error: invalid scenario: " << error << "\n";
+        return 1;
+    }
+    if( !loadSweepSpec( argv[ 2 ], spec, error ) )
+    {
+        cerr << "Error: invalid sweep: " << error << "\n";
+        return 1;
+    }
+    NavConfig config;
+    if( argc == 4 )
+    {
+        NavConfigWatcher configLoader( argv[ 3 ] );
+        if( !configLoader.load( config, error ) )
+        {
+            cerr << "Error: invalid nav config " << argv[ 3 ] << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    // Nav's own logging would interleave across the missions.
+    streambuf* errorBuffer = cerr.rdbuf( nullptr );
+    auto start = chrono::steady_clock::now();
+    vector<MissionResult> missions = runSweep( config, scenario, spec );
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cerr.rdbuf( errorBuffer );
+    cerr.clear();
+
+    printf( "Ran %d missions on %u threads in %.2f s\n", spec.missions,
+            spec.threads > 0 ? spec.threads : max( 1u, thread::hardware_concurrency() ),
+            elapsed.count() );
+    printSummary( spec, missions );
+    if( !spec.output.empty() && !writeCsv( spec.output, spec, missions ) )
+    {
+        cerr << "Error: cannot write " << spec.output << "\n";
+        return 1;
+    }
+    return 0;
+} // main()
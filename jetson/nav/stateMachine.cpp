@@ -1,14 +1,11 @@
 #include "stateMachine.hpp"
 
-#include <fstream>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <cmath>
 #include <cstdlib>
-#include <map>
 
-#include "rover_msgs/NavStatus.hpp"
 #include "utilities.hpp"
 #include "search/spiralOutSearch.hpp"
 #include "search/spiralInSearch.hpp"
@@ -16,34 +13,140 @@
 #include "obstacle_avoidance/simpleAvoidance.hpp"
 #include "gate_search/diamondGateSearch.hpp"
 
-// Constructs a StateMachine object with the input lcm object.
-// Reads the configuartion file and constructs a Rover objet with this
-// and the lcmObject. Sets mStateChanged to true so that on the first
+namespace
+{
+    // Keeps the current value of a key that is only read when nav
+    // starts, logging that the reloaded config changed it.
+    template <typename T>
+    void keepStartupValue( const char* key, T& reloaded, const T& current )
+    {
+        if( !( reloaded == current ) )
+        {
+            cerr << "Warning: " << key << " only takes effect when nav restarts, keeping "
+                 << current << "\n";
+            reloaded = current;
+        }
+    } // keepStartupValue()
+
+    // Names of the nav states, indexed by the value of the state. Built
+    // at compile time so that naming a state is an array lookup.
+    struct NavStateNames
+    {
+        const char* names[ 256 ];
+    };
+
+    constexpr NavStateNames makeNavStateNames()
+    {
+        NavStateNames table = {};
+        for( const char*& name : table.names )
+        {
+            name = "Unknown";
+        }
+        table.names[ static_cast<int>( NavState::Off ) ] = "Off";
+        table.names[ static_cast<int>( NavState::Done ) ] = "Done";
+        table.names[ static_cast<int>( NavState::Turn ) ] = "Turn";
+        table.names[ static_cast<int>( NavState::Drive ) ] = "Drive";
+        table.names[ static_cast<int>( NavState::SearchFaceNorth ) ] = "Search Face North";
+        table.names[ static_cast<int>( NavState::SearchSpin ) ] = "Search Spin";
+        table.names[ static_cast<int>( NavState::SearchSpinWait ) ] = "Search Spin Wait";
+        table.names[ static_cast<int>( NavState::ChangeSearchAlg ) ] = "Change Search Algorithm";
+        table.names[ static_cast<int>( NavState::SearchTurn ) ] = "Search Turn";
+        table.names[ static_cast<int>( NavState::SearchDrive ) ] = "Search Drive";
+        table.names[ static_cast<int>( NavState::TurnToTarget ) ] = "Turn to Target";
+        table.names[ static_cast<int>( NavState::TurnedToTargetWait ) ] = "Turned to Target Wait";
+        table.names[ static_cast<int>( NavState::DriveToTarget ) ] = "Drive to Target";
+        table.names[ static_cast<int>( NavState::TurnAroundObs ) ] = "Turn Around Obstacle";
+        table.names[ static_cast<int>( NavState::DriveAroundObs ) ] = "Drive Around Obstacle";
+        table.names[ static_cast<int>( NavState::SearchTurnAroundObs ) ] = "Search Turn Around Obstacle";
+        table.names[ static_cast<int>( NavState::SearchDriveAroundObs ) ] = "Search Drive Around Obstacle";
+        table.names[ static_cast<int>( NavState::GateSpin ) ] = "Gate Spin";
+        table.names[ static_cast<int>( NavState::GateSpinWait ) ] = "Gate Spin Wait";
+        table.names[ static_cast<int>( NavState::GateTurn ) ] = "Gate Turn";
+        table.names[ static_cast<int>( NavState::GateDrive ) ] = "Gate Drive";
+        table.names[ static_cast<int>( NavState::GateTurnToCentPoint ) ] = "Gate Turn to Center Point";
+        table.names[ static_cast<int>( NavState::GateDriveToCentPoint ) ] = "Gate Drive to Center Point";
+        table.names[ static_cast<int>( NavState::GateFace ) ] = "Gate Face";
+        table.names[ static_cast<int>( NavState::GateShimmy ) ] = "Gate Shimmy";
+        table.names[ static_cast<int>( NavState::GateDriveThrough ) ] = "Gate Drive Through";
+        table.names[ static_cast<int>( NavState::RadioRepeaterTurn ) ] = "Radio Repeater Turn";
+        table.names[ static_cast<int>( NavState::RadioRepeaterDrive ) ] = "Radio Repeater Drive";
+        table.names[ static_cast<int>( NavState::RepeaterDropWait ) ] = "Radio Repeater Drop";
+        return table;
+    } // makeNavStateNames()
+
+    constexpr NavStateNames NAV_STATE_NAMES = makeNavStateNames();
+
+    // Gets the length of the longest state name.
+    constexpr size_t computeLongestNavStateName()
+    {
+        size_t longest = 0;
+        for( const char* name : NAV_STATE_NAMES.names )
+        {
+            size_t length = 0;
+            while( name[ length ] )
+            {
+                ++length;
+            }
+            longest = length > longest ? length : longest;
+        }
+        return longest;
+    } // computeLongestNavStateName()
+
+    constexpr size_t LONGEST_NAV_STATE_NAME = computeLongestNavStateName();
+
+    // Bytes of an encoded nav status with the longest state name: the
+    // type hash, the string's length, characters and terminator, and the
+    // two waypoint counts.
+    constexpr size_t NAV_STATUS_CAPACITY = 8 + 4 + LONGEST_NAV_STATE_NAME + 1 + 4 + 4;
+} // namespace
+
+// Gets the name of a nav state.
+const char* navStateName( NavState state )
+{
+    return NAV_STATE_NAMES.names[ static_cast<uint8_t>( state ) ];
+} // navStateName()
+
+// Gets the length of the longest nav state name.
+size_t longestNavStateName()
+{
+    return LONGEST_NAV_STATE_NAME;
+} // longestNavStateName()
+
+// Constructs a StateMachine object with the input lcm object,
+// configuration and clock. Constructs a Rover objet with this, the
+// lcmObject and the clock. Sets mStateChanged to true so that on the first
 // iteration of run the rover is updated.
-StateMachine::StateMachine( lcm::LCM& lcmObject )
+StateMachine::StateMachine( lcm::LCM& lcmObject, const NavConfig& config, const Clock& clock )
     : mPhoebe( nullptr )
     , mLcmObject( lcmObject )
+    , mRoverConfig( config )
+    , mPublishedState( NavState::Unknown )
+    , mNavStatusTime( 0 )
+    , mFlightRecorder( config.flightRecorder.capacity, config.lcmChannels.navStatusChannel,
+                       config.lcmChannels.joystickChannel )
+    , mCourseReceived( false )
     , mTotalWaypoints( 0 )
     , mCompletedWaypoints( 0 )
     , mRepeaterDropComplete ( false )
     , mStateChanged( true )
+    , mSearchFails( 0 )
+    , mSearchVisionDistance( config.computerVision.visionDistance )
+    , mSearchesPrepared( false )
+    , mPreparedCenter( { 0, 0 } )
+    , mSearchPlanner( this )
 {
-    ifstream configFile;
-    string configPath = getenv("MROVER_CONFIG");
-    configPath += "/config_nav/config.json";
-    configFile.open( configPath );
-    string config = "";
-    string setting;
-    while( configFile >> setting )
-    {
-        config += setting;
-    }
-    configFile.close();
-    mRoverConfig.Parse( config.c_str() );
-    mPhoebe = new Rover( mRoverConfig, lcmObject );
+    mPhoebe = new Rover( mRoverConfig, lcmObject, clock );
     mSearchStateMachine = SearchFactory( this, SearchType::SPIRALOUT );
     mGateStateMachine = GateFactory( this, mPhoebe, mRoverConfig );
-    mObstacleAvoidanceStateMachine = ObstacleAvoiderFactory( this, ObstacleAvoidanceAlgorithm::SimpleAvoidance );
+    // The avoidance algorithm is fixed once constructed; reloading the
+    // config does not replace it.
+    mObstacleAvoidanceStateMachine = ObstacleAvoiderFactory(
+        this, static_cast<ObstacleAvoidanceAlgorithm>( mRoverConfig.obstacleAvoidance.algorithm ), mRoverConfig );
+    // Room for every state name so publishing never allocates.
+    mNavStatus.nav_state_name.reserve( LONGEST_NAV_STATE_NAME );
+    mNavStatus.completed_wps = 0;
+    mNavStatus.total_wps = 0;
+    mNavStatusBuffer.resize( NAV_STATUS_CAPACITY );
 } // StateMachine()
 
 // Destructs the StateMachine object. Deallocates memory for the Rover
@@ -53,6 +156,49 @@ StateMachine::~StateMachine( )
     delete mPhoebe;
 }
 
+// Replaces the rover's configuration. The rover and the sub state
+// machines hold references to mRoverConfig, so they all see the new
+// values on the next iteration of run. Keys that size or choose what
+// was built when nav started (the costmap, obstacle avoidance, the
+// flight recorder and the lcm channels) keep their current values, and
+// a change to them is logged. Must be called between iterations of run.
+void StateMachine::updateConfig( const NavConfig& config )
+{
+    NavConfig reloaded = config;
+    keepStartupValue( "costmap.resolution", reloaded.costmap.resolution, mRoverConfig.costmap.resolution );
+    keepStartupValue( "costmap.size", reloaded.costmap.size, mRoverConfig.costmap.size );
+    keepStartupValue( "obstacleAvoidance.algorithm", reloaded.obstacleAvoidance.algorithm,
+                      mRoverConfig.obstacleAvoidance.algorithm );
+    keepStartupValue( "obstacleAvoidance.planningResolution", reloaded.obstacleAvoidance.planningResolution,
+                      mRoverConfig.obstacleAvoidance.planningResolution );
+    keepStartupValue( "obstacleAvoidance.planningSize", reloaded.obstacleAvoidance.planningSize,
+                      mRoverConfig.obstacleAvoidance.planningSize );
+    keepStartupValue( "flightRecorder.capacity", reloaded.flightRecorder.capacity,
+                      mRoverConfig.flightRecorder.capacity );
+    keepStartupValue( "flightRecorder.crashPath", reloaded.flightRecorder.crashPath,
+                      mRoverConfig.flightRecorder.crashPath );
+    keepStartupValue( "lcmChannels.navStatusChannel", reloaded.lcmChannels.navStatusChannel,
+                      mRoverConfig.lcmChannels.navStatusChannel );
+    keepStartupValue( "lcmChannels.repeaterDropInitChannel", reloaded.lcmChannels.repeaterDropInitChannel,
+                      mRoverConfig.lcmChannels.repeaterDropInitChannel );
+    keepStartupValue( "lcmChannels.repeaterDropCompleteChannel", reloaded.lcmChannels.repeaterDropCompleteChannel,
+                      mRoverConfig.lcmChannels.repeaterDropCompleteChannel );
+    keepStartupValue( "lcmChannels.joystickChannel", reloaded.lcmChannels.joystickChannel,
+                      mRoverConfig.lcmChannels.joystickChannel );
+    mRoverConfig = reloaded;
+    mPhoebe->distancePid().setGains( mRoverConfig.distancePid.kP,
+                                     mRoverConfig.distancePid.kI,
+                                     mRoverConfig.distancePid.kD );
+    mPhoebe->bearingPid().setGains( mRoverConfig.bearingPid.kP,
+                                    mRoverConfig.bearingPid.kI,
+                                    mRoverConfig.bearingPid.kD );
+    mPhoebe->distancePid().setDerivativeFilter( mRoverConfig.distancePid.derivativeFilter );
+    mPhoebe->bearingPid().setDerivativeFilter( mRoverConfig.bearingPid.derivativeFilter );
+    // Searches built ahead used the old values.
+    mSearchPlanner.cancel();
+    mSearchesPrepared = false;
+} // updateConfig()
+
 void StateMachine::setSearcher( SearchType type )
 {
     assert( mSearchStateMachine );
@@ -60,6 +206,52 @@ void StateMachine::setSearcher( SearchType type )
     mSearchStateMachine = SearchFactory( this, type );
 }
 
+// Gets the search pattern started at the search waypoint at the head of
+// the path once searchFails searches have failed.
+SearchPlan StateMachine::searchPlan( int searchFails ) const
+{
+    double visionDistance = mSearchVisionDistance;
+    for( int fails = mSearchFails; fails < searchFails; ++fails )
+    {
+        visionDistance = SearchPlanner::nextVisionDistance( fails, visionDistance );
+    }
+    return { SearchPlanner::searchType( mRoverConfig, searchFails ),
+             mPhoebe->projection().toLocal( mPhoebe->roverStatus().path().front().odom ),
+             visionDistance,
+             searchFails };
+} // searchPlan()
+
+// Asks the search planner for a round of the search order the first
+// time a search waypoint is at the head of the path, so the patterns
+// are built while the rover drives there. The searches prepared for a
+// search waypoint are discarded once it leaves the head of the path,
+// such as when the target is found there.
+void StateMachine::prepareSearches()
+{
+    const deque<Waypoint>& path = mPhoebe->roverStatus().path();
+    const bool atSearch = !path.empty() && path.front().search;
+    const LocalPoint center = atSearch ? mPhoebe->projection().toLocal( path.front().odom ) : LocalPoint{ 0, 0 };
+    if( mSearchesPrepared && atSearch && center.x == mPreparedCenter.x && center.y == mPreparedCenter.y )
+    {
+        return;
+    }
+    if( mSearchesPrepared )
+    {
+        mSearchPlanner.cancel();
+        mSearchesPrepared = false;
+    }
+    if( !atSearch )
+    {
+        return;
+    }
+    mSearchesPrepared = true;
+    mPreparedCenter = center;
+    for( int i = 0; i < mRoverConfig.search.numSearches; ++i )
+    {
+        mSearchPlanner.prepare( searchPlan( mSearchFails + i ), mRoverConfig );
+    }
+} // prepareSearches()
+
 void StateMachine::updateCompletedPoints( )
 {
     mCompletedWaypoints += 1;
@@ -94,11 +286,19 @@ void StateMachine::updateObstacleElements( double bearing, double distance )
     updateObstacleDistance( distance );
 }
 
+// Allows outside objects to set the point the rover was driving to
+// when it detected an obstacle.
+void StateMachine::updateObstacleDestination( const LocalPoint& destination )
+{
+    mObstacleAvoidanceStateMachine->updateDestination( destination );
+}
+
 // Runs the state machine through one iteration. The state machine will
 // run if the state has changed or if the rover's status has changed.
 // Will call the corresponding function based on the current state.
 void StateMachine::run()
 {
+    const NavState previousState = mPhoebe->roverStatus().currentState();
     publishNavState();
     if( isRoverReady() )
     {
@@ -115,8 +315,10 @@ void StateMachine::run()
                 mPhoebe->roverStatus().currentState() = nextState;
                 mStateChanged = true;
             }
+            recordFlight( previousState );
             return;
         }
+        prepareSearches();
         switch( mPhoebe->roverStatus().currentState() )
         {
             case NavState::Off:
@@ -175,38 +377,20 @@ void StateMachine::run()
 
             case NavState::ChangeSearchAlg:
             {
-                static int searchFails = 0;
-                static double visionDistance = mRoverConfig[ "computerVision" ][ "visionDistance" ].GetDouble();
-
-                switch( mRoverConfig[ "search" ][ "order" ][ searchFails % mRoverConfig[ "search" ][ "numSearches" ].GetInt() ].GetInt() )
+                const SearchPlan plan = searchPlan( mSearchFails );
+                bool planned = false;
+                SearchStateMachine* search = mSearchPlanner.take( plan, planned );
+                mSearchPlanner.retire( mSearchStateMachine );
+                mSearchStateMachine = search ? search : SearchFactory( this, plan.type );
+                if( !planned )
                 {
-                    case 0:
-                    {
-                        setSearcher(SearchType::SPIRALOUT);
-                        break;
-                    }
-                    case 1:
-                    {
-                        setSearcher(SearchType::LAWNMOWER);
-                        break;
-                    }
-                    case 2:
-                    {
-                        setSearcher(SearchType::SPIRALIN);
-                        break;
-                    }
-                    default:
-                    {
-                        setSearcher(SearchType::SPIRALOUT);
-                        break;
-                    }
+                    mSearchStateMachine->initializeSearch( mPhoebe, mRoverConfig, mSearchVisionDistance );
                 }
-                mSearchStateMachine->initializeSearch( mPhoebe, mRoverConfig, visionDistance );
-                if( searchFails % 2 == 1 && visionDistance > 0.5 )
-                {
-                    visionDistance *= 0.5;
-                }
-                searchFails += 1;
+                // Stay a whole round of the search order ahead.
+                mSearchPlanner.prepare( searchPlan( mSearchFails + mRoverConfig.search.numSearches ),
+                                        mRoverConfig );
+                mSearchVisionDistance = SearchPlanner::nextVisionDistance( mSearchFails, mSearchVisionDistance );
+                mSearchFails += 1;
                 nextState = NavState::SearchTurn;
                 break;
             }
@@ -239,55 +423,78 @@ void StateMachine::run()
             mPhoebe->distancePid().reset();
             mPhoebe->bearingPid().reset();
         }
-        cerr << flush;
     } // if
+    recordFlight( previousState );
 } // run()
 
+// Gets the flight recorder of the state machine's decisions.
+FlightRecorder& StateMachine::flightRecorder()
+{
+    return mFlightRecorder;
+} // flightRecorder()
+
 // Updates the auton state (on/off) of the rover's status.
-void StateMachine::updateRoverStatus( AutonState autonState )
+void StateMachine::updateRoverStatus( const AutonState& autonState )
 {
     mNewRoverStatus.autonState() = autonState;
 } // updateRoverStatus( AutonState )
 
-// Updates the course of the rover's status if it has changed.
-void StateMachine::updateRoverStatus( Course course )
+// Updates the course of the rover's status if it is the first course
+// received or has changed. When the course optimizer is enabled, the
+// new course is reordered from the latest odometry, or from its first
+// waypoint if no odometry has been received, so the path is built in
+// the new order when the rover is turned on.
+void StateMachine::updateRoverStatus( const Course& course )
 {
-    if( mNewRoverStatus.course().hash != course.hash )
+    if( !mCourseReceived || mNewRoverStatus.course().hash != course.hash )
     {
+        mCourseReceived = true;
         mNewRoverStatus.course() = course;
+        mSearchPlanner.cancel();
+        mSearchesPrepared = false;
+        if( mRoverConfig.courseOptimizer.enabled && course.num_waypoints > 1 )
+        {
+            const Odometry& odometry = mNewRoverStatus.odometry();
+            const bool located = odometry.latitude_deg != 0 || odometry.latitude_min != 0 ||
+                                 odometry.longitude_deg != 0 || odometry.longitude_min != 0;
+            mCourseOptimizer.optimize( located ? odometry : course.waypoints[ 0 ].odom, mNewRoverStatus.course(),
+                                       mRoverConfig.courseOptimizer.budget );
+        }
     }
 } // updateRoverStatus( Course )
 
 // Updates the obstacle information of the rover's status.
-void StateMachine::updateRoverStatus( Obstacle obstacle )
+void StateMachine::updateRoverStatus( const Obstacle& obstacle )
 {
     mNewRoverStatus.obstacle() = obstacle;
+    mNewRoverStatus.markDirty( Rover::RoverStatus::ObstacleDirty );
 } // updateRoverStatus( Obstacle )
 
 // Updates the odometry information of the rover's status.
-void StateMachine::updateRoverStatus( Odometry odometry )
+void StateMachine::updateRoverStatus( const Odometry& odometry )
 {
     mNewRoverStatus.odometry() = odometry;
+    mNewRoverStatus.markDirty( Rover::RoverStatus::OdometryDirty );
 } // updateRoverStatus( Odometry )
 
 // Updates the target information of the rover's status.
-void StateMachine::updateRoverStatus( TargetList targetList )
+void StateMachine::updateRoverStatus( const TargetList& targetList )
 {
-    Target target1 = targetList.targetList[0];
-    Target target2 = targetList.targetList[1];
-    mNewRoverStatus.target() = target1;
-    mNewRoverStatus.target2() = target2;
+    mNewRoverStatus.target() = targetList.targetList[0];
+    mNewRoverStatus.target2() = targetList.targetList[1];
+    mNewRoverStatus.markDirty( Rover::RoverStatus::TargetsDirty );
 } // updateRoverStatus( Target )
 
 // Updates the radio signal strength information of the rover's status.
-void StateMachine::updateRoverStatus( RadioSignalStrength radioSignalStrength )
+void StateMachine::updateRoverStatus( const RadioSignalStrength& radioSignalStrength )
 {
     mNewRoverStatus.radio() = radioSignalStrength;
+    mNewRoverStatus.markDirty( Rover::RoverStatus::RadioDirty );
 } // updateRoverStatus( RadioSignalStrength )
 
 // Return true if we want to execute a loop in the state machine, false
 // otherwise.
-bool StateMachine::isRoverReady() const
+bool StateMachine::isRoverReady()
 {
     return mStateChanged || // internal data has changed
            mPhoebe->updateRover( mNewRoverStatus ) || // external data has changed
@@ -298,17 +505,53 @@ bool StateMachine::isRoverReady() const
 
 } // isRoverReady()
 
-// Publishes the current navigation state to the nav status lcm channel.
-void StateMachine::publishNavState() const
+// Publishes the current navigation state to the nav status lcm channel
+// when it or the waypoint counts change, and otherwise once every
+// keep-alive period. The message is encoded into a buffer sized for the
+// longest state name so that publishing does not allocate.
+void StateMachine::publishNavState()
 {
-    NavStatus navStatus;
-    navStatus.nav_state_name = stringifyNavState();
-    navStatus.completed_wps = mCompletedWaypoints;
-    navStatus.total_wps = mTotalWaypoints;
-    const string& navStatusChannel = mRoverConfig[ "lcmChannels" ][ "navStatusChannel" ].GetString();
-    mLcmObject.publish( navStatusChannel, &navStatus );
+    const NavState state = mPhoebe->roverStatus().currentState();
+    const double now = mPhoebe->clock().now();
+    if( state == mPublishedState &&
+        mNavStatus.completed_wps == static_cast<int32_t>( mCompletedWaypoints ) &&
+        mNavStatus.total_wps == static_cast<int32_t>( mTotalWaypoints ) &&
+        now - mNavStatusTime < mRoverConfig.controlLoop.navStatusKeepAlive )
+    {
+        return;
+    }
+    mNavStatus.nav_state_name.assign( stringifyNavState() );
+    mNavStatus.completed_wps = mCompletedWaypoints;
+    mNavStatus.total_wps = mTotalWaypoints;
+    const int size = mNavStatus.encode( mNavStatusBuffer.data(), 0, mNavStatusBuffer.size() );
+    if( size < 0 )
+    {
+        cerr << "Could not encode the nav status.\n";
+        return;
+    }
+    mLcmObject.publish( mRoverConfig.lcmChannels.navStatusChannel, mNavStatusBuffer.data(), size );
+    mPublishedState = state;
+    mNavStatusTime = now;
 } // publishNavState()
 
+// Records the inputs, the state transition from previousState and the
+// joystick command of this iteration of run in the flight recorder.
+void StateMachine::recordFlight( NavState previousState )
+{
+    FlightRecord record;
+    record.time = mPhoebe->clock().now();
+    record.odometry = mPhoebe->roverStatus().odometry();
+    record.obstacle = mPhoebe->roverStatus().obstacle();
+    record.targets[ 0 ] = mPhoebe->roverStatus().target();
+    record.targets[ 1 ] = mPhoebe->roverStatus().target2();
+    record.fromState = static_cast<uint8_t>( previousState );
+    record.toState = static_cast<uint8_t>( mPhoebe->roverStatus().currentState() );
+    record.completedWaypoints = mCompletedWaypoints;
+    record.totalWaypoints = mTotalWaypoints;
+    record.joystick = mPhoebe->lastJoystick();
+    mFlightRecorder.record( record );
+} // recordFlight()
+
 // Executes the logic for off. If the rover is turned on, it updates
 // the roverStatus. If the course is empty, the rover is done  with
 // the course otherwise it will turn to the first waypoing. Else the
@@ -340,7 +583,9 @@ NavState StateMachine::executeDone()
 
 // Executes the logic for the turning. If the rover is turned off, it
 // proceeds to Off. If the rover finishes turning, it drives to the
-// next Waypoint. Else the rover keeps turning to the Waypoint.
+// next Waypoint. Else the rover keeps turning to the Waypoint. When
+// following the path, the rover drives straight away and turns as it
+// goes.
 NavState StateMachine::executeTurn()
 {
     if( mPhoebe->roverStatus().path().empty() )
@@ -355,6 +600,13 @@ NavState StateMachine::executeTurn()
         return NavState::RadioRepeaterTurn;
     }
 
+    // Pure pursuit turns towards the path as it drives.
+    if( mRoverConfig.pathFollowing.enabled &&
+        mPhoebe->roverStatus().currentState() == NavState::Turn )
+    {
+        return NavState::Drive;
+    }
+
     Odometry& nextPoint = mPhoebe->roverStatus().path().front().odom;
     if( mPhoebe->turn( nextPoint ) )
     {
@@ -381,7 +633,7 @@ NavState StateMachine::executeTurn()
 NavState StateMachine::executeDrive()
 {
     const Waypoint& nextWaypoint = mPhoebe->roverStatus().path().front();
-    double distance = estimateNoneuclid( mPhoebe->roverStatus().odometry(), nextWaypoint.odom );
+    double distance = mPhoebe->distanceTo( nextWaypoint.odom );
 
     // If we should drop a repeater and have not already, add last
     // point where connection was good to front of path and turn
@@ -395,9 +647,13 @@ NavState StateMachine::executeDrive()
     {
         mObstacleAvoidanceStateMachine->updateObstacleElements( getOptimalAvoidanceAngle(),
                                                                 getOptimalAvoidanceDistance() );
+        mObstacleAvoidanceStateMachine->updateDestination( mPhoebe->projection().toLocal( nextWaypoint.odom ) );
         return NavState::TurnAroundObs;
     }
-    DriveStatus driveStatus = mPhoebe->drive( nextWaypoint.odom );
+    const bool followPath = mRoverConfig.pathFollowing.enabled &&
+                            mPhoebe->roverStatus().currentState() == NavState::Drive;
+    DriveStatus driveStatus = followPath ? mPhoebe->followPath( mPhoebe->roverStatus().path() )
+                                         : mPhoebe->drive( nextWaypoint.odom );
     if( driveStatus == DriveStatus::Arrived )
     {
         if( nextWaypoint.search )
@@ -410,6 +666,11 @@ NavState StateMachine::executeDrive()
             return NavState::RepeaterDropWait;
         }
         ++mCompletedWaypoints;
+        // Keep driving through the corner to the next waypoint.
+        if( followPath && !mPhoebe->roverStatus().path().empty() )
+        {
+            return NavState::Drive;
+        }
         return NavState::Turn;
     }
     if( driveStatus == DriveStatus::OnCourse )
@@ -436,8 +697,7 @@ NavState StateMachine::executeRepeaterDropWait( )
 {
 
     RepeaterDropInit rr_init;
-    const string& radioRepeaterInitChannel = mRoverConfig[ "lcmChannels" ][ "repeaterDropInitChannel" ].GetString();
-    mLcmObject.publish( radioRepeaterInitChannel, &rr_init );
+    mLcmObject.publish( mRoverConfig.lcmChannels.repeaterDropInitChannel, &rr_init );
 
     if( mRepeaterDropComplete )
     {
@@ -447,43 +707,9 @@ NavState StateMachine::executeRepeaterDropWait( )
 }
 
 // Gets the string representation of a nav state.
-string StateMachine::stringifyNavState() const
+const char* StateMachine::stringifyNavState() const
 {
-    static const map<NavState, std::string> navStateNames =
-        {
-            { NavState::Off, "Off" },
-            { NavState::Done, "Done" },
-            { NavState::Turn, "Turn" },
-            { NavState::Drive, "Drive" },
-            { NavState::SearchFaceNorth, "Search Face North" },
-            { NavState::SearchSpin, "Search Spin" },
-            { NavState::SearchSpinWait, "Search Spin Wait" },
-            { NavState::ChangeSearchAlg, "Change Search Algorithm" },
-            { NavState::SearchTurn, "Search Turn" },
-            { NavState::SearchDrive, "Search Drive" },
-            { NavState::TurnToTarget, "Turn to Target" },
-            { NavState::TurnedToTargetWait, "Turned to Target Wait" },
-            { NavState::DriveToTarget, "Drive to Target" },
-            { NavState::TurnAroundObs, "Turn Around Obstacle"},
-            { NavState::DriveAroundObs, "Drive Around Obstacle" },
-            { NavState::SearchTurnAroundObs, "Search Turn Around Obstacle" },
-            { NavState::SearchDriveAroundObs, "Search Drive Around Obstacle" },
-            { NavState::GateSpin, "Gate Spin" },
-            { NavState::GateSpinWait, "Gate Spin Wait" },
-            { NavState::GateTurn, "Gate Turn" },
-            { NavState::GateDrive, "Gate Drive" },
-            { NavState::GateTurnToCentPoint, "Gate Turn to Center Point" },
-            { NavState::GateDriveToCentPoint, "Gate Drive to Center Point" },
-            { NavState::GateFace, "Gate Face" },
-            { NavState::GateShimmy, "Gate Shimmy" },
-            { NavState::GateDriveThrough, "Gate Drive Through" },
-            { NavState::RadioRepeaterTurn, "Radio Repeater Turn" },
-            { NavState::RadioRepeaterDrive, "Radio Repeater Drive" },
-            { NavState::RepeaterDropWait, "Radio Repeater Drop" },
-            { NavState::Unknown, "Unknown" }
-        };
-
-    return navStateNames.at( mPhoebe->roverStatus().currentState() );
+    return navStateName( mPhoebe->roverStatus().currentState() );
 } // stringifyNavState()
 
 // Returns the optimal angle to avoid the detected obstacle.
@@ -495,12 +721,12 @@ double StateMachine::getOptimalAvoidanceAngle() const
 // Returns the optimal angle to avoid the detected obstacle.
 double StateMachine::getOptimalAvoidanceDistance() const
 {
-    return mPhoebe->roverStatus().obstacle().distance + mRoverConfig[ "navThresholds" ][ "waypointDistance" ].GetDouble();
+    return mPhoebe->roverStatus().obstacle().distance + mRoverConfig.navThresholds.waypointDistance;
 } // optimalAvoidanceAngle()
 
 bool StateMachine::isWaypointReachable( double distance )
 {
-    return isLocationReachable( mPhoebe, mRoverConfig, distance, mRoverConfig["navThresholds"]["waypointDistance"].GetDouble());
+    return isLocationReachable( mPhoebe, mRoverConfig, distance, mRoverConfig.navThresholds.waypointDistance);
 } // isWaypointReachable
 
 // If we have not already begun to drop radio repeater
@@ -2,8 +2,11 @@
 #define STATE_MACHINE_HPP
 
 #include <lcm/lcm-cpp.hpp>
-#include "rapidjson/document.h"
+#include "courseOptimizer.hpp"
+#include "flightRecorder.hpp"
 #include "rover.hpp"
+#include "rover_msgs/NavStatus.hpp"
+#include "search/searchPlanner.hpp"
 #include "search/searchStateMachine.hpp"
 #include "gate_search/gateStateMachine.hpp"
 #include "obstacle_avoidance/simpleAvoidance.hpp"
@@ -11,6 +14,10 @@
 using namespace std;
 using namespace rover_msgs;
 
+const char* navStateName( NavState state );
+
+size_t longestNavStateName();
+
 // This class implements the logic for the state machine for the
 // autonomous navigation of the rover.
 class StateMachine
@@ -19,25 +26,27 @@ public:
     /*************************************************************************/
     /* Public Member Functions */
     /*************************************************************************/
-    StateMachine( lcm::LCM& lcmObject );
+    StateMachine( lcm::LCM& lcmObject, const NavConfig& config, const Clock& clock );
 
     ~StateMachine();
 
     void run( );
 
-    void updateRoverStatus( AutonState autonState );
+    void updateConfig( const NavConfig& config );
+
+    void updateRoverStatus( const AutonState& autonState );
 
-    void updateRoverStatus( Bearing bearing );
+    void updateRoverStatus( const Bearing& bearing );
 
-    void updateRoverStatus( Course course );
+    void updateRoverStatus( const Course& course );
 
-    void updateRoverStatus( Obstacle obstacle );
+    void updateRoverStatus( const Obstacle& obstacle );
 
-    void updateRoverStatus( Odometry odometry );
+    void updateRoverStatus( const Odometry& odometry );
 
-    void updateRoverStatus( TargetList targetList );
+    void updateRoverStatus( const TargetList& targetList );
 
-    void updateRoverStatus( RadioSignalStrength radioSignalStrength );
+    void updateRoverStatus( const RadioSignalStrength& radioSignalStrength );
 
     void updateCompletedPoints( );
 
@@ -47,10 +56,14 @@ public:
 
     void updateObstacleElements( double bearing, double distance );
 
+    void updateObstacleDestination( const LocalPoint& destination );
+
     void updateRepeaterComplete( );
 
     void setSearcher(SearchType type);
 
+    FlightRecorder& flightRecorder();
+
     /*************************************************************************/
     /* Public Member Variables */
     /*************************************************************************/
@@ -61,9 +74,11 @@ private:
     /*************************************************************************/
     /* Private Member Functions */
     /*************************************************************************/
-    bool isRoverReady() const;
+    bool isRoverReady();
 
-    void publishNavState() const;
+    void publishNavState();
+
+    void recordFlight( NavState previousState );
 
     NavState executeOff();
 
@@ -79,9 +94,13 @@ private:
 
     void initializeSearch();
 
+    SearchPlan searchPlan( int searchFails ) const;
+
+    void prepareSearches();
+
     bool addFourPointsToSearch();
 
-    string stringifyNavState() const;
+    const char* stringifyNavState() const;
 
     double getOptimalAvoidanceAngle() const;
 
@@ -99,14 +118,36 @@ private:
     // Rover object to do basic rover operations in the state machine.
     Rover* mPhoebe;
 
-    // RoverStatus object for updating the rover's status.
+    // RoverStatus object for updating the rover's status. The lcm
+    // handlers write into this back buffer and mark the written fields
+    // dirty; run hands the dirty fields over to the rover.
     Rover::RoverStatus mNewRoverStatus;
 
     // Lcm object for sending and recieving messages.
     lcm::LCM& mLcmObject;
 
-    // Configuration file for the rover.
-    rapidjson::Document mRoverConfig;
+    // Configuration for the rover, parsed from the configuration file.
+    NavConfig mRoverConfig;
+
+    // Last nav status message published, and the buffer it is encoded
+    // into, both reused so that publishing does not allocate.
+    NavStatus mNavStatus;
+    vector<uint8_t> mNavStatusBuffer;
+
+    // State in the last nav status published and the clock time it was
+    // published at.
+    NavState mPublishedState;
+    double mNavStatusTime;
+
+    // Records every iteration of run so a mission can be replayed.
+    FlightRecorder mFlightRecorder;
+
+    // Reorders new courses when enabled.
+    CourseOptimizer mCourseOptimizer;
+
+    // Whether a course has been received. The first course is always
+    // taken, whatever its hash.
+    bool mCourseReceived;
 
     // Number of waypoints in course.
     unsigned mTotalWaypoints;
@@ -120,6 +161,22 @@ private:
     // Indicates if the state changed on a given iteration of run.
     bool mStateChanged;
 
+    // Number of search patterns that have been started. Picks the next
+    // pattern from the search order.
+    int mSearchFails;
+
+    // Vision distance the next search pattern is spaced by. It is
+    // halved after every second pattern.
+    double mSearchVisionDistance;
+
+    // Whether the search patterns for the search waypoint at
+    // mPreparedCenter have been asked for.
+    bool mSearchesPrepared;
+    LocalPoint mPreparedCenter;
+
+    // Builds search patterns ahead on a thread of its own.
+    SearchPlanner mSearchPlanner;
+
     // Search pointer to control search states
     SearchStateMachine* mSearchStateMachine;
 
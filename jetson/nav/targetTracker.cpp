@@ -0,0 +1,184 @@
+#include "targetTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utilities.hpp"
+
+// Constructs a tracker with no tracks.
+TargetTracker::TargetTracker()
+{
+    clear();
+} // TargetTracker()
+
+// Forgets every track. Used when the local plane is re-anchored.
+void TargetTracker::clear()
+{
+    for( Track& track : mTracks )
+    {
+        track.id = -1;
+    }
+} // clear()
+
+// Fuses a detection of target, seen from the rover at position with the
+// given heading, into the target's track, starting a track if there is
+// none. A detection outside the gate is dropped, unless there have been
+// so many in a row that the track is more likely wrong than the
+// detections, in which case the track restarts from it. Returns true if
+// the detection was used.
+bool TargetTracker::update( const LocalPoint& position, double heading, const Target& target,
+                            double now, const NavConfig::TargetTracker& config )
+{
+    if( target.distance < 0 )
+    {
+        return false;
+    }
+
+    // Covariance of the detection on the plane: the range noise lies
+    // along the line of sight, the bearing noise across it, and the
+    // rover's own position noise in every direction.
+    const double lineOfSight = degreeToRadian( heading + target.bearing );
+    const double sine = sin( lineOfSight );
+    const double cosine = cos( lineOfSight );
+    const double rangeVariance = config.rangeNoise * config.rangeNoise;
+    const double across = target.distance * degreeToRadian( config.bearingNoise );
+    const double acrossVariance = across * across;
+    const double positionVariance = config.positionNoise * config.positionNoise;
+    const double measuredCovariance[ 3 ] =
+    {
+        rangeVariance * sine * sine + acrossVariance * cosine * cosine + positionVariance,
+        ( rangeVariance - acrossVariance ) * sine * cosine,
+        rangeVariance * cosine * cosine + acrossVariance * sine * sine + positionVariance
+    };
+    const LocalPoint measured = offsetPoint( position, heading + target.bearing, target.distance );
+
+    Track& track = trackFor( target.id );
+    if( track.id != target.id )
+    {
+        start( track, target.id, measured, measuredCovariance, now );
+        return true;
+    }
+
+    // Predict: the tag has not moved but where the rover thinks it is
+    // has drifted.
+    const double drift = config.processNoise * max( 0.0, now - track.predicted );
+    track.covarianceXX += drift;
+    track.covarianceYY += drift;
+    track.predicted = now;
+
+    // Gate on the squared Mahalanobis distance of the innovation.
+    const double sXX = track.covarianceXX + measuredCovariance[ 0 ];
+    const double sXY = track.covarianceXY + measuredCovariance[ 1 ];
+    const double sYY = track.covarianceYY + measuredCovariance[ 2 ];
+    const double determinant = sXX * sYY - sXY * sXY;
+    const double innovationX = measured.x - track.position.x;
+    const double innovationY = measured.y - track.position.y;
+    const double distanceSquared = ( sYY * innovationX * innovationX - 2 * sXY * innovationX * innovationY +
+                                     sXX * innovationY * innovationY ) / determinant;
+    if( determinant <= 0 || distanceSquared > config.gate )
+    {
+        if( ++track.rejections >= config.maxRejections )
+        {
+            start( track, target.id, measured, measuredCovariance, now );
+            return true;
+        }
+        return false;
+    }
+
+    // Correct: gain = P S^-1, position += gain * innovation and
+    // P -= gain * P.
+    const double inverseXX = sYY / determinant;
+    const double inverseXY = -sXY / determinant;
+    const double inverseYY = sXX / determinant;
+    const double gainXX = track.covarianceXX * inverseXX + track.covarianceXY * inverseXY;
+    const double gainXY = track.covarianceXX * inverseXY + track.covarianceXY * inverseYY;
+    const double gainYX = track.covarianceXY * inverseXX + track.covarianceYY * inverseXY;
+    const double gainYY = track.covarianceXY * inverseXY + track.covarianceYY * inverseYY;
+    track.position.x += gainXX * innovationX + gainXY * innovationY;
+    track.position.y += gainYX * innovationX + gainYY * innovationY;
+    const double covarianceXX = track.covarianceXX - ( gainXX * track.covarianceXX + gainXY * track.covarianceXY );
+    const double covarianceXY = track.covarianceXY - ( gainXX * track.covarianceXY + gainXY * track.covarianceYY );
+    const double covarianceYY = track.covarianceYY - ( gainYX * track.covarianceXY + gainYY * track.covarianceYY );
+    track.covarianceXX = covarianceXX;
+    track.covarianceXY = covarianceXY;
+    track.covarianceYY = covarianceYY;
+    track.lastSeen = now;
+    track.rejections = 0;
+    return true;
+} // update()
+
+// Gets the track of the tag with the given id, or nullptr if the tag
+// has not been seen within the coast time.
+const TargetTracker::Track* TargetTracker::track( int id, double now,
+                                                  const NavConfig::TargetTracker& config ) const
+{
+    const Track* found = landmark( id );
+    return found && now - found->lastSeen <= config.coastTime ? found : nullptr;
+} // track()
+
+// Gets the track of the tag with the given id however long ago it was
+// seen, or nullptr if it has not been seen since the tracker was
+// cleared or its track was replaced.
+const TargetTracker::Track* TargetTracker::landmark( int id ) const
+{
+    for( const Track& track : mTracks )
+    {
+        if( track.id == id && id >= 0 )
+        {
+            return &track;
+        }
+    }
+    return nullptr;
+} // landmark()
+
+// Gets where the tag with the given id is estimated to be, relative to
+// the rover at position with the given heading, in the form of a
+// detection. The distance is -1 if the tag is not tracked.
+Target TargetTracker::predict( const LocalPoint& position, double heading, int id,
+                               double now, const NavConfig::TargetTracker& config ) const
+{
+    Target target;
+    target.distance = -1;
+    target.bearing = 0;
+    target.id = id;
+    const Track* found = track( id, now, config );
+    if( found )
+    {
+        target.distance = planarDistance( position, found->position );
+        target.bearing = mod( planarBearing( position, found->position ) - heading + 180, 360 ) - 180;
+    }
+    return target;
+} // predict()
+
+// Gets the track for the tag with the given id: its own if it has one,
+// else an unused track, else the one seen longest ago.
+TargetTracker::Track& TargetTracker::trackFor( int id )
+{
+    Track* stalest = &mTracks[ 0 ];
+    for( Track& track : mTracks )
+    {
+        if( track.id == id )
+        {
+            return track;
+        }
+        if( stalest->id >= 0 && ( track.id < 0 || track.lastSeen < stalest->lastSeen ) )
+        {
+            stalest = &track;
+        }
+    }
+    return *stalest;
+} // trackFor()
+
+// Starts track for the tag with the given id from a single detection.
+void TargetTracker::start( Track& track, int id, const LocalPoint& measured, const double covariance[ 3 ],
+                           double now )
+{
+    track.id = id;
+    track.position = measured;
+    track.covarianceXX = covariance[ 0 ];
+    track.covarianceXY = covariance[ 1 ];
+    track.covarianceYY = covariance[ 2 ];
+    track.predicted = now;
+    track.lastSeen = now;
+    track.rejections = 0;
+} // start()
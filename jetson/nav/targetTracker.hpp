@@ -0,0 +1,87 @@
+#ifndef TARGET_TRACKER_HPP
+#define TARGET_TRACKER_HPP
+
+#include "rover_msgs/TargetList.hpp"
+#include "localProjection.hpp"
+#include "navConfig.hpp"
+
+using namespace rover_msgs;
+using namespace std;
+
+// This class tracks where on the local plane each AR tag is, by tag id.
+// Each track is a Kalman filter over the tag's position: a detection's
+// range and bearing are projected from the rover's position and heading
+// onto the plane, with a covariance that is long along the line of
+// sight and wide across it, and fused into the track if it is within
+// the gate. Tags do not move, so between detections a track only grows
+// more uncertain, which covers the rover's odometry drift. Because the
+// track lives on the plane, the rover can keep steering towards a tag
+// it has stopped seeing for a while, and tracks double as a map of
+// landmarks that every sighting refines, such as the posts of a gate.
+// The tracks are a small fixed array so updating does not allocate.
+class TargetTracker
+{
+public:
+    /*************************************************************************/
+    /* Public Types */
+    /*************************************************************************/
+    // A tag's estimated position on the local plane.
+    struct Track
+    {
+        // Id of the tag, or -1 if the track is unused.
+        int id;
+
+        // Estimated position of the tag and its covariance in square
+        // meters.
+        LocalPoint position;
+        double covarianceXX;
+        double covarianceXY;
+        double covarianceYY;
+
+        // Clock times the covariance was last grown to and the tag was
+        // last fused into the track.
+        double predicted;
+        double lastSeen;
+
+        // Detections in a row that fell outside the gate.
+        int rejections;
+    };
+
+    // Most tags tracked at once. Gates have two posts, so this leaves
+    // room for stale tracks.
+    static const int MAX_TRACKS = 8;
+
+    /*************************************************************************/
+    /* Public Member Functions */
+    /*************************************************************************/
+    TargetTracker();
+
+    void clear();
+
+    bool update( const LocalPoint& position, double heading, const Target& target,
+                 double now, const NavConfig::TargetTracker& config );
+
+    const Track* track( int id, double now, const NavConfig::TargetTracker& config ) const;
+
+    const Track* landmark( int id ) const;
+
+    Target predict( const LocalPoint& position, double heading, int id,
+                    double now, const NavConfig::TargetTracker& config ) const;
+
+private:
+    /*************************************************************************/
+    /* Private Member Functions */
+    /*************************************************************************/
+    Track& trackFor( int id );
+
+    void start( Track& track, int id, const LocalPoint& measured, const double covariance[ 3 ], double now );
+
+    /*************************************************************************/
+    /* Private Member Variables */
+    /*************************************************************************/
+
+    // The tracks, unused ones marked by id -1.
+    Track mTracks[ MAX_TRACKS ];
+};
+
+#endif // TARGET_TRACKER_HPP
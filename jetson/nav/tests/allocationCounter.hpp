@@ -0,0 +1,44 @@
+#ifndef NAV_ALLOCATION_COUNTER_HPP
+#define NAV_ALLOCATION_COUNTER_HPP
+
+// Replaces operator new to count the heap allocations each thread
+// makes, so allocations on nav's worker threads are not charged to the
+// control thread under test. Include it in exactly one source file of
+// an executable.
+
+#include <cstdlib>
+#include <new>
+
+namespace AllocationCounter
+{
+    // Gets the number of calls to operator new made by the calling
+    // thread.
+    inline long& threadAllocations()
+    {
+        static thread_local long allocations = 0;
+        return allocations;
+    } // threadAllocations()
+} // namespace AllocationCounter
+
+void* operator new( size_t size )
+{
+    ++AllocationCounter::threadAllocations();
+    void* memory = malloc( size ? size : 1 );
+    if( !memory )
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete( void* memory ) noexcept
+{
+    free( memory );
+}
+
+void operator delete( void* memory, size_t ) noexcept
+{
+    free( memory );
+}
+
+#endif // NAV_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,114 @@
+// Checks that the steady-state nav tick does not allocate. Once the
+// rover is on and driving, every tick hands new odometry to the rover
+// and runs the state machine; none of that may touch the heap. Also
+// checks that the unchanged nav status is not republished every tick.
+
+#include <iostream>
+#include <lcm/lcm-cpp.hpp>
+#include "stateMachine.hpp"
+#include "allocationCounter.hpp"
+
+namespace
+{
+    // Records the state name published on /nav_status and counts the
+    // messages.
+    struct NavStatusListener
+    {
+        void navStatus( const lcm::ReceiveBuffer* receiveBuffer,
+                        const string& channel,
+                        const NavStatus* navStatus )
+        {
+            stateName = navStatus->nav_state_name;
+            ++messages;
+        }
+
+        string stateName;
+        int messages = 0;
+    };
+} // namespace
+
+int main()
+{
+    lcm::LCM lcmObject( "memq://" );
+    NavConfig config;
+    VirtualClock clock;
+    StateMachine stateMachine( lcmObject, config, clock );
+    NavStatusListener listener;
+    lcmObject.subscribe( config.lcmChannels.navStatusChannel, &NavStatusListener::navStatus, &listener );
+
+    Odometry odometry = {};
+    odometry.latitude_deg = 38;
+    odometry.latitude_min = 24.0;
+    odometry.longitude_deg = -110;
+    odometry.longitude_min = 47.0;
+
+    // A single waypoint about 185 m due north.
+    Waypoint waypoint = {};
+    waypoint.odom = odometry;
+    waypoint.odom.latitude_min += 0.1;
+    Course course;
+    course.num_waypoints = 1;
+    course.hash = 1;
+    course.waypoints.push_back( waypoint );
+
+    Obstacle obstacle = {};
+    obstacle.distance = -1;
+    TargetList targetList = {};
+    targetList.targetList[ 0 ].distance = -1;
+    targetList.targetList[ 1 ].distance = -1;
+    AutonState autonState;
+    autonState.is_auton = true;
+
+    stateMachine.updateRoverStatus( course );
+    stateMachine.updateRoverStatus( obstacle );
+    stateMachine.updateRoverStatus( targetList );
+    stateMachine.updateRoverStatus( odometry );
+    stateMachine.updateRoverStatus( autonState );
+
+    // Turn on, turn to the waypoint and start driving.
+    const double stepMinutes = 0.01 * LAT_METER_IN_MINUTES;
+    for( int tick = 0; tick < 10; ++tick )
+    {
+        odometry.latitude_min += stepMinutes;
+        stateMachine.updateRoverStatus( odometry );
+        stateMachine.run();
+    }
+
+    while( lcmObject.handleTimeout( 0 ) > 0 ) {}
+    const int messagesBefore = listener.messages;
+
+    // Tick at the control loop rate for just under one keep-alive period.
+    const int steadyTicks = 1000;
+    const double tickSeconds = 0.99 * config.controlLoop.navStatusKeepAlive / steadyTicks;
+    const long allocationsBefore = AllocationCounter::threadAllocations();
+    for( int tick = 0; tick < steadyTicks; ++tick )
+    {
+        odometry.latitude_min += stepMinutes;
+        clock.advance( tickSeconds );
+        stateMachine.updateRoverStatus( odometry );
+        stateMachine.updateRoverStatus( obstacle );
+        stateMachine.updateRoverStatus( targetList );
+        stateMachine.run();
+    }
+    const long steadyAllocations = AllocationCounter::threadAllocations() - allocationsBefore;
+
+    while( lcmObject.handleTimeout( 0 ) > 0 ) {}
+    if( listener.messages - messagesBefore > 1 )
+    {
+        cerr << "Published the unchanged nav status " << listener.messages - messagesBefore << " times in "
+             << steadyTicks << " ticks\n";
+        return 1;
+    }
+    if( listener.stateName != "Drive" )
+    {
+        cerr << "Expected the rover to be driving but it is in state \"" << listener.stateName << "\"\n";
+        return 1;
+    }
+    if( steadyAllocations != 0 )
+    {
+        cerr << steadyAllocations << " allocations in " << steadyTicks << " steady-state ticks\n";
+        return 1;
+    }
+    cout << "No allocations in " << steadyTicks << " steady-state ticks\n";
+    return 0;
+}
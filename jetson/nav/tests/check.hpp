@@ -0,0 +1,62 @@
+#ifndef NAV_CHECK_HPP
+#define NAV_CHECK_HPP
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Small helpers shared by the nav unit tests. A failed check prints
+// what failed and the test carries on, so one run reports every check
+// that does not hold.
+namespace Check
+{
+    // Gets the number of checks that have failed.
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    } // failures()
+
+    // Records a failure, printing what failed.
+    inline void fail( const std::string& what )
+    {
+        std::cerr << what << "\n";
+        ++failures();
+    } // fail()
+
+    // Records a failure if condition does not hold.
+    inline void check( const char* what, bool condition )
+    {
+        if( !condition )
+        {
+            fail( what );
+        }
+    } // check()
+
+    // Records a failure if the difference between actual and expected
+    // is larger than tolerance. Infinite values must match exactly.
+    inline void checkNear( const char* what, double actual, double expected, double tolerance )
+    {
+        if( !( actual == expected || std::fabs( actual - expected ) <= tolerance ) )
+        {
+            std::cerr << what << ": got " << actual << ", expected " << expected
+                      << " (tolerance " << tolerance << ")\n";
+            ++failures();
+        }
+    } // checkNear()
+
+    // Prints how many checks failed, or passed if none did, and returns
+    // the exit status of the test.
+    inline int report( const char* passed )
+    {
+        if( failures() )
+        {
+            std::cerr << failures() << " checks failed\n";
+            return 1;
+        }
+        std::cout << passed << "\n";
+        return 0;
+    } // report()
+} // namespace Check
+
+#endif // NAV_CHECK_HPP
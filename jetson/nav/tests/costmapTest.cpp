@@ -0,0 +1,80 @@
+// Checks that the costmap integrates detections, decays them, forgets
+// cells that scroll out of the window and answers corridor queries.
+
+#include <iostream>
+#include "costmap.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+namespace
+{
+    // Creates an obstacle message.
+    Obstacle makeObstacle( double distance )
+    {
+        Obstacle obstacle;
+        obstacle.bearing = 0;
+        obstacle.distance = distance;
+        return obstacle;
+    } // makeObstacle()
+} // namespace
+
+int main()
+{
+    NavConfig config;
+    const NavConfig::Costmap& settings = config.costmap;
+    const double width = config.roverMeasurements.width;
+    Costmap costmap( settings.resolution, settings.size );
+    const LocalPoint origin = { 0, 0 };
+    const LocalPoint ahead = { 0, 4 };
+    const LocalPoint beyond = { 0, 10 };
+    costmap.recenter( origin );
+
+    check( "an empty map is clear", costmap.isCorridorClear( origin, beyond, width / 2, 0, settings ) );
+
+    // A single detection is not enough to block the rover; a second one is.
+    costmap.addObservation( origin, 0, makeObstacle( 4 ), width, 0, settings );
+    check( "one detection is not occupied", !costmap.isOccupied( ahead, 0, settings ) );
+    costmap.addObservation( origin, 0, makeObstacle( 4 ), width, 0.02, settings );
+    check( "two detections are occupied", costmap.isOccupied( ahead, 0.02, settings ) );
+    check( "the corridor through the obstacle is blocked",
+           !costmap.isCorridorClear( origin, beyond, width / 2, 0.02, settings ) );
+    check( "the corridor short of the obstacle is clear",
+           costmap.isCorridorClear( origin, { 0, 3 }, width / 2, 0.02, settings ) );
+    check( "a corridor beside the obstacle is clear",
+           costmap.isCorridorClear( { 3, 0 }, { 3, 10 }, width / 2, 0.02, settings ) );
+
+    // Occupancy decays with time.
+    check( "detections decay", !costmap.isOccupied( ahead, 0.02 + settings.decayTime, settings ) );
+
+    // Clear views erase the detections.
+    for( int i = 0; i < 10; ++i )
+    {
+        costmap.addObservation( origin, 0, makeObstacle( -1 ), width, 0.04 + i * 0.02, settings );
+    }
+    check( "clear views free the obstacle", costmap.isCorridorClear( origin, beyond, width / 2, 0.3, settings ) );
+
+    // Detections facing east land east of the rover.
+    costmap.addObservation( origin, 90, makeObstacle( 4 ), width, 0.3, settings );
+    costmap.addObservation( origin, 90, makeObstacle( 4 ), width, 0.3, settings );
+    check( "bearings are compass bearings", costmap.isOccupied( { 4, 0 }, 0.3, settings ) );
+
+    // Cells that scroll out of the window are forgotten and do not come
+    // back when the window scrolls back.
+    const double span = settings.resolution * settings.size;
+    costmap.recenter( { 0, span } );
+    check( "cells outside the window are free", !costmap.isOccupied( { 4, 0 }, 0.3, settings ) );
+    costmap.recenter( origin );
+    check( "cells that scrolled out are cleared", !costmap.isOccupied( { 4, 0 }, 0.3, settings ) );
+
+    // Cells that stay in the window survive a small scroll.
+    costmap.addObservation( origin, 90, makeObstacle( 4 ), width, 0.3, settings );
+    costmap.addObservation( origin, 90, makeObstacle( 4 ), width, 0.3, settings );
+    costmap.recenter( { -3, -5 } );
+    check( "cells in the window survive a scroll", costmap.isOccupied( { 4, 0 }, 0.3, settings ) );
+
+    costmap.clear();
+    check( "clear forgets everything", !costmap.isOccupied( { 4, 0 }, 0.3, settings ) );
+
+    return Check::report( "costmap checks passed" );
+}
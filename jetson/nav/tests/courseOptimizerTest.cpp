@@ -0,0 +1,105 @@
+// Checks that the course optimizer visits every waypoint once, keeps
+// gates in place, finds the obvious order of simple courses and never
+// does worse than nearest neighbour on random ones.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "courseOptimizer.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+namespace
+{
+    // Gets whether order visits each of count points once.
+    bool isPermutation( vector<int> order, int count )
+    {
+        sort( order.begin(), order.end() );
+        for( int i = 0; i < count; ++i )
+        {
+            if( static_cast<int>( order.size() ) != count || order[ i ] != i )
+            {
+                return false;
+            }
+        }
+        return true;
+    } // isPermutation()
+} // namespace
+
+int main()
+{
+    CourseOptimizer optimizer;
+    const LocalPoint start = { 0, 0 };
+
+    // Points along a line, sent shuffled, are visited outwards.
+    const vector<LocalPoint> line = { { 0, 30 }, { 0, 10 }, { 0, 50 }, { 0, 20 }, { 0, 40 } };
+    const vector<bool> unconstrained( line.size(), false );
+    vector<int> order = optimizer.solve( start, line, unconstrained, 1 );
+    check( "a line is visited in order", order == vector<int>( { 1, 3, 0, 4, 2 } ) );
+    check( "a line is driven once", fabs( optimizer.length( start, line, order ) - 50 ) < 1e-9 );
+
+    // A gate keeps its place, and the waypoints before it stay before it.
+    vector<bool> gated = unconstrained;
+    gated[ 2 ] = true;
+    order = optimizer.solve( start, line, gated, 1 );
+    check( "a gate keeps its place", order.size() == 5 && order[ 2 ] == 2 );
+    check( "waypoints stay on their side of a gate",
+           isPermutation( vector<int>( order.begin(), order.begin() + 2 ), 2 ) );
+    check( "each leg is ordered", order == vector<int>( { 1, 0, 2, 4, 3 } ) );
+    check( "no points is an empty order", optimizer.solve( start, {}, {}, 1 ).empty() );
+
+    // Random courses are never worse than nearest neighbour, which is
+    // all a budget of zero leaves time for.
+    mt19937 generator( 7 );
+    uniform_real_distribution<double> coordinate( -200, 200 );
+    for( int size : { 2, 10, 60, 200 } )
+    {
+        vector<LocalPoint> points( size );
+        for( LocalPoint& point : points )
+        {
+            point = { coordinate( generator ), coordinate( generator ) };
+        }
+        vector<bool> fixed( size, false );
+        fixed[ size / 2 ] = size > 2;
+        const vector<int> nearest = optimizer.solve( start, points, fixed, 0 );
+        const vector<int> improved = optimizer.solve( start, points, fixed, 1 );
+        check( "nearest neighbour visits every point once", isPermutation( nearest, size ) );
+        check( "the improved order visits every point once", isPermutation( improved, size ) );
+        check( "the improved order keeps the gate", improved[ size / 2 ] == size / 2 );
+        check( "the improved order is no longer", optimizer.length( start, points, improved ) <=
+                                                  optimizer.length( start, points, nearest ) + 1e-9 );
+    }
+
+    // Optimizing a course reorders its waypoints and leaves gates alone.
+    Odometry origin = Odometry();
+    origin.latitude_deg = 38;
+    origin.latitude_min = 24.36;
+    origin.longitude_deg = -110;
+    origin.longitude_min = -47.52;
+    const LocalProjection projection( origin );
+    Course course;
+    course.hash = 42;
+    const vector<LocalPoint> positions = { { 0, 30 }, { 0, 10 }, { 5, 60 }, { 0, 50 }, { 0, 20 } };
+    for( size_t i = 0; i < positions.size(); ++i )
+    {
+        Waypoint waypoint = {};
+        waypoint.odom = projection.toOdometry( positions[ i ] );
+        waypoint.id = static_cast<int16_t>( i );
+        waypoint.gate = i == 2;
+        course.waypoints.push_back( waypoint );
+    }
+    course.num_waypoints = static_cast<int32_t>( course.waypoints.size() );
+    optimizer.optimize( origin, course, 1 );
+    vector<int> ids;
+    for( const Waypoint& waypoint : course.waypoints )
+    {
+        ids.push_back( waypoint.id );
+    }
+    check( "the course is reordered", ids == vector<int>( { 1, 0, 2, 3, 4 } ) );
+    check( "the course keeps its hash and size", course.hash == 42 && course.num_waypoints == 5 );
+    check( "the gate keeps its place", course.waypoints[ 2 ].gate && !course.waypoints[ 3 ].gate );
+
+    return Check::report( "course optimizer checks passed" );
+}
@@ -0,0 +1,142 @@
+// Checks that the D* Lite planner finds shortest paths on random boulder
+// fields, and that repairing a plan after the start moves and cells
+// change gives the same path length as planning from scratch.
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+#include "obstacle_avoidance/dStarLite.hpp"
+#include "check.hpp"
+
+using Check::checkNear;
+
+namespace
+{
+    const double RESOLUTION = 0.5;
+    const int SIZE = 48;
+
+    // Shortest 8-connected path length from start to goal without cutting
+    // corners of blocked cells, found with Dijkstra's algorithm.
+    double referenceLength( const vector<bool>& blocked, int start, int goal )
+    {
+        const double infinity = numeric_limits<double>::infinity();
+        vector<double> distance( blocked.size(), infinity );
+        typedef pair<double, int> Entry;
+        priority_queue<Entry, vector<Entry>, greater<Entry> > open;
+        distance[ goal ] = 0;
+        open.push( { 0, goal } );
+        while( !open.empty() )
+        {
+            const Entry entry = open.top();
+            open.pop();
+            const int cell = entry.second;
+            if( entry.first > distance[ cell ] || blocked[ cell ] )
+            {
+                continue;
+            }
+            const int x = cell % SIZE;
+            const int y = cell / SIZE;
+            for( int dy = -1; dy <= 1; ++dy )
+            {
+                for( int dx = -1; dx <= 1; ++dx )
+                {
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+                    if( ( dx == 0 && dy == 0 ) || nx < 0 || ny < 0 || nx >= SIZE || ny >= SIZE )
+                    {
+                        continue;
+                    }
+                    const int neighbor = ny * SIZE + nx;
+                    if( blocked[ neighbor ] ||
+                        ( dx != 0 && dy != 0 && ( blocked[ y * SIZE + nx ] || blocked[ ny * SIZE + x ] ) ) )
+                    {
+                        continue;
+                    }
+                    const double step = ( dx != 0 && dy != 0 ) ? RESOLUTION * sqrt( 2.0 ) : RESOLUTION;
+                    if( distance[ cell ] + step < distance[ neighbor ] )
+                    {
+                        distance[ neighbor ] = distance[ cell ] + step;
+                        open.push( { distance[ neighbor ], neighbor } );
+                    }
+                }
+            }
+        }
+        return distance[ start ];
+    } // referenceLength()
+
+    // Gets the center of a cell of a grid whose corner is corner.
+    LocalPoint cellCenter( const LocalPoint& corner, int cell )
+    {
+        return { corner.x + ( cell % SIZE + 0.5 ) * RESOLUTION,
+                 corner.y + ( cell / SIZE + 0.5 ) * RESOLUTION };
+    } // cellCenter()
+} // namespace
+
+int main()
+{
+    mt19937 generator( 2019 );
+    uniform_int_distribution<int> anyCell( 0, SIZE * SIZE - 1 );
+    bernoulli_distribution isBoulder( 0.25 );
+
+    // Start and goal on opposite sides of the grid, so initialize places
+    // the grid with its corner at corner.
+    const LocalPoint start = { 0.75, 0.75 };
+    const LocalPoint goal = { 0.75 + ( SIZE - 2 ) * RESOLUTION * 0.99, 0.75 };
+    DStarLite planner( RESOLUTION, SIZE );
+    vector<LocalPoint> path;
+    path.reserve( SIZE * SIZE );
+
+    for( int field = 0; field < 20; ++field )
+    {
+        planner.initialize( start, goal );
+        const LocalPoint center = { ( start.x + planner.goal().x ) / 2, ( start.y + planner.goal().y ) / 2 };
+        const LocalPoint corner = { center.x - SIZE * RESOLUTION / 2, center.y - SIZE * RESOLUTION / 2 };
+        const int startCell = int( ( start.y - corner.y ) / RESOLUTION ) * SIZE + int( ( start.x - corner.x ) / RESOLUTION );
+        const int goalCell = int( ( planner.goal().y - corner.y ) / RESOLUTION ) * SIZE +
+                             int( ( planner.goal().x - corner.x ) / RESOLUTION );
+
+        vector<bool> blocked( SIZE * SIZE, false );
+        for( int cell = 0; cell < SIZE * SIZE; ++cell )
+        {
+            blocked[ cell ] = cell != startCell && cell != goalCell && isBoulder( generator );
+            planner.setBlocked( cellCenter( corner, cell ), blocked[ cell ] );
+        }
+        planner.plan();
+        checkNear( "path length from scratch", planner.pathLength(),
+                   referenceLength( blocked, startCell, goalCell ), 1e-3 );
+
+        // Move the start along the path and toggle cells around it,
+        // repairing the plan each time.
+        int current = startCell;
+        for( int step = 0; step < 10 && planner.pathLength() < numeric_limits<double>::infinity(); ++step )
+        {
+            planner.path( path );
+            if( path.size() < 3 )
+            {
+                break;
+            }
+            const LocalPoint next = path[ 2 ];
+            current = int( ( next.y - corner.y ) / RESOLUTION ) * SIZE + int( ( next.x - corner.x ) / RESOLUTION );
+            planner.updateStart( next );
+            blocked[ current ] = false;
+            for( int change = 0; change < 15; ++change )
+            {
+                const int cell = anyCell( generator );
+                if( cell == current || cell == goalCell )
+                {
+                    continue;
+                }
+                blocked[ cell ] = !blocked[ cell ];
+                planner.setBlocked( cellCenter( corner, cell ), blocked[ cell ] );
+            }
+            planner.plan();
+            checkNear( "repaired path length", planner.pathLength(),
+                       referenceLength( blocked, current, goalCell ), 1e-3 );
+        }
+    }
+
+    return Check::report( "D* Lite paths match Dijkstra" );
+}
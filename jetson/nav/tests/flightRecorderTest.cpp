@@ -0,0 +1,173 @@
+// Checks that the flight recorder keeps the newest records once it
+// wraps around, dumps them as a well formed lcm event log, and only
+// dumps whole records while it is being written.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "flightRecorder.hpp"
+#include "stateMachine.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+namespace
+{
+    // An event read back from an lcm event log.
+    struct Event
+    {
+        int64_t number;
+        int64_t timestamp;
+        string channel;
+        vector<uint8_t> data;
+    };
+
+    // Reads a big endian integer of size bytes from file.
+    bool readBigEndian( FILE* file, int size, uint64_t& value )
+    {
+        value = 0;
+        for( int i = 0; i < size; ++i )
+        {
+            const int byte = fgetc( file );
+            if( byte == EOF )
+            {
+                return false;
+            }
+            value = ( value << 8 ) | byte;
+        }
+        return true;
+    } // readBigEndian()
+
+    // Reads every event of the event log at path. Returns false if the
+    // log is malformed.
+    bool readLog( const char* path, vector<Event>& events )
+    {
+        FILE* file = fopen( path, "rb" );
+        if( !file )
+        {
+            return false;
+        }
+        uint64_t sync;
+        bool valid = true;
+        while( valid && readBigEndian( file, 4, sync ) )
+        {
+            uint64_t number, timestamp, channelLength, dataLength;
+            valid = sync == 0xEDA1DA01 &&
+                    readBigEndian( file, 8, number ) &&
+                    readBigEndian( file, 8, timestamp ) &&
+                    readBigEndian( file, 4, channelLength ) &&
+                    readBigEndian( file, 4, dataLength );
+            if( valid )
+            {
+                Event event;
+                event.number = number;
+                event.timestamp = timestamp;
+                event.channel.resize( channelLength );
+                event.data.resize( dataLength );
+                valid = fread( &event.channel[ 0 ], 1, channelLength, file ) == channelLength &&
+                        fread( event.data.data(), 1, dataLength, file ) == dataLength;
+                events.push_back( event );
+            }
+        }
+        fclose( file );
+        return valid;
+    } // readLog()
+} // namespace
+
+int main()
+{
+    const int eventsPerRecord = 5;
+    FlightRecorder recorder( 5, "/nav_status", "/autonomous" );
+    check( "the capacity is rounded up to a power of two", recorder.capacity() == 8 );
+
+    // Record more iterations than fit, alternating between two states.
+    const int iterations = 20;
+    for( int i = 0; i < iterations; ++i )
+    {
+        FlightRecord record = {};
+        record.time = 10 + 0.02 * i;
+        record.fromState = static_cast<uint8_t>( i % 2 ? NavState::Turn : NavState::Drive );
+        record.toState = static_cast<uint8_t>( i % 2 ? NavState::Drive : NavState::Turn );
+        record.totalWaypoints = i;
+        recorder.record( record );
+    }
+    check( "every iteration is counted", recorder.recorded() == iterations );
+
+    char path[] = "/tmp/flightRecorderTestXXXXXX";
+    const int fd = mkstemp( path );
+    check( "a temporary file can be created", fd >= 0 );
+    close( fd );
+    check( "the recorder dumps", recorder.dump( path ) );
+
+    vector<Event> events;
+    check( "the dump is a valid event log", readLog( path, events ) );
+    unlink( path );
+    check( "the dump holds the newest records",
+           events.size() == static_cast<size_t>( recorder.capacity() * eventsPerRecord ) );
+    for( size_t i = 0; i < events.size(); ++i )
+    {
+        const int record = iterations - recorder.capacity() + i / eventsPerRecord;
+        check( "events are numbered in order", events[ i ].number == static_cast<int64_t>( i ) );
+        check( "events are stamped with the record's time in microseconds",
+               llabs( events[ i ].timestamp - static_cast<int64_t>( ( 10 + 0.02 * record ) * 1e6 ) ) <= 1 );
+    }
+    if( events.size() >= static_cast<size_t>( eventsPerRecord ) )
+    {
+        check( "the inputs come first", events[ 0 ].channel == "/odometry" &&
+                                         events[ 1 ].channel == "/obstacle" &&
+                                         events[ 2 ].channel == "/target_list" );
+        check( "the outputs follow", events[ 3 ].channel == "/nav_status" &&
+                                      events[ 4 ].channel == "/autonomous" );
+
+        // The oldest record kept is iteration 12, which went to Turn.
+        NavStatus navStatus;
+        check( "the nav status decodes",
+               navStatus.decode( events[ 3 ].data.data(), 0, events[ 3 ].data.size() ) >= 0 );
+        check( "the nav status names the state transitioned to", navStatus.nav_state_name == "Turn" );
+        check( "the nav status has the waypoint counts", navStatus.total_wps == 12 );
+    }
+
+    // Dump while another thread records. Every field of record i holds
+    // i, so a torn record shows as a nav status that disagrees with its
+    // timestamp.
+    FlightRecorder concurrent( 64, "/nav_status", "/autonomous" );
+    atomic<bool> recording( true );
+    thread writer( [&]()
+    {
+        for( int i = 0; recording; ++i )
+        {
+            FlightRecord record = {};
+            record.time = i;
+            record.completedWaypoints = i;
+            record.totalWaypoints = i;
+            concurrent.record( record );
+        }
+    } );
+    bool whole = true;
+    for( int dump = 0; dump < 20; ++dump )
+    {
+        vector<Event> dumped;
+        whole = concurrent.dump( path ) && readLog( path, dumped ) && whole;
+        for( const Event& event : dumped )
+        {
+            NavStatus navStatus;
+            if( event.channel == "/nav_status" )
+            {
+                whole = navStatus.decode( event.data.data(), 0, event.data.size() ) >= 0 &&
+                        navStatus.completed_wps == navStatus.total_wps &&
+                        event.timestamp == static_cast<int64_t>( navStatus.total_wps ) * 1000000 && whole;
+            }
+        }
+    }
+    recording = false;
+    writer.join();
+    unlink( path );
+    check( "records dumped while recording are whole", whole );
+
+    return Check::report( "flight recorder checks passed" );
+}
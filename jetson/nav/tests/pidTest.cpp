@@ -0,0 +1,64 @@
+// Checks that the pid loop wraps angular error, scales with the
+// measured timestep, does not wind up while saturated, filters its
+// derivative and adds feed-forward.
+
+#include <cmath>
+#include <iostream>
+#include "pid.hpp"
+#include "check.hpp"
+
+using namespace std;
+using Check::check;
+
+int main()
+{
+    // Angular error takes the short way around.
+    PidLoop bearing( 0.01, 0, 0 );
+    bearing.setPeriod( 360 );
+    check( "turning from 350 to 10 degrees turns right", fabs( bearing.update( 350, 10, 0.02 ) - 0.2 ) < 1e-9 );
+    check( "turning from 10 to 350 degrees turns left", fabs( bearing.update( 10, 350, 0.02 ) + 0.2 ) < 1e-9 );
+
+    // The integral accumulates error * dt, however the time is split.
+    PidLoop coarse( 0, 1, 0 );
+    PidLoop fine( 0, 1, 0 );
+    coarse.update( 0, 0.1, 0.1 );
+    for( int i = 0; i < 5; ++i )
+    {
+        fine.update( 0, 0.1, 0.02 );
+    }
+    check( "the integral scales with the timestep",
+           fabs( coarse.update( 0, 0.1, 0 ) - fine.update( 0, 0.1, 0 ) ) < 1e-9 );
+
+    // A long saturated turn does not wind the integral up, so the output
+    // reverses as soon as the error does.
+    PidLoop windup( 0.1, 0.5, 0 );
+    for( int i = 0; i < 1000; ++i )
+    {
+        windup.update( 0, 90, 0.02 );
+    }
+    check( "the output saturates", windup.update( 0, 90, 0.02 ) == 1.0 );
+    check( "the output reverses with the error", windup.update( 100, 90, 0.02 ) < 0 );
+
+    // A jump in the measurement is smoothed by the derivative filter.
+    PidLoop raw( 0, 0, 0.01 );
+    PidLoop filtered( 0, 0, 0.01 );
+    filtered.setDerivativeFilter( 0.1 );
+    raw.update( 0, 0, 0.02 );
+    filtered.update( 0, 0, 0.02 );
+    const double rawKick = raw.update( 1, 0, 0.02 );
+    const double filteredKick = filtered.update( 1, 0, 0.02 );
+    check( "the derivative opposes the motion", rawKick < 0 && filteredKick < 0 );
+    check( "the filter smooths the derivative", fabs( filteredKick ) < fabs( rawKick ) / 2 );
+
+    // Changing the setpoint does not kick the derivative.
+    PidLoop setpoint( 0, 0, 1 );
+    setpoint.update( 0, 0, 0.02 );
+    check( "a setpoint step does not kick the derivative", setpoint.update( 0, 50, 0.02 ) == 0 );
+
+    // Feed-forward is added before saturating.
+    PidLoop feedForward( 0.1, 0, 0 );
+    check( "feed-forward is added", fabs( feedForward.update( 0, 1, 0.02, 0.3 ) - 0.4 ) < 1e-9 );
+    check( "feed-forward is saturated", feedForward.update( 0, 1, 0.02, 2 ) == 1.0 );
+
+    return Check::report( "pid checks passed" );
+}
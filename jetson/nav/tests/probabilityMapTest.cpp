@@ -0,0 +1,57 @@
+// Checks that the probability map starts from a gaussian around the
+// search waypoint, rules out only what the camera sees and sums what a
+// spin would find.
+
+#include <cmath>
+#include <iostream>
+#include "search/probabilityMap.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+int main()
+{
+    ProbabilityMap map;
+    check( "an empty map has nothing to find", map.remaining() == 0 );
+
+    const LocalPoint center = { 10, 20 };
+    map.reset( center, 10, 4, 0.5 );
+    check( "the prior sums to 1", fabs( map.remaining() - 1 ) < 1e-9 );
+    check( "a spin covering the map finds everything", fabs( map.spinGain( center, 15 ) - 1 ) < 1e-9 );
+    check( "the prior peaks at the center", map.weight( center ) > map.weight( { 13, 20 } ) );
+    check( "the prior is symmetric", fabs( map.weight( { 13.25, 20.25 } ) - map.weight( { 6.75, 19.75 } ) ) < 1e-12 );
+    check( "nothing is beyond the radius", map.weight( { 18, 28 } ) == 0 );
+    check( "nothing is off the grid", map.weight( { 100, 20 } ) == 0 );
+
+    // Looking north from the center with a perfect detector rules out
+    // the cells in view and nothing else.
+    const double ahead = map.weight( { 10, 22 } );
+    const double behind = map.weight( { 10, 18 } );
+    const double beside = map.weight( { 12, 20.25 } );
+    const double far = map.weight( { 10, 26 } );
+    const double before = map.remaining();
+    const double inView = map.spinGain( center, 3 ) - map.spinGain( center, 0 );
+    map.observe( center, 0, 3, 90, 0 );
+    check( "cells in view are ruled out", map.weight( { 10, 22 } ) == 0 );
+    check( "cells behind are kept", map.weight( { 10, 18 } ) == behind );
+    check( "cells outside the field of view are kept", map.weight( { 12, 20.25 } ) == beside );
+    check( "cells out of range are kept", map.weight( { 10, 26 } ) == far );
+    check( "what is ruled out leaves the sum", map.remaining() < before - ahead &&
+                                                map.remaining() > before - inView );
+    check( "what is ruled out matches the cells", fabs( map.remaining() - map.spinGain( center, 15 ) ) < 1e-9 );
+
+    // An imperfect detector only scales the cells in view.
+    map.observe( center, 180, 3, 90, 0.25 );
+    check( "a miss scales the cells in view", fabs( map.weight( { 10, 18 } ) - 0.25 * behind ) < 1e-12 );
+    check( "the sum follows the cells", fabs( map.remaining() - map.spinGain( center, 15 ) ) < 1e-9 );
+
+    // A full spin sees every bearing.
+    map.observe( center, 0, 3, 360, 0 );
+    check( "a full spin rules out everything in range", map.spinGain( center, 3 ) == 0 );
+    check( "a spin elsewhere still finds something", map.spinGain( { 15, 20 }, 3 ) > 0 );
+
+    map.reset( { 0, 0 }, 5, 2, 0.25 );
+    check( "a reset starts over", fabs( map.remaining() - 1 ) < 1e-9 && map.weight( { 10, 20 } ) == 0 );
+
+    return Check::report( "probability map checks passed" );
+}
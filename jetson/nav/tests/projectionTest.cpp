@@ -0,0 +1,102 @@
+// Checks the local tangent-plane projection against the degree-and-
+// minute functions in utilities.cpp that it replaces on the control
+// path.
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "localProjection.hpp"
+#include "utilities.hpp"
+#include "check.hpp"
+
+using Check::checkNear;
+
+namespace
+{
+    // Difference between two bearings in degrees, in [0, 180].
+    double bearingDifference( double bearing1, double bearing2 )
+    {
+        double difference = mod( bearing1 - bearing2, 360 );
+        return difference > 180 ? 360 - difference : difference;
+    } // bearingDifference()
+
+    // Creates odometry from decimal degrees.
+    Odometry makeOdometry( double latitude, double longitude )
+    {
+        Odometry odometry = Odometry();
+        odometry.latitude_deg = static_cast<int32_t>( latitude );
+        odometry.latitude_min = ( latitude - odometry.latitude_deg ) * 60;
+        odometry.longitude_deg = static_cast<int32_t>( longitude );
+        odometry.longitude_min = ( longitude - odometry.longitude_deg ) * 60;
+        return odometry;
+    } // makeOdometry()
+} // namespace
+
+int main()
+{
+    // Hanksville, Ann Arbor and somewhere south of the equator.
+    const vector<Odometry> origins = { makeOdometry( 38.406, -110.792 ),
+                                       makeOdometry( 42.277, -83.738 ),
+                                       makeOdometry( -33.45, 151.2 ) };
+    mt19937 generator( 2019 );
+    uniform_real_distribution<double> offset( -2000, 2000 );
+    uniform_real_distribution<double> angle( 0, 360 );
+    uniform_real_distribution<double> length( 1, 50 );
+
+    for( const Odometry& origin : origins )
+    {
+        const LocalProjection projection( origin );
+        const double metersPerLatMinute = projection.metersPerLatMinute();
+        const double metersPerLonMinute = projection.metersPerLonMinute();
+
+        vector<Odometry> points;
+        for( int i = 0; i < 1000; ++i )
+        {
+            Odometry point = addMinToDegrees( origin, offset( generator ) / metersPerLatMinute,
+                                              offset( generator ) / metersPerLonMinute );
+            points.push_back( point );
+        }
+
+        vector<LocalPoint> localPoints( points.size() );
+        projection.toLocal( points.begin(), points.end(), localPoints.begin() );
+
+        for( size_t i = 0; i + 1 < points.size(); ++i )
+        {
+            const Odometry& start = points[ i ];
+            const Odometry& dest = points[ i + 1 ];
+            const LocalPoint localStart = projection.toLocal( start );
+            const LocalPoint localDest = projection.toLocal( dest );
+            checkNear( "batch x", localPoints[ i ].x, localStart.x, 1e-9 );
+            checkNear( "batch y", localPoints[ i ].y, localStart.y, 1e-9 );
+
+            // The old functions use the mean earth radius and the new
+            // ones the equatorial circumference, which differ by 0.11%.
+            const double distance = estimateNoneuclid( start, dest );
+            checkNear( "distance", planarDistance( localStart, localDest ), distance, 0.003 * distance );
+            checkNear( "bearing", bearingDifference( planarBearing( localStart, localDest ),
+                                                     calcBearing( start, dest ) ), 0, 0.5 );
+
+            const Odometry roundTrip = projection.toOdometry( localStart );
+            checkNear( "round trip latitude",
+                       roundTrip.latitude_deg * 60 + roundTrip.latitude_min,
+                       start.latitude_deg * 60 + start.latitude_min, 1e-9 );
+            checkNear( "round trip longitude",
+                       roundTrip.longitude_deg * 60 + roundTrip.longitude_min,
+                       start.longitude_deg * 60 + start.longitude_min, 1e-9 );
+
+            // offsetPoint must land where the old minute arithmetic in
+            // createOdom did.
+            const double bearing = angle( generator );
+            const double pointDistance = length( generator );
+            const Odometry oldOdom = addMinToDegrees(
+                start,
+                pointDistance * cos( degreeToRadian( bearing ) ) * LAT_METER_IN_MINUTES,
+                pointDistance * sin( degreeToRadian( bearing ) ) / metersPerLonMinute );
+            const LocalPoint newPoint = offsetPoint( localStart, bearing, pointDistance );
+            checkNear( "offset point", planarDistance( newPoint, projection.toLocal( oldOdom ) ), 0, 1e-6 );
+        }
+    }
+
+    return Check::report( "Local projection matches the odometry functions" );
+}
@@ -0,0 +1,129 @@
+// Replays recorded lcm event logs through the nav state machine and
+// checks that nav publishes exactly the joystick commands and nav
+// statuses in each log's golden file. With --update the golden files
+// are written instead. Reports how fast the logs replayed and how long
+// the ticks took.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "simulator/replay.hpp"
+#include "simulator/sweep.hpp"
+#include "check.hpp"
+
+using Check::fail;
+
+namespace
+{
+    // Differences reported per log.
+    const int MAX_DIFFERENCES = 5;
+
+    // Compares nav's outputs with the golden lines and reports the first
+    // differences. Returns true if they match.
+    bool matches( const string& logPath, const vector<string>& outputs, const vector<string>& golden )
+    {
+        int differences = 0;
+        for( size_t i = 0; i < max( outputs.size(), golden.size() ); ++i )
+        {
+            const string& expected = i < golden.size() ? golden[ i ] : "(end)";
+            const string& actual = i < outputs.size() ? outputs[ i ] : "(end)";
+            if( expected != actual && ++differences <= MAX_DIFFERENCES )
+            {
+                cerr << logPath << ": output " << i + 1 << " is \"" << actual << "\", expected \""
+                     << expected << "\"\n";
+            }
+        }
+        if( differences > MAX_DIFFERENCES )
+        {
+            cerr << logPath << ": " << differences << " outputs differ\n";
+        }
+        return differences == 0;
+    } // matches()
+} // namespace
+
+int main( int argc, char** argv )
+{
+    const bool update = argc > 1 && string( argv[ 1 ] ) == "--update";
+    const int first = update ? 2 : 1;
+    if( argc - first < 2 || ( argc - first ) % 2 != 0 )
+    {
+        cerr << "Usage: " << argv[ 0 ] << " [--update] <log.lcmlog> <golden.txt> [<log.lcmlog> <golden.txt> ...]\n";
+        return 1;
+    }
+
+    NavConfig config;
+    long events = 0;
+    long ticks = 0;
+    double duration = 0;
+    vector<double> tickSeconds;
+    double elapsed = 0;
+    for( int i = first; i < argc; i += 2 )
+    {
+        const string logPath = argv[ i ];
+        const string goldenPath = argv[ i + 1 ];
+
+        // Nav's own logging would bury the report.
+        streambuf* errorBuffer = cerr.rdbuf( nullptr );
+        auto start = chrono::steady_clock::now();
+        Replay replay( config );
+        string error;
+        const bool replayed = replay.run( logPath, error );
+        elapsed += chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+        cerr.rdbuf( errorBuffer );
+        cerr.clear();
+        if( !replayed )
+        {
+            fail( "Error: " + error );
+            continue;
+        }
+
+        const ReplayResult& result = replay.result();
+        events += result.events;
+        ticks += result.ticks;
+        duration += result.duration;
+        tickSeconds.insert( tickSeconds.end(), result.tickSeconds.begin(), result.tickSeconds.end() );
+        if( update )
+        {
+            ofstream golden( goldenPath );
+            for( const string& output : result.outputs )
+            {
+                golden << output << "\n";
+            }
+            if( !golden )
+            {
+                fail( "Error: cannot write " + goldenPath );
+            }
+            continue;
+        }
+
+        ifstream golden( goldenPath );
+        if( !golden )
+        {
+            fail( "Error: cannot read " + goldenPath );
+            continue;
+        }
+        vector<string> goldenLines;
+        for( string line; getline( golden, line ); )
+        {
+            goldenLines.push_back( line );
+        }
+        if( !matches( logPath, result.outputs, goldenLines ) )
+        {
+            fail( logPath + " does not match " + goldenPath );
+        }
+    }
+
+    if( !tickSeconds.empty() )
+    {
+        sort( tickSeconds.begin(), tickSeconds.end() );
+        cout << "Replayed " << events << " events and " << ticks << " ticks, " << duration << " s of logs, in "
+             << elapsed << " s (" << duration / elapsed << "x real time)\n"
+             << "Tick p50 " << percentile( tickSeconds, 0.5 ) * 1e6 << " us, p90 "
+             << percentile( tickSeconds, 0.9 ) * 1e6 << " us, p99 " << percentile( tickSeconds, 0.99 ) * 1e6
+             << " us, max " << tickSeconds.back() * 1e6 << " us\n";
+    }
+    return Check::report( update ? "Golden outputs written" : "Replayed outputs match the golden outputs" );
+}
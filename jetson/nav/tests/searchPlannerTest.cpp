@@ -0,0 +1,89 @@
+// Checks that the search planner keeps building searches ahead over
+// many search waypoints in a row when the follow-up searches prepared
+// at each are never taken, and that searches are only handed out for
+// the plan they were built for.
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "search/searchPlanner.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+namespace
+{
+    // More search waypoints than the planner holds built searches for.
+    const int WAYPOINTS = 40;
+
+    // Seconds to wait for the planning thread to build a search.
+    const double BUILD_TIMEOUT = 2.0;
+
+    // Takes the search built for plan, waiting for the planning thread
+    // to build it. Returns nullptr if it is not built in time.
+    SearchStateMachine* waitFor( SearchPlanner& planner, const SearchPlan& plan, bool& planned )
+    {
+        const auto deadline = chrono::steady_clock::now() + chrono::duration<double>( BUILD_TIMEOUT );
+        while( chrono::steady_clock::now() < deadline )
+        {
+            SearchStateMachine* search = planner.take( plan, planned );
+            if( search )
+            {
+                return search;
+            }
+            this_thread::sleep_for( chrono::milliseconds( 1 ) );
+        }
+        return nullptr;
+    } // waitFor()
+} // namespace
+
+int main()
+{
+    NavConfig config;
+    const double visionDistance = config.computerVision.visionDistance;
+    SearchPlanner planner( nullptr );
+
+    // At each waypoint the first search is prepared ahead and taken,
+    // and the follow-up prepared when it starts is built but never
+    // taken, as when the target is found during the first search.
+    int searchFails = 0;
+    int built = 0;
+    for( int waypoint = 0; waypoint < WAYPOINTS; ++waypoint )
+    {
+        const LocalPoint center = { 20.0 * waypoint, 0 };
+        const SearchPlan first = { SearchType::SPIRALOUT, center, visionDistance, searchFails };
+        const SearchPlan followUp = { SearchType::SPIRALIN, center, visionDistance, searchFails + 1 };
+        planner.prepare( first, config );
+
+        bool planned = false;
+        SearchStateMachine* search = waitFor( planner, first, planned );
+        if( search && planned )
+        {
+            ++built;
+        }
+        planner.retire( search );
+        planner.prepare( followUp, config );
+        this_thread::sleep_for( chrono::milliseconds( 5 ) );
+        searchFails += 2;
+    }
+    check( "a search is built ahead for every search waypoint", built == WAYPOINTS );
+
+    // A search is only handed out for the plan it was built for.
+    const SearchPlan plan = { SearchType::SPIRALOUT, { 0, 0 }, visionDistance, searchFails };
+    SearchPlan other = plan;
+    other.center.x = 5;
+    planner.prepare( plan, config );
+    bool planned = false;
+    SearchStateMachine* search = waitFor( planner, plan, planned );
+    check( "the prepared search is built", search && planned );
+    planner.retire( search );
+    planner.prepare( plan, config );
+    this_thread::sleep_for( chrono::milliseconds( 50 ) );
+    check( "a search is not handed out for another plan", !planner.take( other, planned ) );
+
+    // Searches built before a cancel are not handed out.
+    planner.cancel();
+    check( "a cancelled search is not handed out", !planner.take( plan, planned ) );
+
+    return Check::report( "search planner checks passed" );
+}
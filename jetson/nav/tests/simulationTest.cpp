@@ -0,0 +1,50 @@
+// Runs the nav state machine through the scenario given on the command
+// line in the headless simulator. The course must be completed without
+// touching an obstacle, and a second state machine in the same process
+// must drive it exactly the same way.
+
+#include <iostream>
+#include "simulator/scenario.hpp"
+#include "simulator/simulation.hpp"
+
+int main( int argc, char** argv )
+{
+    if( argc != 2 )
+    {
+        cerr << "Usage: " << argv[ 0 ] << " <scenario.json>\n";
+        return 1;
+    }
+    Scenario scenario;
+    string error;
+    if( !loadScenario( argv[ 1 ], scenario, error ) )
+    {
+        cerr << "Invalid scenario: " << error << "\n";
+        return 1;
+    }
+
+    NavConfig config;
+    Simulation simulation( config, scenario );
+    const SimulationResult& result = simulation.run();
+    if( !result.completed )
+    {
+        cerr << "Did not complete the course: " << result.completedWaypoints << "/"
+             << scenario.waypoints.size() << " waypoints, stuck in " << simulation.navState() << "\n";
+        return 1;
+    }
+    if( result.collisions != 0 )
+    {
+        cerr << "Ran into obstacles " << result.collisions << " times\n";
+        return 1;
+    }
+
+    Simulation rerun( config, scenario );
+    const SimulationResult& rerunResult = rerun.run();
+    if( rerunResult.ticks != result.ticks || rerunResult.distance != result.distance )
+    {
+        cerr << "Rerunning the course took " << rerunResult.ticks << " ticks instead of "
+             << result.ticks << "\n";
+        return 1;
+    }
+    cout << "Completed the course in " << result.time << " simulated seconds\n";
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Checks that the target tracker converges on a tag seen through noisy
+// detections, gates outliers, predicts the tag from where the rover
+// has moved to, stops following tags that are not seen for too long
+// and keeps them as landmarks.
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "targetTracker.hpp"
+#include "check.hpp"
+
+using Check::check;
+
+namespace
+{
+    // Creates the detection of the tag with the given id at point, seen
+    // from position with the given heading.
+    Target makeTarget( const LocalPoint& position, double heading, const LocalPoint& point, int id )
+    {
+        Target target;
+        target.distance = planarDistance( position, point );
+        target.bearing = planarBearing( position, point ) - heading;
+        target.id = id;
+        return target;
+    } // makeTarget()
+} // namespace
+
+int main()
+{
+    NavConfig config;
+    const NavConfig::TargetTracker& settings = config.targetTracker;
+    TargetTracker tracker;
+    mt19937 random( 7 );
+    normal_distribution<double> rangeNoise( 0, settings.rangeNoise );
+    normal_distribution<double> bearingNoise( 0, settings.bearingNoise );
+    const LocalPoint origin = { 0, 0 };
+    const LocalPoint tag = { 3, 20 };
+
+    Target missing = makeTarget( origin, 0, tag, 1 );
+    missing.distance = -1;
+    check( "a missing detection is ignored", !tracker.update( origin, 0, missing, 0, settings ) );
+    check( "nothing is tracked before a detection", !tracker.track( 1, 0, settings ) );
+
+    // Noisy detections converge on the tag and shrink the covariance.
+    double now = 0;
+    check( "the first detection starts a track", tracker.update( origin, 0, makeTarget( origin, 0, tag, 1 ), now, settings ) );
+    const double firstVariance = tracker.track( 1, now, settings )->covarianceXX +
+                                 tracker.track( 1, now, settings )->covarianceYY;
+    for( int i = 0; i < 50; ++i )
+    {
+        now += 0.1;
+        Target target = makeTarget( origin, 0, tag, 1 );
+        target.distance += rangeNoise( random );
+        target.bearing += bearingNoise( random );
+        tracker.update( origin, 0, target, now, settings );
+    }
+    const TargetTracker::Track* track = tracker.track( 1, now, settings );
+    check( "the tag is tracked", track != nullptr );
+    check( "the track converges on the tag", track && planarDistance( track->position, tag ) < 0.3 );
+    check( "the covariance shrinks",
+           track && track->covarianceXX + track->covarianceYY < firstVariance / 4 );
+
+    // A detection far outside the gate is dropped and does not move the
+    // track, but enough of them in a row restart it.
+    const LocalPoint estimate = track->position;
+    const LocalPoint moved = { 13, 20 };
+    check( "an outlier is gated", !tracker.update( origin, 0, makeTarget( origin, 0, moved, 1 ), now, settings ) );
+    check( "an outlier does not move the track", planarDistance( tracker.track( 1, now, settings )->position, estimate ) < 1e-9 );
+    for( int i = 1; i < settings.maxRejections; ++i )
+    {
+        tracker.update( origin, 0, makeTarget( origin, 0, moved, 1 ), now, settings );
+    }
+    check( "repeated outliers restart the track",
+           planarDistance( tracker.track( 1, now, settings )->position, moved ) < 1e-9 );
+    tracker.update( origin, 0, makeTarget( origin, 0, tag, 1 ), now, settings );
+    tracker.update( origin, 0, makeTarget( origin, 0, tag, 1 ), now, settings );
+    tracker.update( origin, 0, makeTarget( origin, 0, tag, 1 ), now, settings );
+
+    // The tag is predicted relative to wherever the rover has moved.
+    const LocalPoint position = { 10, 10 };
+    Target predicted = tracker.predict( position, 90, 1, now + 1, settings );
+    check( "the predicted distance follows the rover", fabs( predicted.distance - hypot( 7, 10 ) ) < 0.3 );
+    check( "the predicted bearing is relative to the heading", fabs( predicted.bearing + 125 ) < 2 );
+    check( "the predicted id is the tag's", predicted.id == 1 );
+
+    // A tag not seen for longer than the coast time is forgotten.
+    predicted = tracker.predict( position, 90, 1, now + settings.coastTime + 0.1, settings );
+    check( "a stale track is not predicted", predicted.distance < 0 );
+    check( "a stale track is still a landmark", tracker.landmark( 1 ) != nullptr );
+    const double staleVariance = tracker.landmark( 1 )->covarianceXX;
+    check( "a stale track is refined by a new sighting",
+           tracker.update( origin, 0, makeTarget( origin, 0, tag, 1 ), now + 10, settings ) &&
+           tracker.landmark( 1 )->covarianceXX < staleVariance + 10 * settings.processNoise );
+    now += 10;
+    check( "an untracked id is not predicted", tracker.predict( position, 90, 2, now, settings ).distance < 0 );
+
+    // With more tags than tracks the one seen longest ago is replaced.
+    for( int id = 2; id < 2 + TargetTracker::MAX_TRACKS; ++id )
+    {
+        now += 0.1;
+        tracker.update( origin, 0, makeTarget( origin, 0, tag, id ), now, settings );
+    }
+    check( "the stalest track is replaced", !tracker.track( 1, now, settings ) );
+    check( "the newest tracks are kept", tracker.track( 1 + TargetTracker::MAX_TRACKS, now, settings ) &&
+                                         tracker.track( 2, now, settings ) );
+
+    tracker.clear();
+    check( "clear forgets everything", !tracker.track( 2, now, settings ) );
+
+    return Check::report( "target tracker checks passed" );
+}
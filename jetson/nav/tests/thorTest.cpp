@@ -0,0 +1,249 @@
+// Checks that the Thor primitives hand values between threads whole,
+// never torn by a concurrent write, in order and exactly once.
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "thor.hpp"
+#include "check.hpp"
+
+using namespace std;
+using Check::check;
+
+namespace
+{
+    // A message whose fields all hold the number it was made with, so
+    // that a torn copy shows as fields that disagree.
+    struct Message
+    {
+        long number;
+        double values[ 7 ];
+    };
+
+    // Makes the message numbered number.
+    Message makeMessage( long number )
+    {
+        Message message;
+        message.number = number;
+        for( double& value : message.values )
+        {
+            value = number;
+        }
+        return message;
+    } // makeMessage()
+
+    // Returns true if message was copied whole.
+    bool isWhole( const Message& message )
+    {
+        for( double value : message.values )
+        {
+            if( value != message.number )
+            {
+                return false;
+            }
+        }
+        return true;
+    } // isWhole()
+
+    // Returns true if values was copied whole: the vector holds its size
+    // as every element.
+    bool isWhole( const vector<long>& values )
+    {
+        for( long value : values )
+        {
+            if( value != static_cast<long>( values.size() ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    } // isWhole()
+} // namespace
+
+int main()
+{
+    const long count = 200000;
+
+    // A seqlock starts empty and hands each set over once.
+    Thor::Seqlock<Message> seqlock;
+    Message message;
+    check( "an empty seqlock has nothing to fetch", !seqlock.fetch( message ) );
+    seqlock.set( makeMessage( 1 ) );
+    seqlock.set( makeMessage( 2 ) );
+    check( "the latest set is fetched", seqlock.fetch( message ) && message.number == 2 );
+    check( "a set is fetched once", !seqlock.fetch( message ) );
+
+    // Fetch while another thread sets as fast as it can.
+    thread writer( [&]()
+    {
+        for( long number = 3; number <= count; ++number )
+        {
+            seqlock.set( makeMessage( number ) );
+        }
+    } );
+    long last = 2;
+    bool whole = true;
+    bool increasing = true;
+    while( last < count )
+    {
+        if( seqlock.fetch( message ) )
+        {
+            whole = whole && isWhole( message );
+            increasing = increasing && message.number > last;
+            last = message.number;
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+    writer.join();
+    check( "concurrent seqlock fetches are never torn", whole );
+    check( "concurrent seqlock fetches only move forward", increasing );
+
+    // The same for a triple buffer of a value that allocates.
+    Thor::TripleBuffer<vector<long>> tripleBuffer;
+    check( "an empty triple buffer has nothing to fetch", !tripleBuffer.fetch() );
+    thread vectorWriter( [&]()
+    {
+        vector<long> values;
+        for( long size = 1; size <= count / 10; ++size )
+        {
+            values.assign( size, size );
+            tripleBuffer.set( values );
+        }
+    } );
+    last = 0;
+    whole = true;
+    increasing = true;
+    while( last < count / 10 )
+    {
+        const vector<long>* values = tripleBuffer.fetch();
+        if( values )
+        {
+            whole = whole && isWhole( *values );
+            increasing = increasing && static_cast<long>( values->size() ) > last;
+            last = values->size();
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+    vectorWriter.join();
+    check( "concurrent triple buffer fetches are never torn", whole );
+    check( "concurrent triple buffer fetches only move forward", increasing );
+    check( "a triple buffer set is fetched once", !tripleBuffer.fetch() );
+
+    // The spsc queue delivers every push in order and refuses to
+    // overfill.
+    Thor::SpscQueue<long> spscQueue( 1000 );
+    check( "the spsc capacity is rounded up to a power of two", spscQueue.capacity() == 1024 );
+    long value;
+    check( "an empty spsc queue has nothing to pop", !spscQueue.try_pop( value ) );
+    for( long i = 0; i < 1024; ++i )
+    {
+        spscQueue.try_push( i );
+    }
+    check( "a full spsc queue refuses a push", !spscQueue.try_push( 1024 ) );
+    bool ordered = true;
+    for( long i = 0; i < 1024; ++i )
+    {
+        ordered = ordered && spscQueue.try_pop( value ) && value == i;
+    }
+    check( "the spsc queue pops in order", ordered );
+    thread producer( [&]()
+    {
+        for( long i = 0; i < count; )
+        {
+            if( spscQueue.try_push( i ) )
+            {
+                ++i;
+            }
+            else
+            {
+                this_thread::yield();
+            }
+        }
+    } );
+    ordered = true;
+    for( long i = 0; i < count; )
+    {
+        if( spscQueue.try_pop( value ) )
+        {
+            ordered = ordered && value == i;
+            ++i;
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+    producer.join();
+    check( "the spsc queue delivers every concurrent push in order", ordered );
+
+    // The mpsc queue delivers every push of every producer, each
+    // producer's in order.
+    const int producers = 4;
+    Thor::MpscQueue<long> mpscQueue( 256 );
+    check( "an empty mpsc queue has nothing to pop", !mpscQueue.try_pop( value ) );
+    vector<thread> producerThreads;
+    for( int producer = 0; producer < producers; ++producer )
+    {
+        producerThreads.emplace_back( [&, producer]()
+        {
+            for( long i = 0; i < count / producers; )
+            {
+                if( mpscQueue.try_push( i * producers + producer ) )
+                {
+                    ++i;
+                }
+                else
+                {
+                    this_thread::yield();
+                }
+            }
+        } );
+    }
+    vector<long> next( producers, 0 );
+    ordered = true;
+    for( long popped = 0; popped < count; )
+    {
+        if( mpscQueue.try_pop( value ) )
+        {
+            const int producer = value % producers;
+            ordered = ordered && value / producers == next[ producer ];
+            ++next[ producer ];
+            ++popped;
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+    for( thread& producerThread : producerThreads )
+    {
+        producerThread.join();
+    }
+    check( "the mpsc queue delivers every concurrent push in order", ordered );
+    check( "the mpsc queue is empty once everything is popped", !mpscQueue.try_pop( value ) );
+
+    // The lock-free volatile keeps the semantics of the mutex version.
+    Thor::LockFreeVolatile<long> cell( 1 );
+    check( "the lock-free volatile clones its value", cell.clone() == 1 );
+    cell.transaction( []( long& current ) { current += 1; return true; } );
+    check( "a transaction updates the value", cell.clone() == 2 );
+    check( "a conditional set checks the value",
+           !cell.set_conditionally( 5, []( long current ) { return current > 2; } ) && cell.clone() == 2 );
+    thread setter( [&]()
+    {
+        this_thread::sleep_for( chrono::milliseconds( 10 ) );
+        cell.set( 3 );
+    } );
+    check( "clone_when_changed waits for a change", cell.clone_when_changed() == 3 );
+    setter.join();
+    cell.wait_for( []( long current ) { return current == 3; } );
+
+    return Check::report( "thor checks passed" );
+}
@@ -1,3 +1,8 @@
 #pragma once
 
 #include "thor_volatile.hpp"
+#include "thor_lock_free_volatile.hpp"
+#include "thor_seqlock.hpp"
+#include "thor_triple_buffer.hpp"
+#include "thor_spsc_queue.hpp"
+#include "thor_mpsc_queue.hpp"
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include "thor_seqlock.hpp"
+
+namespace Thor {
+    // A Volatile whose reads do not lock. Writers still serialize on a
+    // mutex, which also lets readers sleep in clone_when_changed and
+    // wait_for, but clone and clone_conditional read through a Seqlock
+    // and never wait for a writer. Suits values that are read far more
+    // often than written, and limits T to trivially copyable types.
+    template <typename T>
+    class LockFreeVolatile {
+        public:
+            LockFreeVolatile() : LockFreeVolatile(T()) {}
+            LockFreeVolatile(const T & val) : val_(val), cloned_(val_.version()) {}
+
+            void set(const T & val) {
+                std::unique_lock<std::mutex> lock_(this->mut_);
+                this->val_.set(val);
+                this->cv_.notify_all();
+            }
+            template <typename Function>
+            bool set_conditionally(const T & val, Function func) {
+                std::unique_lock<std::mutex> lock_(this->mut_);
+                if (func(this->val_.clone())) {
+                    this->val_.set(val);
+                    this->cv_.notify_all();
+                    return true;
+                }
+                return false;
+            }
+
+            template <typename Function>
+            void wait_for(Function func) {
+                std::unique_lock<std::mutex> lock_(this->mut_);
+                this->cv_.wait(lock_, [&]() {
+                    return func(this->val_.clone());
+                });
+            }
+
+            template <typename Function>
+            void transaction(Function func) {
+                std::unique_lock<std::mutex> lock_(this->mut_);
+                T val = this->val_.clone();
+                if (func(val)) {
+                    this->val_.set(val);
+                    this->cv_.notify_all();
+                }
+            }
+
+            T clone_when_changed() const {
+                T val;
+                uint64_t version = this->val_.clone(val);
+                if (version == this->cloned_.load(std::memory_order_relaxed)) {
+                    std::unique_lock<std::mutex> lock_(this->mut_);
+                    this->cv_.wait(lock_, [&]() {
+                        return this->val_.version() != this->cloned_.load(std::memory_order_relaxed);
+                    });
+                    version = this->val_.clone(val);
+                }
+                this->cloned_.store(version, std::memory_order_relaxed);
+                return val;
+            }
+
+            T clone() const {
+                T val;
+                this->cloned_.store(this->val_.clone(val), std::memory_order_relaxed);
+                return val;
+            }
+
+            template <typename Function>
+            bool clone_conditional(Function pred, T *t) const {
+                T val;
+                const uint64_t version = this->val_.clone(val);
+                if (pred(val)) {
+                    *t = val;
+                    this->cloned_.store(version, std::memory_order_relaxed);
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            Seqlock<T> val_;
+            // Version of the value last cloned, which tells
+            // clone_when_changed whether it has changed since.
+            mutable std::atomic<uint64_t> cloned_;
+            mutable std::mutex mut_;
+            mutable std::condition_variable cv_;
+    };
+}
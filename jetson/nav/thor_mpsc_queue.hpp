@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Thor {
+    // Bounded queue from any number of producer threads to one consumer
+    // thread. Producers claim a cell with one compare-and-swap; each
+    // cell carries a sequence number that tells the consumer when the
+    // value in it is complete and the producers when it is free again.
+    template <typename T>
+    class MpscQueue {
+        public:
+            // The capacity is rounded up to a power of two.
+            explicit MpscQueue(size_t capacity) : mask_(0), tail_(0), head_(0) {
+                size_t size = 1;
+                while (size < capacity) {
+                    size *= 2;
+                }
+                this->cells_.reset(new Cell[size]);
+                this->mask_ = size - 1;
+                for (size_t i = 0; i < size; ++i) {
+                    this->cells_[i].seq.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            // Returns false if the queue is full.
+            bool try_push(const T & val) {
+                size_t pos = this->tail_.load(std::memory_order_relaxed);
+                while (true) {
+                    Cell & cell = this->cells_[pos & this->mask_];
+                    const size_t seq = cell.seq.load(std::memory_order_acquire);
+                    const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                    if (diff == 0) {
+                        if (this->tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            cell.val = val;
+                            cell.seq.store(pos + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if (diff < 0) {
+                        return false;
+                    }
+                    else {
+                        pos = this->tail_.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // Returns false if the queue is empty, or the oldest push is
+            // still being written. Must only be called from the consumer
+            // thread.
+            bool try_pop(T & val) {
+                Cell & cell = this->cells_[this->head_ & this->mask_];
+                if (cell.seq.load(std::memory_order_acquire) != this->head_ + 1) {
+                    return false;
+                }
+                val = std::move(cell.val);
+                cell.seq.store(this->head_ + this->mask_ + 1, std::memory_order_release);
+                ++this->head_;
+                return true;
+            }
+
+            size_t capacity() const {
+                return this->mask_ + 1;
+            }
+
+        private:
+            struct Cell {
+                std::atomic<size_t> seq;
+                T val;
+            };
+
+            std::unique_ptr<Cell[]> cells_;
+            size_t mask_;
+
+            alignas(64) std::atomic<size_t> tail_;
+
+            // Only the consumer uses head_.
+            alignas(64) size_t head_;
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Thor {
+    // Holds the latest value set by one writer thread for any number of
+    // reader threads. Writing never waits; a read that overlaps a write
+    // retries. The value is kept as atomic words so that a copy caught
+    // half written is a retry rather than a data race, which limits T to
+    // trivially copyable types.
+    template <typename T>
+    class Seqlock {
+        static_assert(std::is_trivially_copyable<T>::value, "a seqlock copies its value word by word");
+
+        public:
+            Seqlock() : seq_(0), fetched_(0) {
+                for (auto & word : this->words_) {
+                    word.store(0, std::memory_order_relaxed);
+                }
+            }
+            Seqlock(const T & val) : Seqlock() {
+                this->set(val);
+                this->fetched_ = this->seq_.load(std::memory_order_relaxed);
+            }
+
+            // Must only be called from the writer thread.
+            void set(const T & val) {
+                uint64_t words[WORDS] = {};
+                std::memcpy(words, &val, sizeof(T));
+                const uint64_t seq = this->seq_.load(std::memory_order_relaxed);
+                this->seq_.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (size_t i = 0; i < WORDS; ++i) {
+                    this->words_[i].store(words[i], std::memory_order_relaxed);
+                }
+                this->seq_.store(seq + 2, std::memory_order_release);
+            }
+
+            // Copies the latest value into val. Returns the version of
+            // the copy, which is twice the number of sets.
+            uint64_t clone(T & val) const {
+                uint64_t words[WORDS];
+                while (true) {
+                    const uint64_t seq = this->seq_.load(std::memory_order_acquire);
+                    if (seq & 1) {
+                        continue; // a set is in progress
+                    }
+                    for (size_t i = 0; i < WORDS; ++i) {
+                        words[i] = this->words_[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (this->seq_.load(std::memory_order_relaxed) == seq) {
+                        std::memcpy(&val, words, sizeof(T));
+                        return seq;
+                    }
+                }
+            }
+
+            T clone() const {
+                T val;
+                this->clone(val);
+                return val;
+            }
+
+            // Copies the latest value into val if it was set since the
+            // last fetch. Only one thread may fetch.
+            bool fetch(T & val) {
+                if (this->seq_.load(std::memory_order_acquire) == this->fetched_) {
+                    return false;
+                }
+                this->fetched_ = this->clone(val);
+                return true;
+            }
+
+            uint64_t version() const {
+                return this->seq_.load(std::memory_order_acquire);
+            }
+
+        private:
+            static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+            // Twice the number of sets, plus one while a set is in
+            // progress.
+            alignas(64) std::atomic<uint64_t> seq_;
+            std::atomic<uint64_t> words_[WORDS];
+
+            // Version of the last fetch. Only the fetching thread uses it.
+            alignas(64) uint64_t fetched_;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Thor {
+    // Bounded queue from one producer thread to one consumer thread.
+    // Pushing and popping are a copy and one release store; each side
+    // only reads the other's index again when the queue looks full or
+    // empty.
+    template <typename T>
+    class SpscQueue {
+        public:
+            // The capacity is rounded up to a power of two.
+            explicit SpscQueue(size_t capacity)
+                : vals_(round_up(capacity)), mask_(vals_.size() - 1),
+                  tail_(0), cached_head_(0), head_(0), cached_tail_(0) {}
+
+            // Returns false if the queue is full. Must only be called
+            // from the producer thread.
+            bool try_push(const T & val) {
+                const size_t tail = this->tail_.load(std::memory_order_relaxed);
+                if (tail - this->cached_head_ == this->vals_.size()) {
+                    this->cached_head_ = this->head_.load(std::memory_order_acquire);
+                    if (tail - this->cached_head_ == this->vals_.size()) {
+                        return false;
+                    }
+                }
+                this->vals_[tail & this->mask_] = val;
+                this->tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Returns false if the queue is empty. Must only be called
+            // from the consumer thread.
+            bool try_pop(T & val) {
+                const size_t head = this->head_.load(std::memory_order_relaxed);
+                if (head == this->cached_tail_) {
+                    this->cached_tail_ = this->tail_.load(std::memory_order_acquire);
+                    if (head == this->cached_tail_) {
+                        return false;
+                    }
+                }
+                val = std::move(this->vals_[head & this->mask_]);
+                this->head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            size_t capacity() const {
+                return this->vals_.size();
+            }
+
+        private:
+            static size_t round_up(size_t capacity) {
+                size_t size = 1;
+                while (size < capacity) {
+                    size *= 2;
+                }
+                return size;
+            }
+
+            std::vector<T> vals_;
+            const size_t mask_;
+
+            // Producer side.
+            alignas(64) std::atomic<size_t> tail_;
+            size_t cached_head_;
+
+            // Consumer side.
+            alignas(64) std::atomic<size_t> head_;
+            size_t cached_tail_;
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+
+namespace Thor {
+    // Passes the latest value from one writer thread to one reader
+    // thread through three buffers: the writer fills one, the reader
+    // holds one and the third holds the latest value set. Handing a
+    // buffer over is a single atomic exchange, so neither side ever
+    // waits, and unlike a Seqlock any copyable T works.
+    template <typename T>
+    class TripleBuffer {
+        public:
+            TripleBuffer() : back_(0), middle_(1), front_(2) {}
+
+            // Must only be called from the writer thread.
+            void set(const T & val) {
+                this->vals_[this->back_] = val;
+                this->back_ = this->middle_.exchange(this->back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+            }
+
+            // Gets the latest value if it was set since the last fetch,
+            // or nullptr. The value stays valid until the next fetch.
+            // Must only be called from the reader thread.
+            const T * fetch() {
+                if (!(this->middle_.load(std::memory_order_relaxed) & FRESH)) {
+                    return nullptr;
+                }
+                this->front_ = this->middle_.exchange(this->front_, std::memory_order_acq_rel) & INDEX;
+                return &this->vals_[this->front_];
+            }
+
+        private:
+            static const unsigned FRESH = 4;
+            static const unsigned INDEX = 3;
+
+            T vals_[3];
+
+            // Only the writer uses back_ and only the reader front_.
+            alignas(64) unsigned back_;
+            alignas(64) std::atomic<unsigned> middle_;
+            alignas(64) unsigned front_;
+    };
+}
@@ -48,11 +48,9 @@ double estimateNoneuclid( const Odometry& current, const Odometry& dest )
 // Note this uses the absolute bearing not a bearing relative to the rover.
 Odometry createOdom( const Odometry & current, double bearing, const double distance, Rover * phoebe )
 {
-    bearing = degreeToRadian( bearing );
-    double latChange = distance * cos( bearing ) * LAT_METER_IN_MINUTES;
-    double lonChange = distance * sin( bearing  ) * phoebe->longMeterInMinutes();
-    Odometry newOdom = addMinToDegrees( current, latChange, lonChange );
-    return newOdom;
+    const LocalProjection& projection = phoebe->projection();
+    LocalPoint newPoint = offsetPoint( projection.toLocal( current ), bearing, distance );
+    return projection.toOdometry( newPoint, current );
 }
 
 // Caclulates the bearing between the current odometry and the
@@ -98,23 +96,6 @@ double mod( const double degree, const int modulus )
     return mod;
 }
 
-// Corrects the destination bearing to account for the ability to turn
-// through zero degrees.
-void throughZero( double& destinationBearing, const double currentBearing )
-{
-    if( fabs( currentBearing - destinationBearing ) > 180 )
-    {
-        if( currentBearing < 180 )
-        {
-            destinationBearing -= 360;
-        }
-        else
-        {
-            destinationBearing += 360;
-        }
-    }
-} // throughZero()
-
 // Clears the queue.
 void clear( deque<Waypoint>& aDeque )
 {
@@ -126,17 +107,17 @@ void clear( deque<Waypoint>& aDeque )
 // Checks to see if target is reachable before hitting obstacle
 // If the x component of the distance to obstacle is greater than
 // half the width of the rover the obstacle if reachable
-bool isTargetReachable( Rover* phoebe, const rapidjson::Document& roverConfig )
+bool isTargetReachable( Rover* phoebe, const NavConfig& roverConfig )
 {
     double distToTarget = phoebe->roverStatus().target().distance;
-    double distThresh = roverConfig["navThresholds"]["targetDistance"].GetDouble();
+    double distThresh = roverConfig.navThresholds.targetDistance;
     return isLocationReachable( phoebe, roverConfig, distToTarget, distThresh );
 } // istargetReachable()
 
 // Returns true if the rover can reach the input location without hitting the obstacle.
 // ASSUMPTION: There is an obstacle detected.
 // ASSUMPTION: The rover is driving straight.
-bool isLocationReachable( Rover* phoebe, const rapidjson::Document& roverConfig, const double locDist, const double distThresh )
+bool isLocationReachable( Rover* phoebe, const NavConfig& roverConfig, const double locDist, const double distThresh )
 {
     double distToObs = phoebe->roverStatus().obstacle().distance;
     double bearToObs = phoebe->roverStatus().obstacle().bearing;
@@ -149,7 +130,7 @@ bool isLocationReachable( Rover* phoebe, const rapidjson::Document& roverConfig,
     isReachable |= distToObs > locDist - distThresh;
 
     // if obstacle is farther away in "x direction" than rover's width, it's reachable
-    isReachable |= xComponentOfDistToObs > roverConfig["roverMeasurements"]["width"].GetDouble() / 2;
+    isReachable |= xComponentOfDistToObs > roverConfig.roverMeasurements.width / 2;
 
     return isReachable;
 } // isLocationReachable()
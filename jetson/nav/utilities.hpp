@@ -28,13 +28,11 @@ double calcBearing( const Odometry& start, const Odometry& dest );
 
 double mod( const double degree, const int modulus );
 
-void throughZero( double& destinationBearing, const double currentBearing );
-
 void clear( deque<Waypoint>& aDeque );
 
-bool isTargetReachable( Rover* phoebe, const rapidjson::Document& roverConfig );
+bool isTargetReachable( Rover* phoebe, const NavConfig& roverConfig );
 
-bool isLocationReachable( Rover* phoebe, const rapidjson::Document& roverConfig, const double locDist, const double distThresh );
+bool isLocationReachable( Rover* phoebe, const NavConfig& roverConfig, const double locDist, const double distThresh );
 
 bool isObstacleDetected( Rover* phoebe );
 
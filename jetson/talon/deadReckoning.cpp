@@ -0,0 +1,35 @@
+#include "deadReckoning.hpp"
+
+#include <cmath>
+
+DeadReckoning::DeadReckoning(int cpr, double wheelRadius, double _trackWidth) :
+    metersPerCount(2 * M_PI * wheelRadius / cpr), trackWidth(_trackWidth), started(false),
+    lastLeft(0), lastRight(0), lastUtime(0) {}
+
+// Adds the encoder positions of each side, in counts, sampled at
+// utime. Fills delta with the motion since the previous sample and
+// returns true, except for the first sample.
+bool DeadReckoning::update(int64_t utime, double left, double right, PoseDelta &delta) {
+    const double leftMeters = (left - lastLeft) * metersPerCount;
+    const double rightMeters = (right - lastRight) * metersPerCount;
+    const bool hadSample = started;
+    delta.start_utime = lastUtime;
+    delta.end_utime = utime;
+    started = true;
+    lastLeft = left;
+    lastRight = right;
+    lastUtime = utime;
+    if (!hadSample)
+        return false;
+
+    // Between samples the rover drives along an arc. Its chord points
+    // half the turn off the starting heading and is shorter than the arc
+    // by sin(turn / 2) / (turn / 2).
+    const double distance = (leftMeters + rightMeters) / 2;
+    const double turn = (leftMeters - rightMeters) / trackWidth;
+    const double chord = fabs(turn) > 1e-9 ? distance * sin(turn / 2) / (turn / 2) : distance;
+    delta.forward = chord * cos(turn / 2);
+    delta.right = chord * sin(turn / 2);
+    delta.bearing_deg = turn * 180 / M_PI;
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "rover_msgs/PoseDelta.hpp"
+
+#include <cstdint>
+
+using namespace rover_msgs;
+
+// Integrates the drive encoders of a skid-steer rover into the motion
+// between samples. Each side's distance is the average of its front
+// and back wheels, and the encoders are assumed to count up when their
+// side drives forward.
+class DeadReckoning {
+private:
+    double metersPerCount;
+    double trackWidth;
+    bool started;
+    double lastLeft;
+    double lastRight;
+    int64_t lastUtime;
+
+public:
+    // Track width is the effective one, which is wider than the
+    // distance between the wheels because skid-steer wheels slip when
+    // turning.
+    DeadReckoning(int cpr, double wheelRadius, double _trackWidth);
+
+    // Adds the encoder positions of each side, in counts, sampled at
+    // utime. Fills delta with the motion since the previous sample and
+    // returns true, except for the first sample.
+    bool update(int64_t utime, double left, double right, PoseDelta &delta);
+};
@@ -15,6 +15,10 @@ const string INTERFACE = "can0";
 const int NUM_TALONS = 11;
 const int WHEEL_ENC_CPR = 1024;
 const int ARM_ENC_CPR = 4096;
+// Meters. The track width is the effective one for skid steering and
+// should be calibrated by spinning the rover in place.
+const double WHEEL_RADIUS = 0.127;
+const double TRACK_WIDTH = 1.0;
 
 void sendEnableFrames(Rover &rover) {
     while (true) {
@@ -30,6 +34,13 @@ void publishEncoderData(Rover &rover, lcm::LCM &lcm) {
     }
 }
 
+void publishPoseDeltas(Rover &rover, lcm::LCM &lcm) {
+    while (true) {
+        this_thread::sleep_for(chrono::milliseconds(DRIVE_FEEDBACK_PERIOD_MS));
+        rover.publishPoseDelta(lcm);
+    }
+}
+
 int main() {
     lcm::LCM lcm;
     if(!lcm.good()) {
@@ -39,7 +50,7 @@ int main() {
 
     ctre::phoenix::platform::can::SetCANInterface(INTERFACE.c_str());
 
-    Rover rover(NUM_TALONS, WHEEL_ENC_CPR, ARM_ENC_CPR);
+    Rover rover(NUM_TALONS, WHEEL_ENC_CPR, ARM_ENC_CPR, WHEEL_RADIUS, TRACK_WIDTH);
 
     lcm.subscribe("/motor", &Rover::drive, &rover);
     lcm.subscribe("/config_pid", &Rover::configPID, &rover);
@@ -52,6 +63,7 @@ int main() {
 
     thread enableFrameThread(sendEnableFrames, ref(rover));
     thread encoderThread(publishEncoderData, ref(rover), ref(lcm));
+    thread poseDeltaThread(publishPoseDeltas, ref(rover), ref(lcm));
     while (lcm.handle() == 0);
 
     return 0;
@@ -4,8 +4,9 @@ using namespace std;
 using namespace rover_msgs;
 
 // Instantiates and configures rover's Talon SRX motor controllers.
-Rover::Rover(int numTalons, int _wheelCPR, int _armCPR) : armEnabled(false), 
-    saEnabled(false), autonomous(false), wheelCPR(_wheelCPR), armCPR(_armCPR) {
+Rover::Rover(int numTalons, int _wheelCPR, int _armCPR, double wheelRadius, double trackWidth) : armEnabled(false), 
+    saEnabled(false), autonomous(false), wheelCPR(_wheelCPR), armCPR(_armCPR),
+    deadReckoning(_wheelCPR, wheelRadius, trackWidth) {
     // Offsets for arm joints A-E, feed forward constants
     offsets = {820, -2672, -1936, -769, 407};
     posfeeds = {0.1, 0.18, 0.18, 0.05, 0.07};
@@ -79,6 +80,30 @@ void Rover::publishEncoderData(lcm::LCM &lcm) {
     lcm.publish("/wheel_speeds", &wheel_msg);
 }
 
+// Samples the drive encoder positions and publishes how the rover
+// moved since the last sample.
+void Rover::publishPoseDelta(lcm::LCM &lcm) {
+    PoseDelta delta_msg;
+    bool moved;
+    {
+        lock_guard<mutex> scopedLock(canLock);
+
+        int lfEncPos = talons[Talons::leftFront].GetSelectedSensorPosition();
+        int lbEncPos = talons[Talons::leftBack].GetSelectedSensorPosition();
+        int rfEncPos = talons[Talons::rightFront].GetSelectedSensorPosition();
+        int rbEncPos = talons[Talons::rightBack].GetSelectedSensorPosition();
+        int64_t utime = chrono::duration_cast<chrono::microseconds>(
+            chrono::system_clock::now().time_since_epoch()).count();
+
+        moved = deadReckoning.update(utime, (lfEncPos + static_cast<double>(lbEncPos)) / 2,
+                                     (rfEncPos + static_cast<double>(rbEncPos)) / 2, delta_msg);
+    }
+
+    // The first sample only sets the starting positions
+    if (moved)
+        lcm.publish("/pose_delta", &delta_msg);
+}
+
 // Enable talons for a given time
 void Rover::enable(int ms) {
     lock_guard<mutex> scopedLock(canLock);
@@ -252,6 +277,7 @@ void Rover::configTalons() {
     configCurrentLimits();
     configFeedbackDevices();
     configLimitSwitches();
+    configStatusFrames();
 }
 
 void Rover::configFollowerMode() {
@@ -330,4 +356,16 @@ void Rover::configFeedbackDevices() {
 
 void Rover::configLimitSwitches() {
     // TODO (not SAR-Critical)
+}
+
+void Rover::configStatusFrames() {
+    // Drive Motors: send encoder positions as often as they are sampled
+    talons[Talons::leftFront].SetStatusFramePeriod(
+        StatusFrameEnhanced::Status_2_Feedback0, DRIVE_FEEDBACK_PERIOD_MS);
+    talons[Talons::leftBack].SetStatusFramePeriod(
+        StatusFrameEnhanced::Status_2_Feedback0, DRIVE_FEEDBACK_PERIOD_MS);
+    talons[Talons::rightFront].SetStatusFramePeriod(
+        StatusFrameEnhanced::Status_2_Feedback0, DRIVE_FEEDBACK_PERIOD_MS);
+    talons[Talons::rightBack].SetStatusFramePeriod(
+        StatusFrameEnhanced::Status_2_Feedback0, DRIVE_FEEDBACK_PERIOD_MS);
 }
\ No newline at end of file
@@ -14,6 +14,9 @@
 #include "rover_msgs/Encoder.hpp"
 #include "rover_msgs/WheelSpeeds.hpp"
 #include "rover_msgs/AutonState.hpp"
+#include "rover_msgs/PoseDelta.hpp"
+
+#include "deadReckoning.hpp"
 
 #include <string>
 #include <deque>
@@ -28,6 +31,10 @@ using namespace rover_msgs;
 
 const double PI = 3.14159;
 
+// Milliseconds between drive encoder updates from the talons, and
+// between dead reckoning samples.
+const int DRIVE_FEEDBACK_PERIOD_MS = 10;
+
 enum Talons {
     leftFront = 0,
     leftBack = 1,
@@ -62,16 +69,21 @@ private:
     bool autonomous;
     int wheelCPR;
     int armCPR;
+    DeadReckoning deadReckoning;
     mutex canLock;
 
 public:
     // Instantiates and configures rover's Talon SRX motor controllers.
-    Rover(int numTalons, int _wheelCPR, int _armCPR);
+    Rover(int numTalons, int _wheelCPR, int _armCPR, double wheelRadius, double trackWidth);
 
     // Reads and updates robotic arm's current encoder counts
     // and joint angles. Also publishes to LCM.
     void publishEncoderData(lcm::LCM &lcm);
 
+    // Samples the drive encoder positions and publishes how the rover
+    // moved since the last sample.
+    void publishPoseDelta(lcm::LCM &lcm);
+
     // Enable talons for a given time
     void enable(int ms);
  
@@ -119,6 +131,7 @@ private:
     void configCurrentLimits();
     void configFeedbackDevices();
     void configLimitSwitches();
+    void configStatusFrames();
 
     /* Helper Functions */
     bool isDriveMotor(int id) {